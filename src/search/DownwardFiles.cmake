@@ -66,6 +66,7 @@ fast_downward_plugin(
         per_state_array
         per_state_bitset
         per_state_information
+        per_state_record
         per_task_information
         plan_manager
         plugin
@@ -80,7 +81,7 @@ fast_downward_plugin(
         task_id
         task_proxy
 
-    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER ORDERED_SET SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES
+    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER MAPPED_FILE_ARENA ORDERED_SET PACKED_EFFECTS SEGMENT_ARENA SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES
     CORE_PLUGIN
 )
 
@@ -185,6 +186,30 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME F_BUCKET_OPEN_LIST
+    HELP "Open list with buckets for integer f values"
+    SOURCES
+        algorithms/f_bucket_open_list
+    DEPENDENCY_ONLY
+)
+
+fast_downward_plugin(
+    NAME INDEXED_HEAP
+    HELP "D-ary heap with decrease-key and removal of arbitrary entries"
+    SOURCES
+        algorithms/indexed_heap
+    DEPENDENCY_ONLY
+)
+
+fast_downward_plugin(
+    NAME MPSC_QUEUE
+    HELP "Lock-free queue for many producer threads and one consumer thread"
+    SOURCES
+        algorithms/mpsc_queue
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME INT_HASH_SET
     HELP "Hash set storing non-negative integers"
@@ -201,6 +226,22 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME MAPPED_FILE_ARENA
+    HELP "Arena allocator backed by a memory-mapped temporary file"
+    SOURCES
+        algorithms/mapped_file_arena
+    DEPENDENCY_ONLY
+)
+
+fast_downward_plugin(
+    NAME SEGMENT_ARENA
+    HELP "Arena allocator for segments backed by huge pages"
+    SOURCES
+        algorithms/segment_arena
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME MAX_CLIQUES
     HELP "Implementation of the Max Cliques algorithm by Tomita et al."
@@ -434,6 +475,13 @@ fast_downward_plugin(
         search_engines/iterated_search
 )
 
+fast_downward_plugin(
+    NAME PARALLEL_PORTFOLIO_SEARCH
+    HELP "Parallel portfolio of search algorithms"
+    SOURCES
+        search_engines/parallel_portfolio_search
+)
+
 fast_downward_plugin(
     NAME LAZY_SEARCH
     HELP "Lazy search algorithm"
@@ -599,6 +647,15 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME PACKED_EFFECTS
+    HELP "Operator effects compiled to operations on packed states"
+    SOURCES
+        task_utils/packed_effects
+    DEPENDS INT_PACKER TASK_PROPERTIES
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME TASK_PROPERTIES
     HELP "Task properties"
@@ -779,8 +836,10 @@ fast_downward_plugin(
     SOURCES
         floating_point_open_list/alternation_open_list
         floating_point_open_list/best_first_open_list
+        floating_point_open_list/d_ary_heap_open_list
         floating_point_open_list/floating_point_open_list
         floating_point_open_list/focal_open_list
+        floating_point_open_list/heap_type
     DEPENDENCY_ONLY
 )
 
@@ -790,6 +849,7 @@ fast_downward_plugin(
     SOURCES
         heuristic_error/debiased_distance
         heuristic_error/debiased_heuristic
+        heuristic_error/error_statistics
         heuristic_error/heuristic_error
         heuristic_error/one_step_distance_error
         heuristic_error/one_step_error
@@ -814,8 +874,11 @@ fast_downward_plugin(
     HELP "Plugin containing shared code for bounded-cost and bounded-suboptimal search algorithms"
     SOURCES
         suboptimal_search/eager_suboptimal_search
+        suboptimal_search/normal_distribution
+        suboptimal_search/parallel_evaluation
+        suboptimal_search/state_exchange
         suboptimal_search/util
-    DEPENDS FLOATING_POINT_EVALUATOR HEURISTIC_ERROR
+    DEPENDS FLOATING_POINT_EVALUATOR FLOATING_POINT_OPEN_LIST HEURISTIC_ERROR MPSC_QUEUE
 )
 
 fast_downward_plugin(
@@ -832,6 +895,14 @@ fast_downward_plugin(
     DEPENDS FLOATING_POINT_EVALUATOR FLOATING_POINT_OPEN_LIST HEURISTIC_ERROR SUBOPTIMAL_SEARCH
 )
 
+fast_downward_plugin(
+    NAME HASH_DISTRIBUTED_SEARCH
+    HELP "Hash-distributed parallel bounded-cost search"
+    SOURCES
+        bounded_cost_search/hash_distributed_search
+    DEPENDS BOUNDED_COST_SEARCH MPSC_QUEUE SUBOPTIMAL_SEARCH
+)
+
 fast_downward_plugin(
     NAME BOUNDED_SUBOPTIMAL_SEARCH
     HELP "Plugin containing the code for bounded-suboptimal search algorithms"
@@ -842,14 +913,17 @@ fast_downward_plugin(
         bounded_suboptimal_search/dynamic_expected_effort_search
         bounded_suboptimal_search/dynamic_potential_search
         bounded_suboptimal_search/explicit_estimation_search
+        bounded_suboptimal_search/expected_work_reorder_scheduler
         bounded_suboptimal_search/extended_dynamic_expected_effort_search
         bounded_suboptimal_search/f_hat_min_evaluator
         bounded_suboptimal_search/greedy_explicit_estimation_search
+        bounded_suboptimal_search/open_list_compaction
         bounded_suboptimal_search/remaining_expansions_evaluator
         bounded_suboptimal_search/reordering_dynamic_expected_effort_search
+        bounded_suboptimal_search/state_heap
         bounded_suboptimal_search/suboptimality_bound_assumptions_nancy_evaluator
         bounded_suboptimal_search/weighted_astar_search
-    DEPENDS FLOATING_POINT_EVALUATOR FLOATING_POINT_OPEN_LIST HEURISTIC_ERROR EXPANSION_DELAY SUBOPTIMAL_SEARCH BOOST
+    DEPENDS F_BUCKET_OPEN_LIST FLOATING_POINT_EVALUATOR FLOATING_POINT_OPEN_LIST HEURISTIC_ERROR EXPANSION_DELAY INDEXED_HEAP SUBOPTIMAL_SEARCH BOOST
 )
 
 fast_downward_plugin(
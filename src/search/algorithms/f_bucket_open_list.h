@@ -0,0 +1,208 @@
+#ifndef ALGORITHMS_F_BUCKET_OPEN_LIST_H
+#define ALGORITHMS_F_BUCKET_OPEN_LIST_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace f_bucket_open_list {
+/*
+  Open list that groups its entries into buckets by an integer f value and
+  orders the entries of each bucket as a heap according to the given
+  comparison function (i.e., top() returns the maximal entry with respect to
+  compare of the bucket with minimal f).
+
+  Compared to a map from f values to heaps, the buckets are stored in a
+  dense array indexed by f minus an offset. Inserting into a bucket and
+  accessing the bucket with minimal f is therefore constant time, and all
+  buckets with f values in a given range can be iterated without any tree
+  traversal. Leading empty buckets are dropped once they make up more than
+  half of the array.
+
+  Since empty buckets between the minimal and maximal f value are stored as
+  well, the memory usage grows with the range of f values in the open list.
+  This is typically not a problem as the entries with large f values are
+  never expanded, but it can be for tasks with very high action costs.
+
+  Entries are never removed except from the top. Entries that become stale
+  (e.g., because the state was closed) can be removed from the top with
+  prune_top() or from all buckets at once with remove_if().
+*/
+template<typename Entry, typename Compare>
+class FBucketOpenList {
+    // Drop leading empty buckets only if there are at least this many.
+    static const std::size_t MIN_TRIM_SIZE = 64;
+
+    std::vector<std::vector<Entry>> buckets;
+    // f value of buckets[0]
+    int offset;
+    // index of the first non-empty bucket (equal to buckets.size() if empty)
+    std::size_t first_non_empty;
+    std::size_t num_entries;
+    Compare compare;
+
+    std::vector<Entry> &get_or_create_bucket(int f) {
+        if (buckets.empty()) {
+            offset = f;
+            first_non_empty = 0;
+        } else if (f < offset) {
+            const std::size_t shift = offset - f;
+            buckets.insert(buckets.begin(), shift, std::vector<Entry>());
+            first_non_empty += shift;
+            offset = f;
+        }
+        const std::size_t index = f - offset;
+        if (index >= buckets.size()) {
+            buckets.resize(index + 1);
+        }
+        first_non_empty = std::min(first_non_empty, index);
+        return buckets[index];
+    }
+
+    void skip_empty_buckets() {
+        while (first_non_empty < buckets.size() &&
+               buckets[first_non_empty].empty()) {
+            ++first_non_empty;
+        }
+        if (first_non_empty == buckets.size()) {
+            buckets.clear();
+            first_non_empty = 0;
+        } else if (first_non_empty >= MIN_TRIM_SIZE &&
+                   2 * first_non_empty > buckets.size()) {
+            buckets.erase(buckets.begin(), buckets.begin() + first_non_empty);
+            offset += first_non_empty;
+            first_non_empty = 0;
+        }
+    }
+
+    /*
+      Return the range [begin, end) of bucket indices with lower < f <= upper
+      (the same buckets as [map.upper_bound(lower), map.upper_bound(upper))
+      for a map from f values to buckets).
+    */
+    std::pair<std::size_t, std::size_t> get_index_range(
+        double lower, double upper) const {
+        if (buckets.empty()) {
+            return std::make_pair(0, 0);
+        }
+        const double min_f = offset + static_cast<double>(first_non_empty);
+        const double max_f = offset + static_cast<double>(buckets.size()) - 1;
+        const double first_f = std::max(std::floor(lower) + 1, min_f);
+        const double last_f = std::min(std::floor(upper), max_f);
+        if (first_f > last_f) {
+            return std::make_pair(0, 0);
+        }
+        return std::make_pair(static_cast<std::size_t>(first_f - offset),
+                              static_cast<std::size_t>(last_f - offset) + 1);
+    }
+
+public:
+    explicit FBucketOpenList(const Compare &compare = Compare())
+        : offset(0),
+          first_non_empty(0),
+          num_entries(0),
+          compare(compare) {
+    }
+
+    bool empty() const {
+        return num_entries == 0;
+    }
+
+    std::size_t size() const {
+        return num_entries;
+    }
+
+    int get_min_f() const {
+        assert(!empty());
+        return offset + static_cast<int>(first_non_empty);
+    }
+
+    const Entry &top() const {
+        assert(!empty());
+        assert(!buckets[first_non_empty].empty());
+        return buckets[first_non_empty].front();
+    }
+
+    void push(int f, Entry entry) {
+        std::vector<Entry> &bucket = get_or_create_bucket(f);
+        bucket.push_back(std::move(entry));
+        std::push_heap(bucket.begin(), bucket.end(), compare);
+        ++num_entries;
+    }
+
+    void pop() {
+        assert(!empty());
+        std::vector<Entry> &bucket = buckets[first_non_empty];
+        assert(!bucket.empty());
+        std::pop_heap(bucket.begin(), bucket.end(), compare);
+        bucket.pop_back();
+        --num_entries;
+        if (bucket.empty()) {
+            skip_empty_buckets();
+        }
+    }
+
+    // Pop entries from the top as long as they are stale.
+    template<typename IsStale>
+    void prune_top(const IsStale &is_stale) {
+        while (!empty() && is_stale(top())) {
+            pop();
+        }
+    }
+
+    /*
+      Call callback(entry) for all entries with lower < f <= upper in order
+      of increasing f. The callback must not modify this open list.
+    */
+    template<typename Callback>
+    void for_each_in_range(double lower, double upper,
+                           const Callback &callback) const {
+        const auto [begin, end] = get_index_range(lower, upper);
+        for (std::size_t index = begin; index < end; ++index) {
+            for (const Entry &entry : buckets[index]) {
+                callback(entry);
+            }
+        }
+    }
+
+    // Call callback(entry) for all entries in order of increasing f.
+    template<typename Callback>
+    void for_each(const Callback &callback) const {
+        for (std::size_t index = first_non_empty; index < buckets.size();
+             ++index) {
+            for (const Entry &entry : buckets[index]) {
+                callback(entry);
+            }
+        }
+    }
+
+    /*
+      Remove all entries for which pred(entry) holds, visiting the entries
+      in order of increasing f. Return the number of removed entries.
+    */
+    template<typename Predicate>
+    std::size_t remove_if(const Predicate &pred) {
+        std::size_t removed = 0;
+        for (std::size_t index = first_non_empty; index < buckets.size();
+             ++index) {
+            std::vector<Entry> &bucket = buckets[index];
+            const std::size_t old_size = bucket.size();
+            bucket.erase(std::remove_if(bucket.begin(), bucket.end(), pred),
+                         bucket.end());
+            if (bucket.size() != old_size) {
+                removed += old_size - bucket.size();
+                std::make_heap(bucket.begin(), bucket.end(), compare);
+                bucket.shrink_to_fit();
+            }
+        }
+        num_entries -= removed;
+        skip_empty_buckets();
+        return removed;
+    }
+};
+}
+
+#endif
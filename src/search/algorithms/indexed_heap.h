@@ -0,0 +1,158 @@
+#ifndef ALGORITHMS_INDEXED_HEAP_H
+#define ALGORITHMS_INDEXED_HEAP_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace indexed_heap {
+/*
+  D-ary heap of (key, value) pairs whose top is the entry with the minimal
+  key with respect to compare. Each value is contained at most once, and the
+  key of a contained value can be changed and the value can be removed in
+  logarithmic time.
+
+  For this, the heap keeps the position of every contained value in an
+  external position map, which must provide int &operator[](const Value &)
+  and return -1 for values that are not contained. Several heaps can share
+  a position map if each value is contained in at most one of them.
+
+  Compared to node-based heaps with handles (such as Fibonacci heaps), all
+  entries are stored in one array, so there is no allocation per entry and
+  sift operations touch few cache lines. The arity D = 4 halves the depth
+  of the heap compared to a binary heap.
+*/
+template<typename Key, typename Value, typename PositionMap,
+         typename Compare = std::less<Key>, std::size_t D = 4>
+class IndexedHeap {
+    static_assert(D >= 2, "The heap arity must be at least two.");
+
+    std::vector<std::pair<Key, Value>> entries;
+    PositionMap *positions;
+    Compare compare;
+
+    void place(std::size_t index, std::pair<Key, Value> &&entry) {
+        (*positions)[entry.second] = index;
+        entries[index] = std::move(entry);
+    }
+
+    void sift_up(std::size_t hole, std::pair<Key, Value> &&entry) {
+        while (hole > 0) {
+            std::size_t parent = (hole - 1) / D;
+            if (!compare(entry.first, entries[parent].first))
+                break;
+            place(hole, std::move(entries[parent]));
+            hole = parent;
+        }
+        place(hole, std::move(entry));
+    }
+
+    void sift_down(std::size_t hole, std::pair<Key, Value> &&entry) {
+        const std::size_t size = entries.size();
+        while (true) {
+            std::size_t first_child = D * hole + 1;
+            if (first_child >= size)
+                break;
+            std::size_t last_child = std::min(first_child + D, size);
+            std::size_t best_child = first_child;
+            for (std::size_t child = first_child + 1; child < last_child; ++child) {
+                if (compare(entries[child].first, entries[best_child].first))
+                    best_child = child;
+            }
+            if (!compare(entries[best_child].first, entry.first))
+                break;
+            place(hole, std::move(entries[best_child]));
+            hole = best_child;
+        }
+        place(hole, std::move(entry));
+    }
+
+    // Move entry into the hole at index, in whichever direction is needed.
+    void restore(std::size_t index, std::pair<Key, Value> &&entry) {
+        if (index > 0 && compare(entry.first, entries[(index - 1) / D].first))
+            sift_up(index, std::move(entry));
+        else
+            sift_down(index, std::move(entry));
+    }
+
+    void remove_at(std::size_t index) {
+        (*positions)[entries[index].second] = -1;
+        std::pair<Key, Value> last = std::move(entries.back());
+        entries.pop_back();
+        if (index < entries.size())
+            restore(index, std::move(last));
+    }
+public:
+    explicit IndexedHeap(PositionMap &positions, const Compare &compare = Compare())
+        : positions(&positions),
+          compare(compare) {
+    }
+
+    bool empty() const {
+        return entries.empty();
+    }
+
+    std::size_t size() const {
+        return entries.size();
+    }
+
+    // Iteration visits all (key, value) entries in heap order (not sorted).
+    typename std::vector<std::pair<Key, Value>>::const_iterator begin() const {
+        return entries.begin();
+    }
+
+    typename std::vector<std::pair<Key, Value>>::const_iterator end() const {
+        return entries.end();
+    }
+
+    const Value &top() const {
+        assert(!empty());
+        return entries.front().second;
+    }
+
+    const Key &top_key() const {
+        assert(!empty());
+        return entries.front().first;
+    }
+
+    bool contains(const Value &value) const {
+        return (*positions)[value] != -1;
+    }
+
+    void push(const Key &key, const Value &value) {
+        assert(!contains(value));
+        entries.emplace_back(key, value);
+        sift_up(entries.size() - 1, std::make_pair(key, value));
+    }
+
+    // Change the key of a contained value.
+    void update(const Key &key, const Value &value) {
+        int index = (*positions)[value];
+        assert(index >= 0 && static_cast<std::size_t>(index) < entries.size());
+        restore(index, std::make_pair(key, value));
+    }
+
+    void push_or_update(const Key &key, const Value &value) {
+        if (contains(value))
+            update(key, value);
+        else
+            push(key, value);
+    }
+
+    void pop() {
+        assert(!empty());
+        remove_at(0);
+    }
+
+    void erase(const Value &value) {
+        int index = (*positions)[value];
+        assert(index >= 0 && static_cast<std::size_t>(index) < entries.size());
+        remove_at(index);
+    }
+};
+}
+
+#endif
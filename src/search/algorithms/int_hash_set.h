@@ -2,12 +2,14 @@
 #define ALGORITHMS_INT_HASH_SET_H
 
 #include "../utils/collections.h"
+#include "../utils/hash.h"
 #include "../utils/language.h"
 #include "../utils/logging.h"
 #include "../utils/system.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <utility>
@@ -43,8 +45,19 @@ namespace int_hash_set {
   The maximum capacity (i.e., number of buckets) is 2^30 because we
   use a signed integer to store it, we grow the hash set by doubling
   its capacity, and the next larger power of 2 (2^31) is too big for
-  an int. The maximum capacity could be increased by storing the
-  number of buckets in a larger data type.
+  an int.
+
+  If the CMake option USE_64BIT_STATE_IDS is set, keys, hashes and
+  bucket indices use 64-bit integers instead. This lifts both limits
+  (for all practical purposes) at the cost of 16 bytes per bucket.
+  Hashers should return int_hash_set::get_hash(hash_state) (or
+  get_hash(hash) for a 64-bit hash value) so that they compute hashes
+  of the configured width.
+
+  Each bucket stores the full hash of its key next to the key, and
+  lookups only call the equality function for keys whose stored hash
+  matches. Therefore, probes of non-matching buckets never access the
+  data behind the keys.
 
   Note on hash functions:
 
@@ -69,17 +82,45 @@ namespace int_hash_set {
 
 */
 
+#ifdef USE_64BIT_STATE_IDS
+using KeyType = std::int64_t;
+using HashType = std::uint64_t;
+// Type used for bucket indices, capacities and the number of entries.
+using IndexType = std::int64_t;
+
+static_assert(sizeof(KeyType) == 8, "KeyType does not use 8 bytes");
+static_assert(sizeof(HashType) == 8, "HashType does not use 8 bytes");
+
+inline HashType get_hash(utils::HashState &hash_state) {
+    return hash_state.get_hash64();
+}
+
+inline HashType get_hash(std::uint64_t hash) {
+    return static_cast<HashType>(hash);
+}
+#else
 using KeyType = int;
 using HashType = unsigned int;
+// Type used for bucket indices, capacities and the number of entries.
+using IndexType = int;
 
 static_assert(sizeof(KeyType) == 4, "KeyType does not use 4 bytes");
 static_assert(sizeof(HashType) == 4, "HashType does not use 4 bytes");
 
+inline HashType get_hash(utils::HashState &hash_state) {
+    return hash_state.get_hash32();
+}
+
+inline HashType get_hash(std::uint64_t hash) {
+    return static_cast<HashType>(hash);
+}
+#endif
+
 template<typename Hasher, typename Equal>
 class IntHashSet {
     // Max distance from the ideal bucket to the actual bucket for each key.
     static const int MAX_DISTANCE = 32;
-    static const unsigned int MAX_BUCKETS = std::numeric_limits<unsigned int>::max();
+    static const HashType MAX_BUCKETS = std::numeric_limits<IndexType>::max();
 
     struct Bucket {
         KeyType key;
@@ -105,16 +146,16 @@ class IntHashSet {
     Hasher hasher;
     Equal equal;
     std::vector<Bucket> buckets;
-    int num_entries;
+    IndexType num_entries;
     int num_resizes;
 
-    int capacity() const {
+    IndexType capacity() const {
         return buckets.size();
     }
 
-    void rehash(int new_capacity) {
+    void rehash(IndexType new_capacity) {
         assert(new_capacity >= 1);
-        int num_entries_before = num_entries;
+        IndexType num_entries_before = num_entries;
         std::vector<Bucket> old_buckets = std::move(buckets);
         assert(buckets.empty());
         num_entries = 0;
@@ -130,7 +171,7 @@ class IntHashSet {
     }
 
     void enlarge() {
-        unsigned int num_buckets = buckets.size();
+        HashType num_buckets = buckets.size();
         // Verify that the number of buckets is a power of 2.
         assert((num_buckets & (num_buckets - 1)) == 0);
         if (num_buckets > MAX_BUCKETS / 2) {
@@ -145,9 +186,9 @@ class IntHashSet {
         rehash(num_buckets * 2);
     }
 
-    int get_bucket(HashType hash) const {
+    IndexType get_bucket(HashType hash) const {
         assert(!buckets.empty());
-        unsigned int num_buckets = buckets.size();
+        HashType num_buckets = buckets.size();
         // Verify that the number of buckets is a power of 2.
         assert((num_buckets & (num_buckets - 1)) == 0);
         /* We want to return hash % num_buckets. The following line does this
@@ -159,7 +200,7 @@ class IntHashSet {
       Return distance from index1 to index2, only moving right and wrapping
       from the last to the first bucket.
     */
-    int get_distance(int index1, int index2) const {
+    IndexType get_distance(IndexType index1, IndexType index2) const {
         assert(utils::in_bounds(index1, buckets));
         assert(utils::in_bounds(index2, buckets));
         if (index2 >= index1) {
@@ -169,7 +210,7 @@ class IntHashSet {
         }
     }
 
-    int find_next_free_bucket_index(int index) const {
+    IndexType find_next_free_bucket_index(IndexType index) const {
         assert(num_entries < capacity());
         assert(utils::in_bounds(index, buckets));
         while (buckets[index].full()) {
@@ -180,9 +221,9 @@ class IntHashSet {
 
     KeyType find_equal_key(KeyType key, HashType hash) const {
         assert(hasher(key) == hash);
-        int ideal_index = get_bucket(hash);
+        IndexType ideal_index = get_bucket(hash);
         for (int i = 0; i < MAX_DISTANCE; ++i) {
-            int index = get_bucket(ideal_index + i);
+            IndexType index = get_bucket(ideal_index + i);
             const Bucket &bucket = buckets[index];
             if (bucket.full() && bucket.hash == hash && equal(bucket.key, key)) {
                 return bucket.key;
@@ -222,10 +263,10 @@ class IntHashSet {
         assert(num_entries < capacity());
 
         // Compute ideal bucket.
-        int ideal_index = get_bucket(hash);
+        IndexType ideal_index = get_bucket(hash);
 
         // Find first free bucket left of the ideal bucket.
-        int free_index = find_next_free_bucket_index(ideal_index);
+        IndexType free_index = find_next_free_bucket_index(ideal_index);
 
         /*
           While the free bucket is too far from the ideal bucket, move the free
@@ -236,15 +277,15 @@ class IntHashSet {
         */
         while (get_distance(ideal_index, free_index) >= MAX_DISTANCE) {
             bool swapped = false;
-            int num_buckets = capacity();
-            int max_offset = std::min(MAX_DISTANCE, num_buckets) - 1;
-            for (int offset = max_offset; offset >= 1; --offset) {
+            IndexType num_buckets = capacity();
+            IndexType max_offset = std::min<IndexType>(MAX_DISTANCE, num_buckets) - 1;
+            for (IndexType offset = max_offset; offset >= 1; --offset) {
                 assert(offset < num_buckets);
-                int candidate_index = free_index + num_buckets - offset;
+                IndexType candidate_index = free_index + num_buckets - offset;
                 assert(candidate_index >= 0);
                 candidate_index = get_bucket(candidate_index);
                 HashType candidate_hash = buckets[candidate_index].hash;
-                int candidate_ideal_index = get_bucket(candidate_hash);
+                IndexType candidate_ideal_index = get_bucket(candidate_hash);
                 if (get_distance(candidate_ideal_index, free_index) < MAX_DISTANCE) {
                     // Candidate can be swapped.
                     std::swap(buckets[candidate_index], buckets[free_index]);
@@ -276,7 +317,7 @@ public:
           num_resizes(0) {
     }
 
-    int size() const {
+    IndexType size() const {
         return num_entries;
     }
 
@@ -292,10 +333,33 @@ public:
         return insert(key, hasher(key));
     }
 
+    /*
+      Remove the given key (or the equivalent key contained in the hash set)
+      from the hash set. Return whether a key was removed.
+
+      Emptying a bucket does not move any other key, so all remaining keys
+      stay at most "max_distance" buckets away from their ideal bucket.
+    */
+    bool erase(KeyType key) {
+        assert(key >= 0);
+        HashType hash = hasher(key);
+        IndexType ideal_index = get_bucket(hash);
+        for (int i = 0; i < MAX_DISTANCE; ++i) {
+            IndexType index = get_bucket(ideal_index + i);
+            Bucket &bucket = buckets[index];
+            if (bucket.full() && bucket.hash == hash && equal(bucket.key, key)) {
+                bucket = Bucket();
+                --num_entries;
+                return true;
+            }
+        }
+        return false;
+    }
+
     void dump() const {
-        int num_buckets = capacity();
+        IndexType num_buckets = capacity();
         utils::g_log << "[";
-        for (int i = 0; i < num_buckets; ++i) {
+        for (IndexType i = 0; i < num_buckets; ++i) {
             const Bucket &bucket = buckets[i];
             if (bucket.full()) {
                 utils::g_log << bucket.key;
@@ -311,7 +375,7 @@ public:
 
     void print_statistics() const {
         assert(!buckets.empty());
-        int num_buckets = capacity();
+        IndexType num_buckets = capacity();
         assert(num_buckets != 0);
         utils::g_log << "Int hash set load factor: " << num_entries << "/"
                      << num_buckets << " = "
@@ -325,7 +389,7 @@ template<typename Hasher, typename Equal>
 const int IntHashSet<Hasher, Equal>::MAX_DISTANCE;
 
 template<typename Hasher, typename Equal>
-const unsigned int IntHashSet<Hasher, Equal>::MAX_BUCKETS;
+const HashType IntHashSet<Hasher, Equal>::MAX_BUCKETS;
 }
 
 #endif
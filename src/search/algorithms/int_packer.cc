@@ -53,6 +53,18 @@ public:
     ~VariableInfo() {
     }
 
+    int get_bin_index() const {
+        return bin_index;
+    }
+
+    int get_shift() const {
+        return shift;
+    }
+
+    Bin get_read_mask() const {
+        return read_mask;
+    }
+
     int get(const Bin *buffer) const {
         return (buffer[bin_index] & read_mask) >> shift;
     }
@@ -60,7 +72,7 @@ public:
     void set(Bin *buffer, int value) const {
         assert(value >= 0 && value < range);
         Bin &bin = buffer[bin_index];
-        bin = (bin & clear_mask) | (value << shift);
+        bin = (bin & clear_mask) | (Bin(value) << shift);
     }
 };
 
@@ -81,6 +93,18 @@ void IntPacker::set(Bin *buffer, int var, int value) const {
     var_infos[var].set(buffer, value);
 }
 
+int IntPacker::get_bin_index(int var) const {
+    return var_infos[var].get_bin_index();
+}
+
+int IntPacker::get_shift(int var) const {
+    return var_infos[var].get_shift();
+}
+
+IntPacker::Bin IntPacker::get_read_mask(int var) const {
+    return var_infos[var].get_read_mask();
+}
+
 void IntPacker::pack_bins(const vector<int> &ranges) {
     assert(var_infos.empty());
 
@@ -1,6 +1,7 @@
 #ifndef ALGORITHMS_INT_PACKER_H
 #define ALGORITHMS_INT_PACKER_H
 
+#include <cstdint>
 #include <vector>
 
 /*
@@ -28,7 +29,17 @@ class IntPacker {
                      std::vector<std::vector<int>> &bits_to_vars);
     void pack_bins(const std::vector<int> &ranges);
 public:
+    /*
+      The bin width is chosen at compile time (CMake option
+      USE_64BIT_STATE_BINS). Wider bins waste fewer bits for tasks with many
+      variables that do not fit well into 32-bit bins, but need more memory
+      per state for small tasks.
+    */
+#ifdef USE_64BIT_STATE_BINS
+    typedef std::uint64_t Bin;
+#else
     typedef unsigned int Bin;
+#endif
 
     /*
       The constructor takes the range for each variable. The domain of
@@ -43,6 +54,15 @@ public:
     void set(Bin *buffer, int var, int value) const;
 
     int get_num_bins() const {return num_bins;}
+
+    /*
+      Position of a variable in the packed representation: its value is
+      (buffer[get_bin_index(var)] & get_read_mask(var)) >> get_shift(var).
+      This allows to test conditions directly on packed buffers.
+    */
+    int get_bin_index(int var) const;
+    int get_shift(int var) const;
+    Bin get_read_mask(int var) const;
 };
 }
 
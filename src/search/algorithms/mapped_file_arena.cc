@@ -0,0 +1,149 @@
+#include "mapped_file_arena.h"
+
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace mapped_file_arena {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+static size_t get_page_size() {
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+static size_t round_up(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+NO_RETURN
+static void exit_with_system_error(const string &what, utils::ExitCode exit_code) {
+    cerr << "Mapped state storage: " << what << " failed: "
+         << strerror(errno) << endl;
+    utils::exit_with(exit_code);
+}
+
+MappedFileArena::MappedFileArena(size_t chunk_bytes)
+    : chunk_bytes(round_up(chunk_bytes, get_page_size())),
+      file_descriptor(-1),
+      file_size(0),
+      used_bytes_in_last_chunk(0),
+      allocated_bytes(0) {
+    const char *tmp_dir = getenv("TMPDIR");
+    string path = string(tmp_dir && *tmp_dir ? tmp_dir : "/tmp") +
+        "/fast-downward-states-XXXXXX";
+    file_descriptor = mkstemp(&path[0]);
+    if (file_descriptor == -1) {
+        exit_with_system_error("creating " + path, utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    // The file is deleted as soon as it is closed (or the process ends).
+    unlink(path.c_str());
+}
+
+MappedFileArena::~MappedFileArena() {
+    for (const auto &chunk : chunks) {
+        munmap(chunk.first, chunk.second);
+    }
+    close(file_descriptor);
+}
+
+void MappedFileArena::add_chunk(size_t min_bytes) {
+    size_t bytes = max(chunk_bytes, round_up(min_bytes, get_page_size()));
+    off_t offset = file_size;
+#if OPERATING_SYSTEM == LINUX
+    // Reserve the disk space now, otherwise a full disk raises SIGBUS later.
+    errno = posix_fallocate(file_descriptor, offset, bytes);
+    if (errno != 0) {
+        exit_with_system_error("allocating disk space", utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+#else
+    if (ftruncate(file_descriptor, offset + bytes) == -1) {
+        exit_with_system_error("growing the file", utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+#endif
+    void *address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         file_descriptor, offset);
+    if (address == MAP_FAILED) {
+        exit_with_system_error("mapping the file", utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+#ifdef MADV_COLD
+    if (chunks.size() >= 2) {
+        const auto &cold_chunk = chunks[chunks.size() - 2];
+        madvise(cold_chunk.first, cold_chunk.second, MADV_COLD);
+    }
+#endif
+    chunks.emplace_back(static_cast<char *>(address), bytes);
+    file_size += bytes;
+    used_bytes_in_last_chunk = 0;
+}
+
+void *MappedFileArena::allocate(size_t bytes, size_t alignment) {
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    size_t begin = round_up(used_bytes_in_last_chunk, alignment);
+    if (chunks.empty() || begin + bytes > chunks.back().second) {
+        add_chunk(bytes);
+        begin = 0;
+    }
+    used_bytes_in_last_chunk = begin + bytes;
+    allocated_bytes += bytes;
+    return chunks.back().first + begin;
+}
+
+size_t MappedFileArena::get_resident_bytes() const {
+    size_t page_size = get_page_size();
+    size_t resident_pages = 0;
+#if OPERATING_SYSTEM == LINUX
+    vector<unsigned char> pages;
+#else
+    vector<char> pages;
+#endif
+    for (const auto &chunk : chunks) {
+        pages.resize(chunk.second / page_size);
+        if (mincore(chunk.first, chunk.second, pages.data()) == 0) {
+            resident_pages += count_if(
+                pages.begin(), pages.end(), [](auto page) {return page & 1;});
+        }
+    }
+    return resident_pages * page_size;
+}
+#else
+MappedFileArena::MappedFileArena(size_t chunk_bytes)
+    : chunk_bytes(chunk_bytes),
+      file_descriptor(-1),
+      file_size(0),
+      used_bytes_in_last_chunk(0),
+      allocated_bytes(0) {
+    cerr << "Mapped state storage is not supported on this operating system."
+         << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+}
+
+MappedFileArena::~MappedFileArena() {
+}
+
+void MappedFileArena::add_chunk(size_t) {
+}
+
+void *MappedFileArena::allocate(size_t, size_t) {
+    return nullptr;
+}
+
+size_t MappedFileArena::get_resident_bytes() const {
+    return 0;
+}
+#endif
+
+const size_t MappedFileArena::DEFAULT_CHUNK_BYTES;
+}
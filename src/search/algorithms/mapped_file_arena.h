@@ -0,0 +1,118 @@
+#ifndef ALGORITHMS_MAPPED_FILE_ARENA_H
+#define ALGORITHMS_MAPPED_FILE_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*
+  MappedFileArena hands out memory from chunks of a temporary file that is
+  mapped into memory (MAP_SHARED) instead of from the heap. The file is
+  unlinked immediately after it is created, so it disappears with the
+  process. Since the pages are backed by the file rather than by swap, the
+  operating system can write out cold pages under memory pressure and drop
+  them from memory. Additionally, we advise the kernel that all chunks except
+  the two most recent ones are cold (where MADV_COLD is available), because
+  the data of older states is only needed for duplicate checks and path
+  extraction.
+
+  Memory is allocated by bumping a pointer in the current chunk and is only
+  released when the arena is destroyed, which fits the append-only usage of
+  the state registry. The file is created in the directory given by the
+  environment variable TMPDIR (default: /tmp).
+
+  MappedFileAllocator is an allocator for the containers in
+  segmented_vector.h. If it holds no arena (default construction), it uses
+  the heap like std::allocator.
+
+  Mapped files are only supported on Linux and macOS.
+*/
+
+namespace mapped_file_arena {
+class MappedFileArena {
+    const std::size_t chunk_bytes;
+    int file_descriptor;
+    std::size_t file_size;
+    // Start address and size of all mapped chunks.
+    std::vector<std::pair<char *, std::size_t>> chunks;
+    std::size_t used_bytes_in_last_chunk;
+    std::size_t allocated_bytes;
+
+    void add_chunk(std::size_t min_bytes);
+public:
+    static const std::size_t DEFAULT_CHUNK_BYTES = 16 * 1024 * 1024;
+
+    explicit MappedFileArena(std::size_t chunk_bytes = DEFAULT_CHUNK_BYTES);
+    ~MappedFileArena();
+
+    MappedFileArena(const MappedFileArena &) = delete;
+    MappedFileArena &operator=(const MappedFileArena &) = delete;
+
+    void *allocate(std::size_t bytes, std::size_t alignment);
+
+    // Number of bytes handed out by allocate().
+    std::size_t get_allocated_bytes() const {
+        return allocated_bytes;
+    }
+
+    // Number of bytes of the file that are mapped into memory.
+    std::size_t get_mapped_bytes() const {
+        return file_size;
+    }
+
+    // Number of mapped bytes that are currently resident in memory.
+    std::size_t get_resident_bytes() const;
+};
+
+
+template<typename T>
+class MappedFileAllocator {
+    template<typename>
+    friend class MappedFileAllocator;
+
+    std::shared_ptr<MappedFileArena> arena;
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = MappedFileAllocator<U>;
+    };
+
+    MappedFileAllocator() = default;
+
+    explicit MappedFileAllocator(const std::shared_ptr<MappedFileArena> &arena)
+        : arena(arena) {
+    }
+
+    template<typename U>
+    MappedFileAllocator(const MappedFileAllocator<U> &other)
+        : arena(other.arena) {
+    }
+
+    T *allocate(std::size_t n) {
+        if (arena)
+            return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, std::size_t n) {
+        // Memory from the arena is released when the arena is destroyed.
+        if (!arena)
+            std::allocator<T>().deallocate(p, n);
+    }
+
+    template<typename U, typename ... Args>
+    void construct(U *p, Args && ... args) {
+        ::new (static_cast<void *>(p)) U(std::forward<Args>(args) ...);
+    }
+
+    template<typename U>
+    void destroy(U *p) {
+        p->~U();
+    }
+};
+}
+
+#endif
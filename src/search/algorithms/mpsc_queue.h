@@ -0,0 +1,89 @@
+#ifndef ALGORITHMS_MPSC_QUEUE_H
+#define ALGORITHMS_MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace mpsc_queue {
+/*
+  Lock-free queue for many producer threads and a single consumer thread.
+
+  Producers push their values onto a linked stack with a compare-and-swap
+  loop. The consumer does not pop single values but takes the whole stack
+  at once with a single exchange and reverses it, so the values are
+  consumed in the order in which they were pushed. Since nodes are only
+  ever removed all at once, the ABA problem of lock-free stacks does not
+  arise.
+
+  Every push allocates a node, so values should be batches of work rather
+  than single items.
+*/
+template<typename T>
+class MPSCQueue {
+    struct Node {
+        T value;
+        Node *next;
+
+        Node(T &&value, Node *next)
+            : value(std::move(value)), next(next) {
+        }
+    };
+
+    std::atomic<Node *> head;
+
+    static void delete_nodes(Node *node) {
+        while (node) {
+            Node *next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+public:
+    MPSCQueue()
+        : head(nullptr) {
+    }
+
+    MPSCQueue(const MPSCQueue &) = delete;
+    MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+    ~MPSCQueue() {
+        delete_nodes(head.load(std::memory_order_acquire));
+    }
+
+    // Can be called by any thread.
+    void push(T value) {
+        Node *node = new Node(std::move(value), head.load(std::memory_order_relaxed));
+        while (!head.compare_exchange_weak(
+                   node->next, node,
+                   std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    /*
+      Move all values pushed so far to the end of values, in the order in
+      which they were pushed. Must only be called by the consumer thread.
+    */
+    void pop_all(std::vector<T> &values) {
+        Node *node = head.exchange(nullptr, std::memory_order_acquire);
+        Node *reversed = nullptr;
+        while (node) {
+            Node *next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+        for (Node *current = reversed; current; current = current->next) {
+            values.push_back(std::move(current->value));
+        }
+        delete_nodes(reversed);
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_relaxed) == nullptr;
+    }
+};
+}
+
+#endif
@@ -0,0 +1,225 @@
+#include "segment_arena.h"
+
+#include "../utils/collections.h"
+#include "../utils/logging.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#if OPERATING_SYSTEM == LINUX
+#include <sys/mman.h>
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+namespace segment_arena {
+static size_t round_up(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+#if OPERATING_SYSTEM == LINUX
+NO_RETURN
+static void exit_with_system_error(const string &what) {
+    cerr << "Segment arena: " << what << " failed: " << strerror(errno) << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+}
+
+/*
+  Map bytes (a multiple of BLOCK_BYTES) of anonymous memory starting at a
+  multiple of BLOCK_BYTES, so that the range can be backed by huge pages.
+*/
+static char *map_aligned(size_t bytes, int prot, int flags) {
+    const size_t alignment = SegmentArena::BLOCK_BYTES;
+    void *address = mmap(nullptr, bytes + alignment, prot,
+                         MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+    if (address == MAP_FAILED) {
+        exit_with_system_error("mapping memory");
+    }
+    char *begin = static_cast<char *>(address);
+    char *aligned_begin = reinterpret_cast<char *>(
+        round_up(reinterpret_cast<size_t>(begin), alignment));
+    if (aligned_begin != begin)
+        munmap(begin, aligned_begin - begin);
+    size_t tail_bytes = (begin + bytes + alignment) - (aligned_begin + bytes);
+    if (tail_bytes)
+        munmap(aligned_begin + bytes, tail_bytes);
+    return aligned_begin;
+}
+
+static void advise_huge_pages(char *address, size_t bytes) {
+#ifdef MADV_HUGEPAGE
+    madvise(address, bytes, MADV_HUGEPAGE);
+#else
+    (void)address;
+    (void)bytes;
+#endif
+}
+
+SegmentArena::SegmentArena(Backing backing, size_t reserved_bytes)
+    : backing(backing),
+      used_bytes_in_last_block(0),
+      committed_bytes_in_last_block(0),
+      mapped_bytes(0),
+      num_hugetlb_blocks(0) {
+    if (backing == Backing::RESERVED_RANGE) {
+        /*
+          Reserving the range counts towards the address space limit, so we
+          leave at least half of it to the rest of the planner.
+        */
+        struct rlimit limit;
+        if (getrlimit(RLIMIT_AS, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY &&
+            reserved_bytes > limit.rlim_cur / 2) {
+            reserved_bytes = limit.rlim_cur / 2;
+            utils::g_log << "Reduced reserved range for per-state information to "
+                         << reserved_bytes << " bytes (half the address space limit)"
+                         << endl;
+        }
+        size_t bytes = max(round_up(reserved_bytes, BLOCK_BYTES), BLOCK_BYTES);
+        char *begin = map_aligned(bytes, PROT_NONE, MAP_NORESERVE);
+        advise_huge_pages(begin, bytes);
+        blocks.emplace_back(begin, bytes);
+    }
+}
+
+SegmentArena::~SegmentArena() {
+    for (const auto &block : blocks) {
+        munmap(block.first, block.second);
+    }
+}
+
+void SegmentArena::add_block(size_t min_bytes) {
+    assert(backing == Backing::HUGE_PAGES);
+    size_t bytes = round_up(max(min_bytes, BLOCK_BYTES), BLOCK_BYTES);
+    char *begin = nullptr;
+#ifdef MAP_HUGETLB
+    void *address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (address != MAP_FAILED) {
+        begin = static_cast<char *>(address);
+        ++num_hugetlb_blocks;
+    }
+#endif
+    if (!begin) {
+        begin = map_aligned(bytes, PROT_READ | PROT_WRITE, 0);
+        advise_huge_pages(begin, bytes);
+    }
+    blocks.emplace_back(begin, bytes);
+    used_bytes_in_last_block = 0;
+    committed_bytes_in_last_block = bytes;
+    mapped_bytes += bytes;
+}
+
+void SegmentArena::commit(size_t end) {
+    assert(backing == Backing::RESERVED_RANGE);
+    size_t new_committed_bytes = round_up(end, BLOCK_BYTES);
+    char *begin = blocks.back().first;
+    if (mprotect(begin + committed_bytes_in_last_block,
+                 new_committed_bytes - committed_bytes_in_last_block,
+                 PROT_READ | PROT_WRITE) == -1) {
+        exit_with_system_error("committing reserved memory");
+    }
+    mapped_bytes += new_committed_bytes - committed_bytes_in_last_block;
+    committed_bytes_in_last_block = new_committed_bytes;
+}
+
+void *SegmentArena::allocate(size_t bytes, size_t alignment, int consumer) {
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    assert(utils::in_bounds(consumer, consumers));
+    consumers[consumer].allocated_bytes += bytes;
+
+    // All blocks are aligned to alignof(max_align_t), see below.
+    if (alignment <= alignof(max_align_t)) {
+        auto it = free_segments.find(bytes);
+        if (it != free_segments.end() && !it->second.empty()) {
+            void *segment = it->second.back();
+            it->second.pop_back();
+            return segment;
+        }
+    }
+
+    alignment = max(alignment, alignof(max_align_t));
+    size_t begin = round_up(used_bytes_in_last_block, alignment);
+    if (blocks.empty() || begin + bytes > blocks.back().second) {
+        if (backing == Backing::RESERVED_RANGE) {
+            cerr << "Segment arena: the reserved range of "
+                 << blocks.back().second << " bytes is exhausted." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+        }
+        add_block(bytes);
+        begin = 0;
+    }
+    if (begin + bytes > committed_bytes_in_last_block)
+        commit(begin + bytes);
+    used_bytes_in_last_block = begin + bytes;
+    return blocks.back().first + begin;
+}
+#else
+SegmentArena::SegmentArena(Backing backing, size_t)
+    : backing(backing),
+      used_bytes_in_last_block(0),
+      committed_bytes_in_last_block(0),
+      mapped_bytes(0),
+      num_hugetlb_blocks(0) {
+    cerr << "Segment arenas are not supported on this operating system." << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+}
+
+SegmentArena::~SegmentArena() {
+}
+
+void SegmentArena::add_block(size_t) {
+}
+
+void SegmentArena::commit(size_t) {
+}
+
+void *SegmentArena::allocate(size_t, size_t, int) {
+    return nullptr;
+}
+#endif
+
+int SegmentArena::register_consumer(const string &name) {
+    auto it = find_if(consumers.begin(), consumers.end(),
+                      [&name](const Consumer &consumer) {
+                          return consumer.name == name;
+                      });
+    if (it != consumers.end())
+        return it - consumers.begin();
+    consumers.emplace_back(name);
+    return consumers.size() - 1;
+}
+
+void SegmentArena::deallocate(void *p, size_t bytes, int consumer) {
+    assert(utils::in_bounds(consumer, consumers));
+    assert(consumers[consumer].allocated_bytes >= bytes);
+    consumers[consumer].allocated_bytes -= bytes;
+    free_segments[bytes].push_back(p);
+}
+
+size_t SegmentArena::get_allocated_bytes() const {
+    size_t allocated_bytes = 0;
+    for (const Consumer &consumer : consumers)
+        allocated_bytes += consumer.allocated_bytes;
+    return allocated_bytes;
+}
+
+void SegmentArena::print_statistics() const {
+    utils::g_log << "Per-state information mapped: " << mapped_bytes << " bytes";
+    if (backing == Backing::HUGE_PAGES) {
+        utils::g_log << " (" << num_hugetlb_blocks << " of " << blocks.size()
+                     << " blocks from the huge page pool)";
+    }
+    utils::g_log << endl;
+    for (const Consumer &consumer : consumers) {
+        utils::g_log << "Per-state information allocated for " << consumer.name
+                     << ": " << consumer.allocated_bytes << " bytes" << endl;
+    }
+}
+
+const size_t SegmentArena::BLOCK_BYTES;
+}
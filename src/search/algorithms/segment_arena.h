@@ -0,0 +1,159 @@
+#ifndef ALGORITHMS_SEGMENT_ARENA_H
+#define ALGORITHMS_SEGMENT_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+  SegmentArena hands out the segments of the containers in segmented_vector.h
+  from large blocks of anonymous memory that are backed by 2 MB huge pages
+  where possible. Since all segments of all per-state tables then share few
+  huge pages instead of being spread over many 4 KB pages of the heap, this
+  reduces TLB misses and allocator overhead. There are two ways to obtain the
+  memory:
+
+  HUGE_PAGES maps one 2 MB block at a time. Each block is first requested
+  from the explicit huge page pool (MAP_HUGETLB); if that fails (e.g.,
+  because no huge pages are configured), the block is mapped normally at a
+  2 MB boundary and transparent huge pages are requested for it.
+
+  RESERVED_RANGE reserves one contiguous range of virtual addresses up front
+  and makes it accessible in 2 MB steps as it is used, requesting
+  transparent huge pages for the whole range. The range cannot grow: if it is
+  exhausted, the planner stops with an out-of-memory error.
+
+  Memory is allocated by bumping a pointer in the current block. Freed
+  segments are kept in a free list per size and reused by later allocations
+  of the same size, but memory is only returned to the operating system when
+  the arena is destroyed.
+
+  Every allocation is attributed to a consumer (see register_consumer), so
+  that print_statistics() can show how much memory each per-state table uses.
+
+  SegmentArenaAllocator is an allocator for the containers in
+  segmented_vector.h. If it holds no arena (default construction), it uses
+  the heap like std::allocator.
+
+  Segment arenas are only supported on Linux. They are not thread-safe.
+*/
+
+namespace segment_arena {
+enum class Backing {
+    HUGE_PAGES,
+    RESERVED_RANGE
+};
+
+class SegmentArena {
+    const Backing backing;
+    // Start address and size of all mapped blocks (one for RESERVED_RANGE).
+    std::vector<std::pair<char *, std::size_t>> blocks;
+    std::size_t used_bytes_in_last_block;
+    // Number of bytes of the last block that are accessible.
+    std::size_t committed_bytes_in_last_block;
+    std::size_t mapped_bytes;
+    int num_hugetlb_blocks;
+
+    std::unordered_map<std::size_t, std::vector<void *>> free_segments;
+
+    struct Consumer {
+        std::string name;
+        std::size_t allocated_bytes;
+        Consumer(const std::string &name)
+            : name(name), allocated_bytes(0) {
+        }
+    };
+    std::vector<Consumer> consumers;
+
+    void add_block(std::size_t min_bytes);
+    void commit(std::size_t end);
+public:
+    static const std::size_t BLOCK_BYTES = 2 * 1024 * 1024;
+
+    /*
+      reserved_bytes is the size of the address range reserved for
+      RESERVED_RANGE and ignored for HUGE_PAGES.
+    */
+    SegmentArena(Backing backing, std::size_t reserved_bytes);
+    ~SegmentArena();
+
+    SegmentArena(const SegmentArena &) = delete;
+    SegmentArena &operator=(const SegmentArena &) = delete;
+
+    // Return an ID for the named consumer to be passed to allocate().
+    int register_consumer(const std::string &name);
+
+    void *allocate(std::size_t bytes, std::size_t alignment, int consumer);
+    void deallocate(void *p, std::size_t bytes, int consumer);
+
+    // Number of bytes currently allocated by all consumers.
+    std::size_t get_allocated_bytes() const;
+
+    // Number of bytes that are mapped (and accessible) for the arena.
+    std::size_t get_mapped_bytes() const {
+        return mapped_bytes;
+    }
+
+    void print_statistics() const;
+};
+
+
+template<typename T>
+class SegmentArenaAllocator {
+    template<typename>
+    friend class SegmentArenaAllocator;
+
+    std::shared_ptr<SegmentArena> arena;
+    int consumer;
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = SegmentArenaAllocator<U>;
+    };
+
+    SegmentArenaAllocator()
+        : consumer(-1) {
+    }
+
+    SegmentArenaAllocator(const std::shared_ptr<SegmentArena> &arena, int consumer)
+        : arena(arena),
+          consumer(consumer) {
+    }
+
+    template<typename U>
+    SegmentArenaAllocator(const SegmentArenaAllocator<U> &other)
+        : arena(other.arena),
+          consumer(other.consumer) {
+    }
+
+    T *allocate(std::size_t n) {
+        if (arena)
+            return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T), consumer));
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, std::size_t n) {
+        if (arena)
+            arena->deallocate(p, n * sizeof(T), consumer);
+        else
+            std::allocator<T>().deallocate(p, n);
+    }
+
+    template<typename U, typename ... Args>
+    void construct(U *p, Args && ... args) {
+        ::new (static_cast<void *>(p)) U(std::forward<Args>(args) ...);
+    }
+
+    template<typename U>
+    void destroy(U *p) {
+        p->~U();
+    }
+};
+}
+
+#endif
@@ -2,8 +2,10 @@
 #define ALGORITHMS_SEGMENTED_VECTOR_H
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 /*
@@ -35,6 +37,14 @@
   storing many fixed-size arrays. It's essentially a variant of SegmentedVector
   where the size of the stored data is only known at runtime, not at compile
   time.
+
+  SegmentedArrayVector can be read concurrently while a single thread
+  appends to it: push_back never moves stored arrays, and the table of
+  segments is replaced by a larger copy (published with release semantics)
+  instead of being reallocated in place. Readers may access all arrays whose
+  indices they obtained from the writer through some synchronization (e.g.,
+  a mutex or an atomic variable). Only the writer may call size(),
+  pop_back() and resize().
 */
 
 // TODO: Get rid of the code duplication here. How to do it without
@@ -158,7 +168,14 @@ class SegmentedArrayVector {
 
     ElementAllocator element_allocator;
 
-    std::vector<Element *> segments;
+    /*
+      Old segment tables are kept until destruction because concurrent
+      readers might still use them. Since each table has twice the capacity
+      of its predecessor, they need less memory than the current table.
+    */
+    std::vector<std::unique_ptr<Element *[]>> segment_tables;
+    std::atomic<Element **> segments;
+    size_t num_segments;
     size_t the_size;
 
     size_t get_segment(size_t index) const {
@@ -169,9 +186,22 @@ class SegmentedArrayVector {
         return (index % arrays_per_segment) * elements_per_array;
     }
 
+    size_t get_segment_table_capacity() const {
+        return segment_tables.empty() ? 0 : size_t(16) << (segment_tables.size() - 1);
+    }
+
     void add_segment() {
         Element *new_segment = element_allocator.allocate(elements_per_segment);
-        segments.push_back(new_segment);
+        size_t capacity = get_segment_table_capacity();
+        if (num_segments == capacity) {
+            std::unique_ptr<Element *[]> new_table(
+                new Element *[std::max(2 * capacity, size_t(16))]);
+            Element **old_table = segments.load(std::memory_order_relaxed);
+            std::copy(old_table, old_table + num_segments, new_table.get());
+            segments.store(new_table.get(), std::memory_order_release);
+            segment_tables.push_back(std::move(new_table));
+        }
+        segments.load(std::memory_order_relaxed)[num_segments++] = new_segment;
     }
 
     // No implementation to forbid copies and assignment
@@ -183,16 +213,20 @@ public:
           arrays_per_segment(
               std::max(SEGMENT_BYTES / (elements_per_array * sizeof(Element)), size_t(1))),
           elements_per_segment(elements_per_array * arrays_per_segment),
+          segments(nullptr),
+          num_segments(0),
           the_size(0) {
     }
 
 
     SegmentedArrayVector(size_t elements_per_array_, const ElementAllocator &allocator_)
-        : element_allocator(allocator_),
-          elements_per_array(elements_per_array_),
+        : elements_per_array(elements_per_array_),
           arrays_per_segment(
               std::max(SEGMENT_BYTES / (elements_per_array * sizeof(Element)), size_t(1))),
           elements_per_segment(elements_per_array * arrays_per_segment),
+          element_allocator(allocator_),
+          segments(nullptr),
+          num_segments(0),
           the_size(0) {
     }
 
@@ -205,8 +239,9 @@ public:
                 element_allocator.destroy(operator[](i) + offset);
             }
         }
-        for (size_t i = 0; i < segments.size(); ++i) {
-            element_allocator.deallocate(segments[i], elements_per_segment);
+        Element **table = segments.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < num_segments; ++i) {
+            element_allocator.deallocate(table[i], elements_per_segment);
         }
     }
 
@@ -214,29 +249,34 @@ public:
         assert(index < the_size);
         size_t segment = get_segment(index);
         size_t offset = get_offset(index);
-        return segments[segment] + offset;
+        return segments.load(std::memory_order_acquire)[segment] + offset;
     }
 
     const Element *operator[](size_t index) const {
         assert(index < the_size);
         size_t segment = get_segment(index);
         size_t offset = get_offset(index);
-        return segments[segment] + offset;
+        return segments.load(std::memory_order_acquire)[segment] + offset;
     }
 
     size_t size() const {
         return the_size;
     }
 
+    // Number of bytes allocated for segments (excluding the segment tables).
+    size_t get_allocated_bytes() const {
+        return num_segments * elements_per_segment * sizeof(Element);
+    }
+
     void push_back(const Element *entry) {
         size_t segment = get_segment(the_size);
         size_t offset = get_offset(the_size);
-        if (segment == segments.size()) {
+        if (segment == num_segments) {
             assert(offset == 0);
             // Must add a new segment.
             add_segment();
         }
-        Element *dest = segments[segment] + offset;
+        Element *dest = segments.load(std::memory_order_relaxed)[segment] + offset;
         for (size_t i = 0; i < elements_per_array; ++i)
             element_allocator.construct(dest++, *entry++);
         ++the_size;
@@ -139,6 +139,17 @@ inline void AxiomEvaluator::evaluate_aux(Values &values, const Accessor &accesso
     if (!task_has_axioms)
         return;
 
+    /*
+      The queue and the numbers of unsatisfied conditions of the rules are
+      static rather than local variables to reduce reallocation effort (see
+      issue420). They are thread-local rather than instance variables so
+      that searches running in parallel (see parallel_portfolio) can share
+      the evaluator of a task.
+    */
+    static thread_local vector<const AxiomLiteral *> queue;
+    static thread_local vector<int> unsatisfied_conditions;
+    unsatisfied_conditions.resize(rules.size());
+
     assert(queue.empty());
     for (size_t var_id = 0; var_id < default_values.size(); ++var_id) {
         int default_value = default_values[var_id];
@@ -150,8 +161,9 @@ inline void AxiomEvaluator::evaluate_aux(Values &values, const Accessor &accesso
         }
     }
 
-    for (AxiomRule &rule : rules) {
-        rule.unsatisfied_conditions = rule.condition_count;
+    for (size_t rule_id = 0; rule_id < rules.size(); ++rule_id) {
+        const AxiomRule &rule = rules[rule_id];
+        unsatisfied_conditions[rule_id] = rule.condition_count;
 
         /*
           TODO: In a perfect world, trivial axioms would have been
@@ -181,7 +193,7 @@ inline void AxiomEvaluator::evaluate_aux(Values &values, const Accessor &accesso
             queue.pop_back();
             for (size_t i = 0; i < curr_literal->condition_of.size(); ++i) {
                 AxiomRule *rule = curr_literal->condition_of[i];
-                if (--rule->unsatisfied_conditions == 0) {
+                if (--unsatisfied_conditions[rule - rules.data()] == 0) {
                     int var_no = rule->effect_var;
                     int val = rule->effect_val;
                     if (accessor.get(values, var_no) != val) {
@@ -19,12 +19,11 @@ class AxiomEvaluator {
     };
     struct AxiomRule {
         int condition_count;
-        int unsatisfied_conditions;
         int effect_var;
         int effect_val;
         AxiomLiteral *effect_literal;
         AxiomRule(int cond_count, int eff_var, int eff_val, AxiomLiteral *eff_literal)
-            : condition_count(cond_count), unsatisfied_conditions(cond_count),
+            : condition_count(cond_count),
               effect_var(eff_var), effect_val(eff_val), effect_literal(eff_literal) {
         }
     };
@@ -53,12 +52,6 @@ class AxiomEvaluator {
     */
     std::vector<int> default_values;
 
-    /*
-      The queue is an instance variable rather than a local variable
-      to reduce reallocation effort. See issue420.
-    */
-    std::vector<const AxiomLiteral *> queue;
-
     template<typename Values, typename Accessor>
     void evaluate_aux(Values &values, const Accessor &accessor);
 public:
@@ -0,0 +1,103 @@
+/*
+  Throughput of the f-bucket open list used by the bounded-suboptimal
+  engines compared to the previously used map from f values to g-heaps.
+
+  Usage: f_bucket_open_list_benchmark [number of expansions]
+
+  The workload mimics a search: each expansion pops the entry with minimal f
+  (and maximal g), inserts a few successors whose f values are slightly
+  larger, and iterates over the promotion window (w * f_min_old, w * f_min_new]
+  whenever the minimal f value increases.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../algorithms/f_bucket_open_list.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using Entry = std::pair<int, int>; // (g, id)
+
+constexpr auto suboptimality_factor = 1.5;
+constexpr auto successors_per_expansion = 3;
+
+struct EntryCompare {
+	auto operator()(const Entry &lhs, const Entry &rhs) const -> bool { return lhs.first < rhs.first; }
+};
+
+class MapOpenList {
+	std::map<int, std::vector<Entry>> buckets;
+
+public:
+	auto empty() const -> bool { return buckets.empty(); }
+	auto get_min_f() const -> int { return std::begin(buckets)->first; }
+	auto top() const -> const Entry & { return std::begin(buckets)->second.front(); }
+	void push(int f, Entry entry) {
+		auto &bucket = buckets[f];
+		bucket.push_back(entry);
+		std::push_heap(std::begin(bucket), std::end(bucket), EntryCompare());
+	}
+	void pop() {
+		auto &bucket = std::begin(buckets)->second;
+		std::pop_heap(std::begin(bucket), std::end(bucket), EntryCompare());
+		bucket.pop_back();
+		if (bucket.empty())
+			buckets.erase(std::begin(buckets));
+	}
+	template <class Callback>
+	void for_each_in_range(double lower, double upper, const Callback &callback) const {
+		const auto end = buckets.upper_bound(upper);
+		for (auto it = buckets.upper_bound(lower); it != end; ++it)
+			for (const auto &entry : it->second)
+				callback(entry);
+	}
+};
+
+template <class OpenList>
+void run(const std::string &name, std::size_t num_expansions) {
+	auto rng = std::mt19937_64(2021);
+	auto cost = std::uniform_int_distribution<int>(1, 5);
+	auto h_change = std::uniform_int_distribution<int>(-1, 2);
+
+	auto open_list = OpenList();
+	open_list.push(100, {0, 0});
+	auto next_id = 1;
+	auto f_min = 0;
+	auto checksum = 0ll;
+	const auto start = Clock::now();
+	for (auto expansion = 0u; expansion < num_expansions && !open_list.empty(); ++expansion) {
+		const auto current_f_min = open_list.get_min_f();
+		if (current_f_min > f_min) {
+			open_list.for_each_in_range(suboptimality_factor * f_min, suboptimality_factor * current_f_min,
+			                            [&checksum](const auto &entry) { checksum += entry.second; });
+			f_min = current_f_min;
+		}
+		const auto [g, id] = open_list.top();
+		open_list.pop();
+		checksum += id;
+		const auto h = current_f_min - g;
+		for (auto i = 0; i < successors_per_expansion; ++i) {
+			const auto succ_g = g + cost(rng);
+			const auto succ_h = std::max(0, h + h_change(rng));
+			open_list.push(succ_g + succ_h, {succ_g, next_id++});
+		}
+	}
+	const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	std::cout << name << ": " << num_expansions / seconds << " expansions/s [checksum " << checksum << "]" << std::endl;
+}
+} // namespace
+
+auto main(int argc, char **argv) -> int {
+	const auto num_expansions = argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : std::size_t{2000000};
+	run<MapOpenList>("std::map of g-heaps", num_expansions);
+	run<f_bucket_open_list::FBucketOpenList<Entry, EntryCompare>>("FBucketOpenList    ", num_expansions);
+	return 0;
+}
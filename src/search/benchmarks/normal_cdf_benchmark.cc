@@ -0,0 +1,93 @@
+/*
+  Accuracy and throughput of the normal CDF implementations used by the
+  Nancy-assumption evaluators.
+
+  Usage: normal_cdf_benchmark [number of evaluations]
+
+  The accuracy check compares the table-based CDF against the erf-based CDF
+  on a dense grid over [-12, 12] (which covers the arguments we see in
+  practice: the distance to the cost bound divided by the standard deviation
+  of the solution cost belief, which is rarely larger than a few units) and
+  fails with a non-zero exit code if the maximal absolute error exceeds
+  max_error. The throughput is measured on normally distributed arguments.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../suboptimal_search/normal_distribution.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using suboptimal_search::NormalCDFMethod;
+
+constexpr auto max_error = 2e-9;
+constexpr auto grid_bound = 12.;
+constexpr auto grid_steps_per_unit = 100000;
+constexpr auto batch_size = 256;
+
+auto check_accuracy() -> bool {
+	auto worst_error = 0.;
+	auto worst_x = 0.;
+	const auto num_points = static_cast<int>(2 * grid_bound * grid_steps_per_unit);
+	for (auto i = 0; i <= num_points; ++i) {
+		const auto x = -grid_bound + static_cast<double>(i) / grid_steps_per_unit;
+		const auto error = std::abs(suboptimal_search::normal_cdf_table(x) - suboptimal_search::normal_cdf_erf(x));
+		if (error > worst_error) {
+			worst_error = error;
+			worst_x = x;
+		}
+	}
+	for (const auto x : {-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()}) {
+		const auto error = std::abs(suboptimal_search::normal_cdf_table(x) - suboptimal_search::normal_cdf_erf(x));
+		if (error > worst_error) {
+			worst_error = error;
+			worst_x = x;
+		}
+	}
+	const auto passed = worst_error <= max_error;
+	std::cout << "maximal absolute error: " << worst_error << " at x=" << worst_x << (passed ? " [ok]" : " [FAILED]") << std::endl;
+	return passed;
+}
+
+void run(const std::string &name, const std::vector<double> &arguments, NormalCDFMethod method, bool batched) {
+	auto results = std::vector<double>(arguments.size());
+	const auto start = Clock::now();
+	if (batched) {
+		for (std::size_t i = 0; i < arguments.size(); i += batch_size)
+			suboptimal_search::normal_cdf(arguments.data() + i, results.data() + i, std::min<std::size_t>(batch_size, arguments.size() - i), method);
+	} else {
+		for (std::size_t i = 0; i < arguments.size(); ++i)
+			results[i] = suboptimal_search::normal_cdf(arguments[i], method);
+	}
+	const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	auto checksum = 0.;
+	for (const auto result : results)
+		checksum += result;
+	std::cout << name << ": " << arguments.size() / seconds / 1e6 << "M evaluations/s [checksum " << checksum << "]" << std::endl;
+}
+} // namespace
+
+auto main(int argc, char **argv) -> int {
+	const auto num_evaluations = argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : std::size_t{20000000};
+	if (!check_accuracy())
+		return EXIT_FAILURE;
+
+	auto rng = std::mt19937_64(2021);
+	auto distribution = std::normal_distribution<double>(0., 2.);
+	auto arguments = std::vector<double>(num_evaluations);
+	for (auto &argument : arguments)
+		argument = distribution(rng);
+	run("ERF   scalar ", arguments, NormalCDFMethod::ERF, false);
+	run("ERF   batched", arguments, NormalCDFMethod::ERF, true);
+	run("TABLE scalar ", arguments, NormalCDFMethod::TABLE, false);
+	run("TABLE batched", arguments, NormalCDFMethod::TABLE, true);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+/*
+  Push/pop throughput of the floating-point open lists.
+
+  Usage: open_list_benchmark [number of entries]
+
+  "virtual" refers to an open list with a std::function comparator accessed
+  through the FloatingPointOpenList interface (the layout used before the
+  comparator became a template parameter), "direct" refers to the final
+  open list types with an inlined comparator.
+
+  The d-ary heaps are compared with the binary heap of BestFirstOpenList;
+  the reported bytes per entry exclude unused vector capacity. A heap that is
+  selected at runtime is accessed either through the FloatingPointOpenList
+  interface ("virtual") or as a BestFirstOpenListVariant ("variant", as in
+  DXES).
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "../floating_point_open_list/best_first_open_list.h"
+#include "../floating_point_open_list/d_ary_heap_open_list.h"
+#include "../floating_point_open_list/focal_open_list.h"
+#include "../floating_point_open_list/heap_type.h"
+
+using namespace floating_point_open_list;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+template <std::size_t N>
+auto generate_keys(std::size_t num_entries) -> std::vector<std::array<double, N>> {
+	auto rng = std::mt19937_64(2021);
+	// few distinct primary keys to exercise the tie-breaking
+	auto primary = std::uniform_int_distribution<int>(0, 1000);
+	auto secondary = std::uniform_real_distribution<double>(0., 100.);
+	auto keys = std::vector<std::array<double, N>>(num_entries);
+	for (auto &key : keys) {
+		key[0] = primary(rng) / 7.;
+		for (auto i = 1u; i < N; ++i)
+			key[i] = secondary(rng);
+	}
+	return keys;
+}
+
+template <class OpenList, std::size_t N>
+void run(const std::string &name, OpenList &open_list, const std::vector<std::array<double, N>> &keys, std::size_t bytes_per_entry = 0) {
+	const auto push_start = Clock::now();
+	for (auto i = 0u; i < keys.size(); ++i)
+		open_list.push(keys[i], static_cast<int>(i), false);
+	const auto pop_start = Clock::now();
+	auto checksum = 0ll;
+	while (!open_list.empty()) {
+		checksum += open_list.top();
+		open_list.pop();
+	}
+	const auto end = Clock::now();
+	const auto push_seconds = std::chrono::duration<double>(pop_start - push_start).count();
+	const auto pop_seconds = std::chrono::duration<double>(end - pop_start).count();
+	std::cout << name << " (N=" << N << "): " << keys.size() / push_seconds << " pushes/s, " << keys.size() / pop_seconds << " pops/s";
+	if (bytes_per_entry != 0)
+		std::cout << ", " << bytes_per_entry << " bytes/entry";
+	std::cout << " [checksum " << checksum << "]" << std::endl;
+}
+
+// open list interface for a BestFirstOpenListVariant
+template <std::size_t N>
+struct VariantOpenList {
+	BestFirstOpenListVariant<N, int> open_list;
+
+	void push(const std::array<double, N> &key, int value, bool preferred) {
+		std::visit([&](auto &list) { list.push(key, value, preferred); }, open_list);
+	}
+	auto empty() const -> bool {
+		return std::visit([](const auto &list) { return list.empty(); }, open_list);
+	}
+	auto top() const -> int {
+		return std::visit([](const auto &list) { return list.top(); }, open_list);
+	}
+	void pop() {
+		std::visit([](auto &list) { list.pop(); }, open_list);
+	}
+};
+
+template <std::size_t N>
+void run_all(std::size_t num_entries) {
+	using Base = FloatingPointOpenList<N, int>;
+	using LegacyCompare = typename Base::compare_type;
+	const auto keys = generate_keys<N>(num_entries);
+
+	// create the type-erased lists through a factory so that the compiler cannot devirtualize the calls
+	auto create_legacy_best_first = std::function<std::unique_ptr<Base>()>(
+			[]() { return std::make_unique<BestFirstOpenList<N, int, LegacyCompare>>(LegacyCompare(Base::get_default_compare())); });
+	auto create_legacy_focal = std::function<std::unique_ptr<Base>()>([]() {
+		return std::make_unique<FocalOpenList<N, int, LegacyCompare, std::function<bool(const std::pair<double, int> &, const std::pair<double, int> &)>>>(
+				LegacyCompare(Base::get_default_compare()), FocalKeyGreater<int>());
+	});
+
+	auto legacy_best_first = create_legacy_best_first();
+	run("BestFirstOpenList virtual", *legacy_best_first, keys);
+	auto best_first = BestFirstOpenList<N, int>();
+	run("BestFirstOpenList direct ", best_first, keys, sizeof(std::pair<std::array<double, N>, int>));
+
+	auto legacy_focal = create_legacy_focal();
+	run("FocalOpenList virtual    ", *legacy_focal, keys);
+	auto focal = FocalOpenList<N, int>();
+	run("FocalOpenList direct     ", focal, keys);
+
+	auto heap_4 = DAryHeapOpenList<N, int, 4>();
+	run("DAryHeapOpenList D=4     ", heap_4, keys, heap_4.bytes_per_entry());
+	auto heap_8 = DAryHeapOpenList<N, int, 8>();
+	run("DAryHeapOpenList D=8     ", heap_8, keys, heap_8.bytes_per_entry());
+	auto compressed_heap_4 = DAryHeapOpenList<N, int, 4, true>();
+	run("DAryHeapOpenList D=4 (c) ", compressed_heap_4, keys, compressed_heap_4.bytes_per_entry());
+	auto compressed_heap_8 = DAryHeapOpenList<N, int, 8, true>();
+	run("DAryHeapOpenList D=8 (c) ", compressed_heap_8, keys, compressed_heap_8.bytes_per_entry());
+
+	// heap selected at runtime (through a factory so that the compiler cannot resolve the type)
+	auto create_heap = std::function<std::unique_ptr<Base>()>([]() { return create_best_first_open_list<N, int>(HeapType::D_ARY_4, false); });
+	auto virtual_heap_4 = create_heap();
+	run("D=4 virtual              ", *virtual_heap_4, keys);
+	auto create_heap_variant = std::function<BestFirstOpenListVariant<N, int>()>(
+			[]() { return create_best_first_open_list_variant<N, int>(HeapType::D_ARY_4, false); });
+	auto variant_heap_4 = VariantOpenList<N>{create_heap_variant()};
+	run("D=4 variant              ", variant_heap_4, keys);
+}
+} // namespace
+
+auto main(int argc, char **argv) -> int {
+	const auto num_entries = argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : std::size_t{1000000};
+	run_all<1>(num_entries);
+	run_all<3>(num_entries);
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*
+  Registrations per second of a state-registry-like hash set on a synthetic
+  stream of packed states.
+
+  Usage: state_hash_benchmark [number of registrations] [bins per state]
+
+  Like StateRegistry, each registration appends the packed state to a pool,
+  inserts its index into an IntHashSet (which hashes and compares the state
+  data) and removes it from the pool again if it is a duplicate. The stream
+  draws states uniformly from num_registrations / 2 distinct states whose
+  bins only use the lowest 12 bits (as typical for packed states, where most
+  bits of a bin are constant), so about 43% of the registrations are new
+  states. We compare feeding the bins to utils::HashState one by one with
+  utils::get_array_hash64.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../algorithms/int_hash_set.h"
+#include "../utils/hash.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using Bin = std::uint32_t;
+
+auto splitmix64(std::uint64_t x) -> std::uint64_t {
+	x += 0x9E3779B97F4A7C15ULL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+}
+
+struct StatePool {
+	const std::size_t bins_per_state;
+	std::vector<Bin> data;
+
+	explicit StatePool(std::size_t bins_per_state) : bins_per_state(bins_per_state) {}
+
+	auto operator[](int_hash_set::KeyType id) const -> const Bin * { return data.data() + id * bins_per_state; }
+	auto size() const -> int_hash_set::KeyType { return data.size() / bins_per_state; }
+};
+
+struct HashStateHash {
+	const StatePool &pool;
+
+	auto operator()(int_hash_set::KeyType id) const -> int_hash_set::HashType {
+		const auto *data = pool[id];
+		auto hash_state = utils::HashState();
+		for (std::size_t i = 0; i < pool.bins_per_state; ++i)
+			utils::feed(hash_state, data[i]);
+		return int_hash_set::get_hash(hash_state);
+	}
+};
+
+struct ArrayHash {
+	const StatePool &pool;
+
+	auto operator()(int_hash_set::KeyType id) const -> int_hash_set::HashType {
+		return int_hash_set::get_hash(utils::get_array_hash64(pool[id], pool.bins_per_state));
+	}
+};
+
+struct StateEqual {
+	const StatePool &pool;
+
+	auto operator()(int_hash_set::KeyType lhs, int_hash_set::KeyType rhs) const -> bool {
+		return std::equal(pool[lhs], pool[lhs] + pool.bins_per_state, pool[rhs]);
+	}
+};
+
+template<typename Hash>
+auto run(const std::string &name, const std::vector<Bin> &stream, std::size_t stream_length, std::size_t num_registrations, std::size_t bins_per_state) -> int_hash_set::KeyType {
+	auto pool = StatePool(bins_per_state);
+	auto registered_states = int_hash_set::IntHashSet<Hash, StateEqual>(Hash{pool}, StateEqual{pool});
+	const auto start = Clock::now();
+	for (std::size_t i = 0; i < num_registrations; ++i) {
+		const auto *state = &stream[(i % stream_length) * bins_per_state];
+		pool.data.insert(pool.data.end(), state, state + bins_per_state);
+		if (!registered_states.insert(pool.size() - 1).second)
+			pool.data.resize(pool.data.size() - bins_per_state);
+	}
+	const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	std::cout << name << ": " << num_registrations / seconds / 1e6 << "M registrations/s ("
+	          << pool.size() << " distinct states)" << std::endl;
+	return pool.size();
+}
+} // namespace
+
+auto main(int argc, char **argv) -> int {
+	const auto num_registrations = argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : std::size_t{10000000};
+	const auto bins_per_state = argc > 2 ? static_cast<std::size_t>(std::stoull(argv[2])) : std::size_t{4};
+	/*
+	  The stream is precomputed (and repeated if it would need more than 256
+	  MiB) so that generating it is not part of the measurement.
+	*/
+	const auto num_distinct_states = std::max<std::uint64_t>(num_registrations / 2, 1);
+	const auto stream_length = std::min(num_registrations, std::max<std::size_t>((std::size_t{1} << 26) / bins_per_state, 1));
+	auto stream = std::vector<Bin>(stream_length * bins_per_state);
+	for (std::size_t i = 0; i < stream_length; ++i) {
+		const auto state = splitmix64(i) % num_distinct_states;
+		for (std::size_t bin = 0; bin < bins_per_state; ++bin)
+			stream[i * bins_per_state + bin] = static_cast<Bin>(splitmix64(state * bins_per_state + bin) & 0xfff);
+	}
+	const auto num_states_hash_state = run<HashStateHash>("HashState       ", stream, stream_length, num_registrations, bins_per_state);
+	const auto num_states_array_hash = run<ArrayHash>("get_array_hash64", stream, stream_length, num_registrations, bins_per_state);
+	if (num_states_hash_state != num_states_array_hash) {
+		std::cerr << "different numbers of distinct states" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
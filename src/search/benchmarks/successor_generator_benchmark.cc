@@ -0,0 +1,100 @@
+/*
+  Applicable operators per second of the successor generator backends.
+
+  Usage: successor_generator_benchmark [number of states] [passes] < output.sas
+
+  The states are the first registered states of a breadth-first search from
+  the initial state of the task (for unit-cost tasks, these are the states
+  that blind A* generates first). Each backend computes the applicable
+  operators of all states in every pass; we report states/s and operators/s
+  over all passes. The operators of every backend are compared with those
+  of the TREE backend, which must be the same in the same order.
+
+  Unlike the other benchmarks, this one needs the task representation, so it
+  is built from the sources of the planner.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../operator_id.h"
+#include "../state_registry.h"
+#include "../task_proxy.h"
+#include "../task_utils/successor_generator.h"
+#include "../tasks/root_task.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using successor_generator::Backend;
+
+auto collect_states(const TaskProxy &task_proxy, StateRegistry &registry, std::size_t num_states) -> std::vector<GlobalState> {
+	const auto generator = successor_generator::SuccessorGenerator(task_proxy);
+	auto states = std::vector<GlobalState>{registry.get_initial_state()};
+	auto applicable_ops = std::vector<OperatorID>();
+	// the registered states in order of registration are a breadth-first search queue
+	for (std::size_t next = 0; next < states.size() && states.size() < num_states; ++next) {
+		applicable_ops.clear();
+		generator.generate_applicable_ops(states[next], applicable_ops);
+		for (const auto op_id : applicable_ops) {
+			const auto old_size = registry.size();
+			auto successor = registry.get_successor_state(states[next], task_proxy.get_operators()[op_id]);
+			if (registry.size() > old_size)
+				states.push_back(std::move(successor));
+			if (states.size() == num_states)
+				break;
+		}
+	}
+	return states;
+}
+
+void run(const std::string &name, const TaskProxy &task_proxy, Backend backend, const std::vector<GlobalState> &states, int passes,
+         const std::vector<std::vector<OperatorID>> &expected_ops) {
+	const auto generator = successor_generator::SuccessorGenerator(task_proxy, backend);
+	auto applicable_ops = std::vector<OperatorID>();
+	auto num_mismatches = 0;
+	for (std::size_t i = 0; i < states.size(); ++i) {
+		applicable_ops.clear();
+		generator.generate_applicable_ops(states[i], applicable_ops);
+		if (applicable_ops != expected_ops[i])
+			++num_mismatches;
+	}
+
+	auto num_ops = 0ll;
+	const auto start = Clock::now();
+	for (auto pass = 0; pass < passes; ++pass) {
+		for (const auto &state : states) {
+			applicable_ops.clear();
+			generator.generate_applicable_ops(state, applicable_ops);
+			num_ops += applicable_ops.size();
+		}
+	}
+	const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	std::cout << name << ": " << passes * states.size() / seconds << " states/s, " << num_ops / seconds << " ops/s [" << num_mismatches
+	          << " mismatches]" << std::endl;
+}
+} // namespace
+
+auto main(int argc, char **argv) -> int {
+	const auto num_states = argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : std::size_t{300000};
+	const auto passes = argc > 2 ? std::stoi(argv[2]) : 10;
+
+	tasks::read_root_task(std::cin);
+	const auto task_proxy = TaskProxy(*tasks::g_root_task);
+	auto registry = StateRegistry(task_proxy);
+	const auto states = collect_states(task_proxy, registry, num_states);
+	std::cout << states.size() << " states, " << task_proxy.get_operators().size() << " operators, " << registry.get_bins_per_state()
+	          << " bins per state" << std::endl;
+
+	const auto tree = successor_generator::SuccessorGenerator(task_proxy);
+	auto expected_ops = std::vector<std::vector<OperatorID>>(states.size());
+	for (std::size_t i = 0; i < states.size(); ++i)
+		tree.generate_applicable_ops(states[i], expected_ops[i]);
+
+	run("TREE              ", task_proxy, Backend::TREE, states, passes, expected_ops);
+	run("FLAT              ", task_proxy, Backend::FLAT, states, passes, expected_ops);
+	run("PRECONDITION_MASKS", task_proxy, Backend::PRECONDITION_MASKS, states, passes, expected_ops);
+	return 0;
+}
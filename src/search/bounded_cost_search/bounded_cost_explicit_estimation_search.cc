@@ -41,7 +41,6 @@ BoundedCostExplicitEstimationSearch<N>::BoundedCostExplicitEstimationSearch(cons
 template <std::size_t N>
 void BoundedCostExplicitEstimationSearch<N>::insert(EvaluationContext &eval_context, const EvaluatorValues &evaluator_values, StateID state_id, bool preferred) {
 	EagerBoundedCostSearch<N>::insert(eval_context, evaluator_values, state_id, preferred);
-	assert(!eval_context.get_calculate_preferred());
 	const auto f_hat_value = f_hat_evaluator->compute_result(eval_context);
 	if (f_hat_value <= EagerBoundedCostSearch<N>::bound) {
 		const auto d_hat_value = d_hat_evaluator->compute_result(eval_context);
@@ -183,7 +182,6 @@ template <std::size_t N>
 void BoundedCostExplicitEstimationPercentileSearch<N>::insert(EvaluationContext &eval_context, const EvaluatorValues &evaluator_values, StateID state_id,
                                                               bool preferred) {
 	EagerBoundedCostSearch<N>::insert(eval_context, evaluator_values, state_id, preferred);
-	assert(!eval_context.get_calculate_preferred());
 	const auto probability_value = probability_evaluator->compute_result(eval_context);
 	if (probability_value >= focal_threshold) {
 		const auto d_hat_value = d_hat_evaluator->compute_result(eval_context);
@@ -200,6 +198,7 @@ static auto _parse_pbees(OptionParser &parser) -> std::shared_ptr<SearchEngine>
 	add_bounded_cost_warm_start_options(parser);
 	add_percentage_based_error_option(parser);
 	add_online_variance_option(parser);
+	add_normal_cdf_option(parser);
 	add_d_tie_breaking_option(parser);
 	bounded_cost_search::add_options_to_parser(parser);
 
@@ -233,6 +232,7 @@ static auto _parse_pbees(OptionParser &parser) -> std::shared_ptr<SearchEngine>
 
 	auto nancy_assumptions_opts = options::Options();
 	nancy_assumptions_opts.set("cache_estimates", false);
+	nancy_assumptions_opts.set<NormalCDFMethod>("normal_cdf", opts.get<NormalCDFMethod>("normal_cdf"));
 	nancy_assumptions_opts.set("cost_bound", opts.get<int>("bound"));
 	nancy_assumptions_opts.set<std::shared_ptr<Evaluator>>("f", f_evaluator);
 	nancy_assumptions_opts.set<std::shared_ptr<FloatingPointEvaluator>>("f_hat", f_hat_evaluator);
@@ -274,6 +274,7 @@ static auto _parse_pbeeps(OptionParser &parser) -> std::shared_ptr<SearchEngine>
 	add_bounded_cost_warm_start_options(parser);
 	add_percentage_based_error_option(parser);
 	add_online_variance_option(parser);
+	add_normal_cdf_option(parser);
 	add_d_tie_breaking_option(parser);
 	bounded_cost_search::add_options_to_parser(parser);
 
@@ -313,6 +314,7 @@ static auto _parse_pbeeps(OptionParser &parser) -> std::shared_ptr<SearchEngine>
 
 	auto nancy_assumptions_opts = options::Options();
 	nancy_assumptions_opts.set("cache_estimates", false);
+	nancy_assumptions_opts.set<NormalCDFMethod>("normal_cdf", opts.get<NormalCDFMethod>("normal_cdf"));
 	nancy_assumptions_opts.set("cost_bound", opts.get<int>("bound"));
 	nancy_assumptions_opts.set<std::shared_ptr<Evaluator>>("f", f_evaluator);
 	nancy_assumptions_opts.set<std::shared_ptr<FloatingPointEvaluator>>("f_hat", f_hat_evaluator);
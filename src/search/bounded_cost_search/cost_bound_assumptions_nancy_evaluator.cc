@@ -5,19 +5,17 @@
 #include "../evaluation_context.h"
 #include "../option_parser.h"
 #include "../plugin.h"
+#include "../suboptimal_search/util.h"
 
 namespace bounded_cost_search {
-auto NancyAssumptionsCBSEvaluator::cumulative_distribution(double x) -> double {
-	return (1 + std::erf(x / std::sqrt(2.))) / 2.;
-}
-
 NancyAssumptionsCBSEvaluator::NancyAssumptionsCBSEvaluator(const options::Options &opts)
 	: floating_point_evaluator::FloatingPointEvaluator(opts),
 	  cost_bound(opts.get<int>("cost_bound")),
 	  f_evaluator(opts.get<std::shared_ptr<Evaluator>>("f")),
 	  f_hat_evaluator(opts.get<std::shared_ptr<floating_point_evaluator::FloatingPointEvaluator>>("f_hat")),
 	  d_hat_evaluator(opts.get<std::shared_ptr<floating_point_evaluator::FloatingPointEvaluator>>("d_hat", nullptr)),
-	  heuristic_error(opts.get<std::shared_ptr<heuristic_error::HeuristicError>>("heuristic_error", nullptr)) {}
+	  heuristic_error(opts.get<std::shared_ptr<heuristic_error::HeuristicError>>("heuristic_error", nullptr)),
+	  normal_cdf_method(opts.get<suboptimal_search::NormalCDFMethod>("normal_cdf", suboptimal_search::NormalCDFMethod::ERF)) {}
 
 auto NancyAssumptionsCBSEvaluator::compute_value(EvaluationContext &eval_context) -> double {
 	if (eval_context.is_evaluator_value_infinite(f_evaluator.get()))
@@ -51,8 +49,8 @@ auto NancyAssumptionsCBSEvaluator::compute_value(EvaluationContext &eval_context
 	assert(standard_deviation >= 0.);
 	if (standard_deviation == 0.)
 		return mean <= cost_bound + .5 ? 1. : 0.;
-	const auto cdf_xi = cumulative_distribution((cost_bound + .5 - mean) / standard_deviation);
-	const auto cdf_alpha = cumulative_distribution((lower_bound - mean) / standard_deviation);
+	const auto cdf_xi = suboptimal_search::normal_cdf((cost_bound + .5 - mean) / standard_deviation, normal_cdf_method);
+	const auto cdf_alpha = suboptimal_search::normal_cdf((lower_bound - mean) / standard_deviation, normal_cdf_method);
 #ifndef NDEBUG
 	const auto is_valid_probility = [](double p) {
 		return p >= 0. && p <= 1.;
@@ -71,6 +69,7 @@ static auto _parse(OptionParser &parser) -> std::shared_ptr<floating_point_evalu
 	parser.add_option<std::shared_ptr<Evaluator>>("f", "f evaluator");
 	parser.add_option<std::shared_ptr<floating_point_evaluator::FloatingPointEvaluator>>("f_hat", "f-hat evaluator");
 	parser.add_option<std::shared_ptr<heuristic_error::HeuristicError>>("heuristic_error", "heuristic error observer from which to read the variance");
+	suboptimal_search::add_normal_cdf_option(parser);
 	Options opts = parser.parse();
 	if (parser.dry_run() || parser.help_mode())
 		return nullptr;
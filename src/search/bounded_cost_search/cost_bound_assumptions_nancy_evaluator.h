@@ -3,6 +3,7 @@
 
 #include "../floating_point_evaluator/floating_point_evaluator.h"
 #include "../heuristic_error/heuristic_error.h"
+#include "../suboptimal_search/normal_distribution.h"
 
 class Evaluator;
 
@@ -14,8 +15,7 @@ protected:
 	const std::shared_ptr<floating_point_evaluator::FloatingPointEvaluator> f_hat_evaluator;
 	const std::shared_ptr<floating_point_evaluator::FloatingPointEvaluator> d_hat_evaluator;
 	const std::shared_ptr<heuristic_error::HeuristicError> heuristic_error;
-
-	static auto cumulative_distribution(double x) -> double;
+	const suboptimal_search::NormalCDFMethod normal_cdf_method;
 
 	auto compute_value(EvaluationContext &eval_context) -> double override;
 
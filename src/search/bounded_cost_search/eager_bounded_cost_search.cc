@@ -34,15 +34,38 @@ auto EagerBoundedCostSearch<N>::create_open_list(const options::Options &opts, O
 	return std::make_unique<AlternationOpenList<N, StateID>>(opts.get<int>("boost"), std::move(sublists), std::move(preferred_sublists));
 }
 
+// the heap options are optional: only some engines based on EagerBoundedCostSearch expose them
 template <std::size_t N>
-EagerBoundedCostSearch<N>::EagerBoundedCostSearch(const Options &opts) : EagerBoundedCostSearch(opts, create_best_first_open_list) {}
+auto EagerBoundedCostSearch<N>::get_default_open_list_creation_function(const Options &opts) -> OpenListCreationFunction {
+	const auto heap_type = opts.get<HeapType>("heap", HeapType::BINARY);
+	const auto compress_primary_key = opts.get<bool>("compress_primary_key", false);
+	return [heap_type, compress_primary_key]() { return floating_point_open_list::create_best_first_open_list<N, StateID>(heap_type, compress_primary_key); };
+}
+
+// the open lists cannot be moved, so the variant is always constructed (unused variants hold an empty binary heap)
+template <std::size_t N>
+static auto create_default_open_list_variant(const Options &opts, bool use_best_first_open_list) -> BestFirstOpenListVariant<N, StateID> {
+	if (!use_best_first_open_list)
+		return BestFirstOpenListVariant<N, StateID>();
+	return create_best_first_open_list_variant<N, StateID>(opts.get<HeapType>("heap", HeapType::BINARY), opts.get<bool>("compress_primary_key", false));
+}
+
+template <std::size_t N>
+EagerBoundedCostSearch<N>::EagerBoundedCostSearch(const Options &opts)
+	: EagerBoundedCostSearch(opts, get_default_open_list_creation_function(opts), opts.get_list<std::shared_ptr<Evaluator>>("preferred").empty()) {}
 
 template <std::size_t N>
 EagerBoundedCostSearch<N>::EagerBoundedCostSearch(const Options &opts, OpenListCreationFunction create_default_open_list)
+	: EagerBoundedCostSearch(opts, create_default_open_list, false) {}
+
+template <std::size_t N>
+EagerBoundedCostSearch<N>::EagerBoundedCostSearch(const Options &opts, OpenListCreationFunction create_default_open_list, bool use_best_first_open_list)
 	: suboptimal_search::EagerSuboptimalSearch<N>(opts),
 	  initialize_error_with_cost_bound(opts.get<bool>("initialize_error_with_cost_bound")),
 	  distance_evaluator(opts.get<std::shared_ptr<Evaluator>>("distance", nullptr)),
-	  open_list(create_open_list(opts, create_default_open_list)) {}
+	  open_list(use_best_first_open_list ? nullptr : create_open_list(opts, create_default_open_list)),
+	  use_best_first_open_list(use_best_first_open_list),
+	  best_first_open_list(create_default_open_list_variant<N>(opts, use_best_first_open_list)) {}
 
 template <std::size_t N>
 void EagerBoundedCostSearch<N>::initialize_heuristic_error(EvaluationContext &eval_context) {
@@ -59,12 +82,20 @@ void EagerBoundedCostSearch<N>::initialize_heuristic_error(EvaluationContext &ev
 
 template <std::size_t N>
 auto EagerBoundedCostSearch<N>::fetch_next_node() -> std::optional<SearchNode> {
+	if (use_best_first_open_list)
+		return std::visit([this](auto &list) { return fetch_next_node(list); }, best_first_open_list);
+	return fetch_next_node(*open_list);
+}
+
+template <std::size_t N>
+template <class OpenList>
+auto EagerBoundedCostSearch<N>::fetch_next_node(OpenList &open_list) -> std::optional<SearchNode> {
 	auto node = std::optional<SearchNode>();
 	while (true) {
-		if (open_list->empty())
+		if (open_list.empty())
 			break;
-		auto id = open_list->top();
-		open_list->pop();
+		auto id = open_list.top();
+		open_list.pop();
 		// TODO is there a way we can avoid creating the state here and then
 		//      recreate it outside of this function with node.get_state()?
 		//      One way would be to store GlobalState objects inside SearchNodes
@@ -85,14 +116,18 @@ auto EagerBoundedCostSearch<N>::fetch_next_node() -> std::optional<SearchNode> {
 
 template <std::size_t N>
 void EagerBoundedCostSearch<N>::insert(EvaluationContext &, const EvaluatorValues &evaluator_values, StateID state_id, bool preferred) {
-	open_list->push(evaluator_values, state_id, preferred);
+	if (use_best_first_open_list)
+		std::visit([&](auto &list) { list.push(evaluator_values, state_id, preferred); }, best_first_open_list);
+	else
+		open_list->push(evaluator_values, state_id, preferred);
 }
 
 template <std::size_t N>
 void EagerBoundedCostSearch<N>::reward_progress() {
 	// Boost the "preferred operator" open lists somewhat whenever
 	// one of the heuristics finds a state with a new best h value.
-	open_list->boost_preferred();
+	if (open_list)
+		open_list->boost_preferred();
 }
 
 void add_options_to_parser(OptionParser &parser) {
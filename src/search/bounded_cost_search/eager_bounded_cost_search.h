@@ -2,6 +2,7 @@
 #define BOUNDED_COST_SEARCH_EAGER_BOUNDED_COST_SEARCH_H
 
 #include "../floating_point_open_list/floating_point_open_list.h"
+#include "../floating_point_open_list/heap_type.h"
 #include "../suboptimal_search/eager_suboptimal_search.h"
 
 namespace bounded_cost_search {
@@ -15,6 +16,9 @@ class EagerBoundedCostSearch : public suboptimal_search::EagerSuboptimalSearch<N
 
 	void reward_progress() override;
 
+	template <class OpenList>
+	auto fetch_next_node(OpenList &open_list) -> std::optional<SearchNode>;
+
 protected:
 	using typename suboptimal_search::EagerSuboptimalSearch<N>::EvaluatorValues;
 	
@@ -32,15 +36,27 @@ protected:
 	using OpenListType = floating_point_open_list::FloatingPointOpenList<N, StateID>;
 	using OpenListCreationFunction = std::function<std::unique_ptr<OpenListType>()>;
 	static const OpenListCreationFunction create_best_first_open_list;
+	static auto get_default_open_list_creation_function(const options::Options &opts) -> OpenListCreationFunction;
 	static auto create_open_list(const options::Options &opts, OpenListCreationFunction create_default_open_list = create_best_first_open_list)
 			-> std::unique_ptr<OpenListType>;
 
+	// null if best_first_open_list is used
 	std::unique_ptr<OpenListType> open_list;
 
+private:
+	// without preferred operators, the default best-first open list is held by value (with the heap selected at runtime) to keep the calls non-virtual
+	const bool use_best_first_open_list;
+	floating_point_open_list::BestFirstOpenListVariant<N, StateID> best_first_open_list;
+
+	EagerBoundedCostSearch(const options::Options &opts, OpenListCreationFunction create_default_open_list, bool use_best_first_open_list);
+
 public:
 	explicit EagerBoundedCostSearch(const options::Options &opts);
 	EagerBoundedCostSearch(const options::Options &opts, OpenListCreationFunction create_default_open_list);
 	virtual ~EagerBoundedCostSearch() = default;
+
+	// the order of expansions does not affect the bound of the plans, so the search can be distributed
+	auto supports_distribution() const -> bool override { return true; }
 };
 
 extern void add_options_to_parser(options::OptionParser &parser);
@@ -0,0 +1,192 @@
+#include "hash_distributed_search.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+#include "../option_parser.h"
+#include "../plugin.h"
+#include "../utils/logging.h"
+#include "../utils/system.h"
+#include "../utils/timer.h"
+
+namespace bounded_cost_search {
+HashDistributedSearch::HashDistributedSearch(const options::Options &opts, options::Registry &registry)
+	: SearchEngine(opts),
+	  engine_config(opts.get<options::ParseTree>("engine_config")),
+	  num_threads(opts.get<int>("threads")),
+	  registry(registry),
+	  exchange(num_threads, opts.get<int>("batch_size"), opts.get<int>("error_synchronization_interval"), opts.get<int>("error_snapshot_interval")),
+	  shards(num_threads),
+	  distributable_shards(num_threads, nullptr),
+	  shard_search_times(num_threads, 0),
+	  num_constructed(0),
+	  num_finished(0),
+	  winner(-1),
+	  shard_stopped_early(false),
+	  stopping(false) {}
+
+void HashDistributedSearch::run_shard(int index) {
+	auto engine = std::shared_ptr<SearchEngine>();
+	{
+		// construct and connect the shards one after the other (see ParallelPortfolioSearch)
+		auto lock = std::unique_lock<std::mutex>(shards_mutex);
+		auto parser = options::OptionParser(engine_config, registry, no_predefinitions, false);
+		engine = parser.start_parsing<std::shared_ptr<SearchEngine>>();
+		auto distributable_shard = dynamic_cast<suboptimal_search::DistributableSearch *>(engine.get());
+		if (!distributable_shard || !distributable_shard->supports_distribution()) {
+			std::cerr << "Hash-distributed search only supports bounded-cost search engines, exiting." << std::endl;
+			utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+		}
+		if (engine->uses_delta_encoding()) {
+			std::cerr << "Hash-distributed search does not support delta-encoded state registries, exiting." << std::endl;
+			utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+		}
+		engine->set_bound(std::min(engine->get_bound(), bound));
+		distributable_shard->connect(exchange, index);
+		shards[index] = engine;
+		distributable_shards[index] = distributable_shard;
+
+		++num_constructed;
+		state_changed.notify_all();
+		state_changed.wait(lock, [&]() { return num_constructed == num_threads || stopping; });
+		if (stopping)
+			engine->interrupt();
+	}
+
+	auto search_timer = utils::Timer();
+	engine->search();
+	search_timer.stop();
+
+	{
+		auto lock = std::lock_guard<std::mutex>(shards_mutex);
+		shard_search_times[index] = search_timer();
+		++num_finished;
+		const auto status = engine->get_status();
+		if (winner == -1 && status == SOLVED) {
+			winner = index;
+		} else if (status != SOLVED && status != FAILED && !stopping) {
+			// the shard stopped early (e.g., because of its own time limit), so the others would wait for its states forever
+			utils::g_log << "Shard " << index << " stopped early, stopping all shards." << std::endl;
+			shard_stopped_early = true;
+			stop_shards();
+		}
+	}
+	state_changed.notify_all();
+}
+
+void HashDistributedSearch::stop_shards() {
+	stopping = true;
+	for (const auto &shard : shards)
+		if (shard)
+			shard->interrupt();
+	state_changed.notify_all();
+}
+
+auto HashDistributedSearch::trace_plan() -> Plan {
+	auto plan = Plan();
+	auto shard = winner;
+	auto state_id = distributable_shards[winner]->get_goal_state_id();
+	while (true) {
+		auto creating_operator = OperatorID::no_operator;
+		auto parent_shard = -1;
+		auto parent_id = StateID::no_state;
+		distributable_shards[shard]->trace_step(state_id, creating_operator, parent_shard, parent_id);
+		if (creating_operator == OperatorID::no_operator) {
+			assert(parent_id == StateID::no_state);
+			break;
+		}
+		plan.push_back(creating_operator);
+		shard = parent_shard;
+		state_id = parent_id;
+	}
+	std::reverse(std::begin(plan), std::end(plan));
+	return plan;
+}
+
+auto HashDistributedSearch::step() -> SearchStatus {
+	auto threads = std::vector<std::thread>();
+	threads.reserve(num_threads);
+	for (auto i = 0; i < num_threads; ++i)
+		threads.emplace_back(&HashDistributedSearch::run_shard, this, i);
+
+	auto timed_out = false;
+	{
+		auto lock = std::unique_lock<std::mutex>(shards_mutex);
+		// the shards finish together unless one of them finds a plan
+		const auto done = [&]() { return winner != -1 || num_finished == num_threads; };
+		if (std::isinf(max_time))
+			state_changed.wait(lock, done);
+		else
+			timed_out = !state_changed.wait_for(lock, std::chrono::duration<double>(max_time), done);
+		stop_shards();
+	}
+	for (auto &thread : threads)
+		thread.join();
+
+	for (const auto &shard : shards) {
+		const auto &shard_statistics = shard->get_statistics();
+		statistics.inc_expanded(shard_statistics.get_expanded());
+		statistics.inc_evaluated_states(shard_statistics.get_evaluated_states());
+		statistics.inc_evaluations(shard_statistics.get_evaluations());
+		statistics.inc_generated(shard_statistics.get_generated());
+		statistics.inc_generated_ops(shard_statistics.get_generated_ops());
+		statistics.inc_reopened(shard_statistics.get_reopened());
+	}
+
+	if (winner != -1) {
+		utils::g_log << "Shard " << winner << " found a plan." << std::endl;
+		set_plan(trace_plan());
+		return SOLVED;
+	}
+	return timed_out || shard_stopped_early ? TIMEOUT : FAILED;
+}
+
+void HashDistributedSearch::print_statistics() const {
+	for (auto i = 0; i < num_threads; ++i) {
+		utils::g_log << "Statistics of shard " << i << " (search time " << shard_search_times[i] << "s):" << std::endl;
+		shards[i]->print_statistics();
+	}
+	utils::g_log << "Cumulative statistics:" << std::endl;
+	statistics.print_detailed_statistics();
+}
+
+static auto _parse(options::OptionParser &parser) -> std::shared_ptr<SearchEngine> {
+	parser.document_synopsis("Hash-distributed bounded-cost search",
+	                         "Runs a bounded-cost search engine (such as xes or pts) in several threads. Each state is owned by one thread according "
+	                         "to its hash, and generated states are sent to their owner, which detects duplicates, evaluates and expands them "
+	                         "(hash distributed A*, Kishimoto, Fukunaga, and Botea, 2009). Each thread has its own state registry, search space, open "
+	                         "list and heuristic error models, whose statistics are merged regularly. The search stops as soon as one thread expands "
+	                         "a goal state, so the expansion order is only approximately best-first, which is sufficient for bounded-cost search.");
+	parser.document_note("Evaluators",
+	                     "Evaluators are not thread-safe, so predefined evaluators (--evaluator) cannot be used in the engine configuration "
+	                     "(see parallel_portfolio), for example\n```\n--search \"hda(xes(lmcut(), lmcut(), bound=100), threads=4)\"\n```");
+	parser.add_option<options::ParseTree>("engine_config", "bounded-cost search engine to run in each thread");
+	parser.add_option<int>("threads", "number of threads", "2", options::Bounds("1", "infinity"));
+	parser.add_option<int>("batch_size", "number of states sent to another thread at once (smaller batches are sent regularly and when a thread runs idle)",
+	                       "32", options::Bounds("1", "infinity"));
+	parser.add_option<int>("error_synchronization_interval", "number of expansions of a thread after which its heuristic error statistics are merged with "
+	                       "those of the other threads", "64", options::Bounds("1", "infinity"));
+	parser.add_option<int>("error_snapshot_interval",
+	                       "only update the heuristic error seen by the evaluators of a thread once it misses this many samples (of any thread), so that "
+	                       "evaluator values are stable in between (1 updates it after every sample and synchronization)",
+	                       "1", options::Bounds("1", "infinity"));
+	SearchEngine::add_options_to_parser(parser);
+	auto opts = parser.parse();
+
+	if (parser.help_mode()) {
+		return nullptr;
+	} else if (parser.dry_run()) {
+		// check if the supplied search engine can be parsed
+		auto test_parser = options::OptionParser(opts.get<options::ParseTree>("engine_config"), parser.get_registry(), options::Predefinitions(), true);
+		test_parser.start_parsing<std::shared_ptr<SearchEngine>>();
+		return nullptr;
+	} else {
+		return std::make_shared<HashDistributedSearch>(opts, parser.get_registry());
+	}
+}
+
+static options::Plugin<SearchEngine> _plugin("hda", _parse);
+} // namespace bounded_cost_search
@@ -0,0 +1,63 @@
+#ifndef BOUNDED_COST_SEARCH_HASH_DISTRIBUTED_SEARCH_H
+#define BOUNDED_COST_SEARCH_HASH_DISTRIBUTED_SEARCH_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../option_parser_util.h"
+#include "../options/predefinitions.h"
+#include "../options/registries.h"
+#include "../search_engine.h"
+#include "../suboptimal_search/state_exchange.h"
+
+namespace options {
+class Options;
+}
+
+namespace bounded_cost_search {
+/*
+  Runs a bounded-cost search in several threads, each of which searches the
+  states it owns according to their hash (see suboptimal_search/state_exchange.h).
+  Every thread parses the configuration of the search on its own, so the
+  threads share no evaluators or heuristic error models; only the statistics
+  of the error models are merged regularly. The first plan that any thread
+  finds is returned.
+*/
+class HashDistributedSearch : public SearchEngine {
+	const options::ParseTree engine_config;
+	const int num_threads;
+	// Copied for the same reason as in IteratedSearch.
+	options::Registry registry;
+	// Evaluators must not be shared between threads (see ParallelPortfolioSearch).
+	const options::Predefinitions no_predefinitions;
+
+	suboptimal_search::StateExchange exchange;
+	std::vector<std::shared_ptr<SearchEngine>> shards;
+	std::vector<suboptimal_search::DistributableSearch *> distributable_shards;
+	std::vector<double> shard_search_times;
+
+	// Protects all of the following members and the entries of shards.
+	std::mutex shards_mutex;
+	std::condition_variable state_changed;
+	int num_constructed;
+	int num_finished;
+	int winner;
+	bool shard_stopped_early;
+	bool stopping;
+
+	void run_shard(int index);
+	void stop_shards();
+	auto trace_plan() -> Plan;
+
+	auto step() -> SearchStatus override;
+
+public:
+	HashDistributedSearch(const options::Options &opts, options::Registry &registry);
+
+	void print_statistics() const override;
+};
+} // namespace bounded_cost_search
+
+#endif
@@ -23,7 +23,9 @@ static std::shared_ptr<SearchEngine> _parse(options::OptionParser &parser) {
 	add_bounded_cost_warm_start_options(parser);
 	add_percentage_based_error_option(parser);
 	add_online_variance_option(parser);
+	add_normal_cdf_option(parser);
 	add_f_hat_then_d_tie_breaking_option(parser);
+	add_open_list_heap_options(parser);
 	add_options_to_parser(parser);
 
 	auto opts = parser.parse();
@@ -57,6 +59,7 @@ static std::shared_ptr<SearchEngine> _parse(options::OptionParser &parser) {
 
 	auto nancy_assumptions_opts = options::Options();
 	nancy_assumptions_opts.set("cache_estimates", false);
+	nancy_assumptions_opts.set<NormalCDFMethod>("normal_cdf", opts.get<NormalCDFMethod>("normal_cdf"));
 	nancy_assumptions_opts.set("cost_bound", opts.get<int>("bound"));
 	nancy_assumptions_opts.set<std::shared_ptr<Evaluator>>("f", f_evaluator);
 	nancy_assumptions_opts.set<std::shared_ptr<FloatingPointEvaluator>>("f_hat", f_hat_evaluator);
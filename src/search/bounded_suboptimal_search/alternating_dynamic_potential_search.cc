@@ -42,43 +42,25 @@ AlternatingDynamicPotentialSearch::AlternatingDynamicPotentialSearch(const Optio
 
 auto AlternatingDynamicPotentialSearch::fetch_next_node() -> std::optional<SearchNode> {
 	// remove closed nodes from the front of the open list
-	while (true) {
-		if (f_list.empty())
-			return {};
-		auto &state_ids = std::begin(f_list)->second;
-		const auto id = state_ids.front().second;
-		const auto s = state_registry.lookup_state(id);
-		const auto node = search_space.get_node(s);
-		if (!node.is_closed())
-			break;
-		std::pop_heap(std::begin(state_ids), std::end(state_ids), f_list_compare);
-		state_ids.pop_back();
-		if (state_ids.empty())
-			f_list.erase(std::begin(f_list));
-	}
-
-	assert(!f_list.empty());
-	assert(!std::begin(f_list)->second.empty());
-	const auto current_f_min = std::begin(f_list)->first;
+	f_list.prune_top([this](const auto &entry) { return search_space.get_node(state_registry.lookup_state(entry.second)).is_closed(); });
+	if (f_list.empty())
+		return {};
+	const auto current_f_min = f_list.get_min_f();
 
 	// update f_min if necessary
 	if (current_f_min > f_min) {
 		// f_min increased --> fix f-hat list by copying all nodes that were previously
 		// outside the bound (i.e. suboptimality factor * current_f_min) and are now
 		// inside it (i.e. suboptimality_factor * f_min)
-		const auto lower = f_list.upper_bound(suboptimality_factor * f_min);
-		const auto upper = f_list.upper_bound(suboptimality_factor * current_f_min);
-		for (auto it = lower; it != upper; ++it) {
-			for (auto [_, state_id] : it->second) {
-				const auto state = state_registry.lookup_state(state_id);
-				const auto node = search_space.get_node(state);
-				if (node.is_closed())
-					continue;
-				auto eval_context = EvaluationContext(state, node.get_g(), false, &statistics);
-				const auto f_hat = f_hat_evaluator->compute_result(eval_context);
-				f_hat_list.push({f_hat}, state_id, eval_context.is_preferred());
-			}
-		}
+		f_list.for_each_in_range(suboptimality_factor * f_min, suboptimality_factor * current_f_min, [this](const auto &entry) {
+			const auto state = state_registry.lookup_state(entry.second);
+			const auto node = search_space.get_node(state);
+			if (node.is_closed())
+				return;
+			auto eval_context = EvaluationContext(state, node.get_g(), false, &statistics);
+			const auto f_hat = f_hat_evaluator->compute_result(eval_context);
+			f_hat_list.push({f_hat}, entry.second, eval_context.is_preferred());
+		});
 		f_min = current_f_min;
 	}
 
@@ -124,12 +106,8 @@ auto AlternatingDynamicPotentialSearch::fetch_next_node() -> std::optional<Searc
 			break;
 		}
 		case 2: {
-			auto &state_ids = std::begin(f_list)->second;
-			id = state_ids.front().second;
-			std::pop_heap(std::begin(state_ids), std::end(state_ids), f_list_compare);
-			state_ids.pop_back();
-			if (state_ids.empty())
-				f_list.erase(std::begin(f_list));
+			id = f_list.top().second;
+			f_list.pop();
 			break;
 		}
 		default:
@@ -171,8 +149,7 @@ void AlternatingDynamicPotentialSearch::insert(EvaluationContext &eval_context)
 	const auto state_id = eval_context.get_state().get_id();
 	value_set_it->second->push_back(state_id);
 	const auto f = static_cast<double>(eval_context.get_evaluator_value(f_evaluator.get()));
-	f_list[f].emplace_back(eval_context.get_g_value(), state_id);
-	std::push_heap(std::begin(f_list[f]), std::end(f_list[f]), f_list_compare);
+	f_list.push(static_cast<int>(f), {eval_context.get_g_value(), state_id});
 
 	if (f <= suboptimality_factor * f_min) {
 		const auto f_hat = f_hat_evaluator->compute_result(eval_context);
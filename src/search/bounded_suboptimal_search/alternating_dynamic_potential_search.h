@@ -6,6 +6,7 @@
 #include <map>
 #include <optional>
 
+#include "../algorithms/f_bucket_open_list.h"
 #include "../floating_point_evaluator/floating_point_evaluator.h"
 #include "../floating_point_open_list/best_first_open_list.h"
 #include "../heuristic_error/heuristic_error.h"
@@ -49,13 +50,13 @@ class AlternatingDynamicPotentialSearch : public SearchEngine {
 	std::unordered_map<OpenListKey, OpenListValueSet, boost::hash<OpenListKey>> open_list_value_sets;
 	std::map<int, int> f_counts; // number of value sets (i.e. distinct (g, h) pairs) per f-value
 
+	struct FListCompare {
+		auto operator()(const std::pair<int, StateID> &lhs, const std::pair<int, StateID> &rhs) const -> bool { return lhs.first < rhs.first; }
+	};
+
 	// iterable bucket-based open list (ordered by f)
 	// each bucket is a heap sorted by high g
-	std::map<int, std::vector<std::pair<int, StateID>>> f_list;
-
-	static constexpr auto f_list_compare = [](const std::pair<int, StateID> &lhs, const std::pair<int, StateID> &rhs) {
-		return lhs.first < rhs.first;
-	};
+	f_bucket_open_list::FBucketOpenList<std::pair<int, StateID>, FListCompare> f_list;
 
 	floating_point_open_list::BestFirstOpenList<1, StateID> f_hat_list;
 
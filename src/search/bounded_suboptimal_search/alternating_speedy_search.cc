@@ -25,6 +25,8 @@ AlternatingSpeedySearch::AlternatingSpeedySearch(const Options &opts)
 	  reopen_closed_nodes(opts.get<bool>("reopen_closed")),
 	  suboptimality_factor(opts.get<double>("suboptimality_factor")),
 	  f_min(0),
+	  num_opened_nodes(0),
+	  compaction(opts),
 	  distance(opts.get<std::shared_ptr<Evaluator>>("distance")),
 	  heuristic(opts.get<std::shared_ptr<Evaluator>>("heuristic")),
 	  f_evaluator(std::make_shared<sum_evaluator::SumEvaluator>(std::vector<std::shared_ptr<Evaluator>>{std::make_shared<g_evaluator::GEvaluator>(), heuristic})),
@@ -41,47 +43,33 @@ AlternatingSpeedySearch::AlternatingSpeedySearch(const Options &opts)
 }
 
 auto AlternatingSpeedySearch::fetch_next_node() -> std::optional<SearchNode> {
-	// remove closed nodes from the front of the open list
-	while (true) {
-		if (f_list.empty())
-			return {};
-		auto &state_ids = std::begin(f_list)->second;
-		const auto id = state_ids.front().second;
-		const auto s = state_registry.lookup_state(id);
-		const auto node = search_space.get_node(s);
-		if (!node.is_closed())
-			break;
-		std::pop_heap(std::begin(state_ids), std::end(state_ids), f_list_compare);
-		state_ids.pop_back();
-		if (state_ids.empty())
-			f_list.erase(std::begin(f_list));
-	}
+	if (compaction.should_compact(f_list.size(), num_opened_nodes - statistics.get_expanded()))
+		compact_open_lists();
 
-	assert(!f_list.empty());
-	assert(!std::begin(f_list)->second.empty());
-	const auto current_f_min = std::begin(f_list)->first;
+	// remove closed nodes from the front of the open list
+	f_list.prune_top([this](const auto &entry) { return search_space.get_node(state_registry.lookup_state(entry.second)).is_closed(); });
+	if (f_list.empty())
+		return {};
+	const auto current_f_min = f_list.get_min_f();
 
 	// update f_min if necessary
 	if (current_f_min > f_min) {
 		// f_min increased --> fix d/f-hat lists by copying all nodes that were previously
 		// outside the bound (i.e. suboptimality factor * current_f_min) and are now
 		// inside it (i.e. suboptimality_factor * f_min)
-		const auto lower = f_list.upper_bound(suboptimality_factor * f_min);
-		const auto upper = f_list.upper_bound(suboptimality_factor * current_f_min);
-		for (auto it = lower; it != upper; ++it) {
-			for (auto [_, state_id] : it->second) {
-				const auto state = state_registry.lookup_state(state_id);
-				const auto node = search_space.get_node(state);
-				if (node.is_closed())
-					continue;
-				auto eval_context = EvaluationContext(state, node.get_g(), false, &statistics);
-				assert(!eval_context.is_evaluator_value_infinite(distance.get()));
-				const auto d = static_cast<double>(eval_context.get_evaluator_value(distance.get()));
-				d_list.emplace({d}, std::move(state_id), false);
-				const auto f_hat = f_hat_evaluator->compute_result(eval_context);
-				f_hat_list.push({f_hat}, state_id, eval_context.is_preferred());
-			}
-		}
+		f_list.for_each_in_range(suboptimality_factor * f_min, suboptimality_factor * current_f_min, [this](const auto &entry) {
+			const auto state_id = entry.second;
+			const auto state = state_registry.lookup_state(state_id);
+			const auto node = search_space.get_node(state);
+			if (node.is_closed())
+				return;
+			auto eval_context = EvaluationContext(state, node.get_g(), false, &statistics);
+			assert(!eval_context.is_evaluator_value_infinite(distance.get()));
+			const auto d = static_cast<double>(eval_context.get_evaluator_value(distance.get()));
+			d_list.push({d}, state_id, false);
+			const auto f_hat = f_hat_evaluator->compute_result(eval_context);
+			f_hat_list.push({f_hat}, state_id, eval_context.is_preferred());
+		});
 		f_min = current_f_min;
 	}
 
@@ -92,12 +80,8 @@ auto AlternatingSpeedySearch::fetch_next_node() -> std::optional<SearchNode> {
 
 		auto id = StateID::no_state;
 		if (statistics.get_expanded() % 3 == 2) {
-			auto &state_ids = std::begin(f_list)->second;
-			id = state_ids.front().second;
-			std::pop_heap(std::begin(state_ids), std::end(state_ids), f_list_compare);
-			state_ids.pop_back();
-			if (state_ids.empty())
-				f_list.erase(std::begin(f_list));
+			id = f_list.top().second;
+			f_list.pop();
 		} else {
 			auto &selected_open_list = statistics.get_expanded() % 3 == 0 ? d_list : f_hat_list;
 			assert(!selected_open_list.empty());
@@ -127,8 +111,7 @@ void AlternatingSpeedySearch::insert(EvaluationContext &eval_context) {
 	assert(!eval_context.is_evaluator_value_infinite(heuristic.get()));
 	const auto state_id = eval_context.get_state().get_id();
 	const auto f = static_cast<double>(eval_context.get_evaluator_value(f_evaluator.get()));
-	f_list[f].emplace_back(eval_context.get_g_value(), state_id);
-	std::push_heap(std::begin(f_list[f]), std::end(f_list[f]), f_list_compare);
+	f_list.push(static_cast<int>(f), {eval_context.get_g_value(), state_id});
 
 	if (f <= suboptimality_factor * f_min) {
 		const auto d = static_cast<double>(eval_context.get_evaluator_value(distance.get()));
@@ -156,6 +139,7 @@ void AlternatingSpeedySearch::initialize() {
 			statistics.print_checkpoint_line(0);
 		auto node = search_space.get_node(initial_state);
 		node.open_initial();
+		++num_opened_nodes;
 
 		insert(eval_context);
 	}
@@ -163,9 +147,19 @@ void AlternatingSpeedySearch::initialize() {
 	print_initial_evaluator_values(eval_context);
 }
 
+void AlternatingSpeedySearch::compact_open_lists() {
+	const auto is_closed = [this](StateID id) { return search_space.get_node(state_registry.lookup_state(id)).is_closed(); };
+	const auto removed_f_list_entries = compact_f_buckets(
+			f_list, [](const auto &entry) { return entry.second; }, [](const auto &entry) { return entry.first; }, is_closed);
+	const auto removed_d_entries = d_list.remove_stale(is_closed);
+	const auto removed_f_hat_entries = f_hat_list.remove_stale(is_closed);
+	compaction.report_compaction(removed_f_list_entries + removed_d_entries + removed_f_hat_entries);
+}
+
 void AlternatingSpeedySearch::print_statistics() const {
 	statistics.print_detailed_statistics();
 	search_space.print_statistics();
+	compaction.print_statistics();
 }
 
 auto AlternatingSpeedySearch::step() -> SearchStatus {
@@ -222,6 +216,7 @@ auto AlternatingSpeedySearch::step() -> SearchStatus {
 				continue;
 			}
 			succ_node.open(*node, op, get_adjusted_cost(op));
+			++num_opened_nodes;
 
 			insert(succ_eval_context);
 			if (search_progress.check_progress(succ_eval_context)) {
@@ -240,6 +235,7 @@ auto AlternatingSpeedySearch::step() -> SearchStatus {
 					  consistent heuristic).
 					*/
 					statistics.inc_reopened();
+					++num_opened_nodes;
 				}
 				succ_node.reopen(*node, op, get_adjusted_cost(op));
 
@@ -292,6 +288,7 @@ static auto _parse_alternating_speedy(OptionParser &parser) -> std::shared_ptr<S
 	parser.add_option<bool>("reopen_closed", "reopen closed nodes", "true");
 	add_warm_start_options(parser);
 	add_percentage_based_error_option(parser);
+	add_compaction_option(parser);
 
 	SearchEngine::add_options_to_parser(parser);
 
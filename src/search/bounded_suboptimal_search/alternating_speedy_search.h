@@ -1,13 +1,14 @@
 #ifndef BOUNDED_SUBOPTIMAL_SEARCH_ALTERNATING_SPEEDY_SEARCH_H
 #define BOUNDED_SUBOPTIMAL_SEARCH_ALTERNATING_SPEEDY_SEARCH_H
 
-#include <map>
 #include <optional>
 
+#include "../algorithms/f_bucket_open_list.h"
 #include "../floating_point_evaluator/floating_point_evaluator.h"
 #include "../floating_point_open_list/best_first_open_list.h"
 #include "../heuristic_error/heuristic_error.h"
 #include "../search_engine.h"
+#include "open_list_compaction.h"
 
 namespace bounded_suboptimal_search {
 class AlternatingSpeedySearch : public SearchEngine {
@@ -20,13 +21,18 @@ class AlternatingSpeedySearch : public SearchEngine {
 	floating_point_open_list::BestFirstOpenList<1, StateID> d_list;
 	floating_point_open_list::BestFirstOpenList<1, StateID> f_hat_list;
 
+	struct FListCompare {
+		auto operator()(const std::pair<int, StateID> &lhs, const std::pair<int, StateID> &rhs) const -> bool { return lhs.first < rhs.first; }
+	};
+
 	// iterable bucket-based open list (ordered by f)
 	// each bucket is a heap sorted by high g
-	std::map<int, std::vector<std::pair<int, StateID>>> f_list;
+	f_bucket_open_list::FBucketOpenList<std::pair<int, StateID>, FListCompare> f_list;
+	// number of times a node was opened (including reopenings of closed nodes)
+	int num_opened_nodes;
 
-	static constexpr auto f_list_compare = [](const std::pair<int, StateID> &lhs, const std::pair<int, StateID> &rhs) {
-		return lhs.first < rhs.first;
-	};
+	OpenListCompaction compaction;
+	void compact_open_lists();
 
 	void reward_progress();
 
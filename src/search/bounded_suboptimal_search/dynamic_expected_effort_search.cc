@@ -10,6 +10,7 @@
 #include "../floating_point_evaluator/fp_sum_evaluator.h"
 #include "../floating_point_open_list/best_first_open_list.h"
 #include "../floating_point_open_list/floating_point_open_list.h"
+#include "../floating_point_open_list/heap_type.h"
 #include "../heuristic_error/debiased_distance.h"
 #include "../heuristic_error/one_step_distance_error.h"
 #include "../option_parser.h"
@@ -29,10 +30,16 @@ DynamicExpectedEffortSearch<N>::DynamicExpectedEffortSearch(const Options &opts)
 	  reopen_closed_nodes(opts.get<bool>("reopen_closed")),
 	  suboptimality_factor(opts.get<double>("suboptimality_factor")),
 	  expected_work_error_margin(opts.get<double>("expected_work_error_margin")),
+	  cache_focal_values(opts.get<bool>("cache_focal_values")),
 	  alternation_mode(static_cast<AlternationMode>(opts.get<int>("alternation_mode"))),
 	  f_min(0),
-	  f_evaluator(std::make_shared<sum_evaluator::SumEvaluator>(
-			  std::vector<std::shared_ptr<Evaluator>>{std::make_shared<g_evaluator::GEvaluator>(), opts.get<std::shared_ptr<Evaluator>>("heuristic")})),
+	  focal_list(create_best_first_open_list_variant<N, StateID>(opts.get<HeapType>("heap"), opts.get<bool>("compress_primary_key"))),
+	  focal_values(cache_focal_values ? std::make_unique<PerStateInformation<FocalValues>>(FocalValues(), "focal values", true) : nullptr),
+	  compaction(opts),
+	  reorder_scheduler(opts),
+	  heuristic(opts.get<std::shared_ptr<Evaluator>>("heuristic")),
+	  distance(opts.get<std::shared_ptr<Evaluator>>("distance")),
+	  f_evaluator(std::make_shared<sum_evaluator::SumEvaluator>(std::vector<std::shared_ptr<Evaluator>>{std::make_shared<g_evaluator::GEvaluator>(), heuristic})),
 	  f_hat_evaluator(opts.get<std::shared_ptr<FloatingPointEvaluator>>("f_hat_evaluator")),
 	  d_hat_evaluator(opts.get<std::shared_ptr<FloatingPointEvaluator>>("d_hat_evaluator")),
 	  f_hat_min_evaluator(std::static_pointer_cast<FHatMinEvaluator>(opts.get<std::shared_ptr<FloatingPointEvaluator>>("f_hat_min_evaluator"))) {
@@ -48,76 +55,81 @@ void DynamicExpectedEffortSearch<N>::initialize_extra(EvaluationContext &eval_co
 	const auto d_hat = d_hat_evaluator->compute_result(eval_context);
 	if (!FloatingPointEvaluator::is_dead_end(f_hat) && !FloatingPointEvaluator::is_dead_end(d_hat))
 		f_hat_min_evaluator->update(f_hat, d_hat);
+	reorder_scheduler.initialize();
 }
 
 template <std::size_t N>
 auto DynamicExpectedEffortSearch<N>::fetch_next_node() -> std::optional<SearchNode> {
+	if (compaction.should_compact(open_list.size(), this->get_num_open_nodes()))
+		compact_open_lists();
+
 	// remove closed nodes from the front of the open list
-	while (true) {
-		if (open_list.empty())
-			return {};
-		auto &state_ids = std::begin(open_list)->second;
-		const auto id = state_ids.front().second;
-		const auto s = state_registry.lookup_state(id);
-		const auto node = search_space.get_node(s);
-		if (!node.is_closed())
-			break;
-		std::pop_heap(std::begin(state_ids), std::end(state_ids), open_list_compare);
-		state_ids.pop_back();
-		if (state_ids.empty())
-			open_list.erase(std::begin(open_list));
-	}
+	open_list.prune_top([this](const auto &entry) { return search_space.get_node(state_registry.lookup_state(entry.state_id)).is_closed(); });
+	if (open_list.empty())
+		return {};
+	const auto current_f_min = open_list.get_min_f();
 
-	assert(!open_list.empty());
-	assert(!std::begin(open_list)->second.empty());
-	const auto current_f_min = std::begin(open_list)->first;
+	// re-key focal once the error models have drifted too far, before adding the nodes that are now within the bound
+	// (DXES never re-keyed focal otherwise, so no re-keys are counted as skipped and none happen if the drift cannot be bounded)
+	if (reorder_scheduler.is_enabled() && reorder_scheduler.should_reorder(false))
+		reorder_focal();
 
 	// update f_min if necessary
 	if (current_f_min > f_min) {
 		// f_min increased --> fix focal/f-hat by copying all nodes that were previously
 		// outside the bound (i.e. suboptimality factor * current_f_min) and are now
 		// inside it (i.e. suboptimality_factor * f_min)
-		const auto lower = open_list.upper_bound(suboptimality_factor * f_min);
-		const auto upper = open_list.upper_bound(suboptimality_factor * current_f_min);
-		for (auto it = lower; it != upper; ++it) {
-			for (auto [_, state_id] : it->second) {
-				const auto state = state_registry.lookup_state(state_id);
-				const auto node = search_space.get_node(state);
-				if (node.is_closed())
-					continue;
-				auto eval_context = EvaluationContext(state, node.get_g(), false, &statistics);
-				auto evaluator_values = this->compute_results(eval_context);
-				focal_list.emplace(std::move(evaluator_values), std::move(state_id), false);
-				if (alternation_mode == AlternationMode::F_HAT || alternation_mode == AlternationMode::BOTH) {
-					// we are alternating with f-hat, so the f-hat queue must also adhere to the suboptimality bound
-					const auto f_hat = f_hat_evaluator->compute_result(eval_context);
-					f_hat_list.push({f_hat}, state_id, eval_context.is_preferred());
-				}
+		open_list.for_each_in_range(suboptimality_factor * f_min, suboptimality_factor * current_f_min, [this](const auto &entry) {
+			auto state_id = entry.state_id;
+			const auto state = state_registry.lookup_state(state_id);
+			const auto node = search_space.get_node(state);
+			if (node.is_closed())
+				return;
+			if (cache_focal_values) {
+				// the node was evaluated on insertion --> move the stored values without recomputing them
+				const auto &values = (*focal_values)[state];
+				std::visit([&](auto &list) { list.push(values.evaluator_values, state_id, false); }, focal_list);
+				if (alternation_mode == AlternationMode::F_HAT || alternation_mode == AlternationMode::BOTH)
+					f_hat_list.push({values.f_hat}, state_id, false);
+				statistics.inc_avoided_reevaluations();
+				return;
 			}
-		}
+			auto eval_context = EvaluationContext(state, node.get_g(), false, &statistics);
+			auto evaluator_values = this->compute_results(eval_context);
+			std::visit([&](auto &list) { list.emplace(std::move(evaluator_values), std::move(state_id), false); }, focal_list);
+			if (alternation_mode == AlternationMode::F_HAT || alternation_mode == AlternationMode::BOTH) {
+				// we are alternating with f-hat, so the f-hat queue must also adhere to the suboptimality bound
+				const auto f_hat = f_hat_evaluator->compute_result(eval_context);
+				f_hat_list.push({f_hat}, state_id, eval_context.is_preferred());
+			}
+		});
 		f_min = current_f_min;
 	}
 
 	auto node = std::optional<SearchNode>();
 	while (true) {
 		// the focal list should contain at least one (non-closed) node: the one with minimal f value from the open list
-		assert(!focal_list.empty());
+		assert(!std::visit([](const auto &list) { return list.empty(); }, focal_list));
 
 		auto id = StateID::no_state;
 		auto focal_key = std::optional<double>();
 		switch (get_active_queue()) {
 		case Queue::DXES:
-			id = focal_list.top();
-			if (expected_work_error_margin >= 0)
-				focal_key = focal_list.top_key()[0];
-			focal_list.pop();
+			std::visit(
+					[&](auto &list) {
+						id = list.top();
+						if (expected_work_error_margin >= 0)
+							focal_key = list.top_key()[0];
+						list.pop();
+					},
+					focal_list);
 			break;
 		case Queue::F_HAT:
 			id = f_hat_list.top();
 			f_hat_list.pop();
 			break;
 		case Queue::F:
-			id = std::begin(open_list)->second.front().second;
+			id = open_list.top().state_id;
 			assert(!search_space.get_node(state_registry.lookup_state(id)).is_closed());
 			// the open list will be cleaned up in the next call of fetch_next_state
 			break;
@@ -137,7 +149,7 @@ auto DynamicExpectedEffortSearch<N>::fetch_next_node() -> std::optional<SearchNo
 				const auto expected_work = evaluator_values.front();
 				if (std::abs((expected_work - old_expected_work) / old_expected_work) > expected_work_error_margin) {
 					// the difference in expected work values is too large ==> re-insert the node and continue
-					focal_list.emplace(std::move(evaluator_values), std::move(id), false);
+					std::visit([&](auto &list) { list.emplace(std::move(evaluator_values), std::move(id), false); }, focal_list);
 					continue;
 				}
 			}
@@ -157,20 +169,29 @@ template <std::size_t N>
 void DynamicExpectedEffortSearch<N>::insert(EvaluationContext &eval_context, const EvaluatorValues &evaluator_values, StateID state_id, bool preferred) {
 	assert(!eval_context.is_evaluator_value_infinite(f_evaluator.get()));
 	const auto f = eval_context.get_evaluator_value(f_evaluator.get());
-	open_list[f].emplace_back(eval_context.get_g_value(), state_id);
-	std::push_heap(std::begin(open_list[f]), std::end(open_list[f]), open_list_compare);
-
 	const auto check_bound_for_f_hat = alternation_mode == AlternationMode::F_HAT || alternation_mode == AlternationMode::BOTH;
-	if (!check_bound_for_f_hat) {
-		const auto f_hat = f_hat_evaluator->compute_result(eval_context);
-		f_hat_list.push({f_hat}, state_id, preferred);
+	const auto in_focal = f <= suboptimality_factor * f_min;
+
+	// f-hat is only needed if it goes to the f-hat list now or if it must be kept for a later move to focal
+	auto f_hat = 0.;
+	if (!check_bound_for_f_hat || in_focal || cache_focal_values)
+		f_hat = f_hat_evaluator->compute_result(eval_context);
+
+	open_list.push(f, {eval_context.get_g_value(), state_id});
+	if (focal_values)
+		(*focal_values)[eval_context.get_state()] = {evaluator_values, f_hat};
+	if (reorder_scheduler.is_enabled()) {
+		// every node in focal has been inserted at some point
+		assert(!eval_context.is_evaluator_value_infinite(distance.get()));
+		reorder_scheduler.report_focal_node(eval_context.get_evaluator_value(heuristic.get()), eval_context.get_evaluator_value(distance.get()));
 	}
-	if (f <= suboptimality_factor * f_min) {
-		focal_list.push(evaluator_values, state_id, preferred);
-		if (check_bound_for_f_hat) {
-			const auto f_hat = f_hat_evaluator->compute_result(eval_context);
+
+	if (!check_bound_for_f_hat)
+		f_hat_list.push({f_hat}, state_id, preferred);
+	if (in_focal) {
+		std::visit([&](auto &list) { list.push(evaluator_values, state_id, preferred); }, focal_list);
+		if (check_bound_for_f_hat)
 			f_hat_list.push({f_hat}, state_id, preferred);
-		}
 	}
 }
 
@@ -212,6 +233,40 @@ void DynamicExpectedEffortSearch<N>::update_f_hat_min() {
 	}
 }
 
+template <std::size_t N>
+void DynamicExpectedEffortSearch<N>::reorder_focal() {
+	// all entries of focal have outdated evaluator values
+	std::visit([](auto &list) { list.remove_stale([](StateID) { return true; }); }, focal_list);
+	open_list.for_each_in_range(-1, suboptimality_factor * f_min, [this](const auto &entry) {
+		const auto state = state_registry.lookup_state(entry.state_id);
+		const auto node = search_space.get_node(state);
+		// skip closed states and the outdated entries of reopened states
+		if (node.is_closed() || node.get_g() != entry.g)
+			return;
+		auto eval_context = EvaluationContext(state, node.get_g(), false, &statistics);
+		std::visit([&](auto &list) { list.push(this->compute_results(eval_context), entry.state_id, false); }, focal_list);
+	});
+	reorder_scheduler.report_reorder();
+}
+
+template <std::size_t N>
+void DynamicExpectedEffortSearch<N>::compact_open_lists() {
+	const auto is_closed = [this](StateID id) { return search_space.get_node(state_registry.lookup_state(id)).is_closed(); };
+	const auto removed_open_list_entries = compact_f_buckets(
+			open_list, [](const auto &entry) { return entry.state_id; }, [](const auto &entry) { return entry.g; }, is_closed);
+	const auto removed_focal_entries = std::visit([&](auto &list) { return list.remove_stale(is_closed); }, focal_list);
+	const auto removed_f_hat_entries = f_hat_list.remove_stale(is_closed);
+	compaction.report_compaction(removed_open_list_entries + removed_focal_entries + removed_f_hat_entries);
+}
+
+template <std::size_t N>
+void DynamicExpectedEffortSearch<N>::print_statistics() const {
+	EagerSuboptimalSearch<N>::print_statistics();
+	compaction.print_statistics();
+	if (reorder_scheduler.is_enabled())
+		reorder_scheduler.print_statistics();
+}
+
 template <std::size_t N>
 void DynamicExpectedEffortSearch<N>::reward_progress() {
 	// preferred operators are not (yet?) implemented for DXES --> nothing to do here
@@ -227,6 +282,12 @@ static auto _parse_dxes(OptionParser &parser) -> std::shared_ptr<SearchEngine> {
 			"than five percent from the expected work value at insertion, the node is reinserted with the updated value. This setting is disabled if given a "
 			"negative value.",
 			"-1");
+	parser.add_option<bool>(
+			"cache_focal_values",
+			"Store the evaluator values computed at insertion time for each state and reuse them when the node is moved to focal after an "
+			"increase of f_min instead of re-evaluating the node. This avoids heuristic re-evaluations, but the expected work values are not updated to the "
+			"current error model.",
+			"false");
 	// using an int enum option for simplicity
 	parser.add_enum_option<int>("alternation_mode", {"NONE", "F", "F_HAT", "BOTH"}, "alternate DXES expansions with f/f-hat expansions", "NONE");
 	parser.add_option<bool>("admissible_h", "Indicate that the heuristic is admissible for the debiased heuristic.", "true");
@@ -237,7 +298,11 @@ static auto _parse_dxes(OptionParser &parser) -> std::shared_ptr<SearchEngine> {
 	add_warm_start_options(parser);
 	add_percentage_based_error_option(parser);
 	add_online_variance_option(parser);
+	add_normal_cdf_option(parser);
 	add_f_hat_then_d_tie_breaking_option(parser);
+	add_open_list_heap_options(parser);
+	add_compaction_option(parser);
+	add_reorder_tolerance_option(parser);
 	add_options_to_parser(parser);
 
 	auto opts = parser.parse();
@@ -278,6 +343,7 @@ static auto _parse_dxes(OptionParser &parser) -> std::shared_ptr<SearchEngine> {
 
 	auto nancy_assumptions_opts = options::Options();
 	nancy_assumptions_opts.set("cache_estimates", false);
+	nancy_assumptions_opts.set<NormalCDFMethod>("normal_cdf", opts.get<NormalCDFMethod>("normal_cdf"));
 	nancy_assumptions_opts.set("suboptimality_factor", opts.get<double>("suboptimality_factor"));
 	nancy_assumptions_opts.set<std::shared_ptr<Evaluator>>("f", f_evaluator);
 	nancy_assumptions_opts.set<std::shared_ptr<FloatingPointEvaluator>>("d_hat", debiased_distance);
@@ -299,6 +365,9 @@ static auto _parse_dxes(OptionParser &parser) -> std::shared_ptr<SearchEngine> {
 	opts.set<std::shared_ptr<FloatingPointEvaluator>>("f_hat_evaluator", f_hat_evaluator);
 	opts.set<std::shared_ptr<FloatingPointEvaluator>>("d_hat_evaluator", debiased_distance);
 	opts.set<std::shared_ptr<FloatingPointEvaluator>>("f_hat_min_evaluator", f_hat_min_evaluator);
+	opts.set<std::shared_ptr<heuristic_error::HeuristicError>>("heuristic_error", heuristic_error);
+	opts.set<std::shared_ptr<heuristic_error::HeuristicError>>("distance_error", distance_error);
+	opts.set<std::shared_ptr<NancyAssumptionsSBSEvaluator>>("nancy_assumptions_evaluator", nancy_assumptions_evaluator);
 
 	if (opts.get<bool>("enable_tie_breaking")) {
 		auto d_evaluator = std::make_shared<FloatingPointEvaluatorWrapper>(opts.get<std::shared_ptr<Evaluator>>("distance"));
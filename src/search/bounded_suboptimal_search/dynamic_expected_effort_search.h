@@ -2,20 +2,28 @@
 #define BOUNDED_SUBOPTIMAL_SEARCH_DYNAMIC_EXPECTED_EFFORT_SEARCH_H
 
 #include <functional>
-#include <map>
 
+#include "../algorithms/f_bucket_open_list.h"
 #include "../floating_point_open_list/best_first_open_list.h"
+#include "../floating_point_open_list/heap_type.h"
 #include "../suboptimal_search/eager_suboptimal_search.h"
+#include "expected_work_reorder_scheduler.h"
 #include "f_hat_min_evaluator.h"
+#include "open_list_compaction.h"
 
 namespace bounded_suboptimal_search {
 template <std::size_t N>
 class DynamicExpectedEffortSearch : public suboptimal_search::EagerSuboptimalSearch<N> {
+	using typename suboptimal_search::EagerSuboptimalSearch<N>::EvaluatorValues;
+
 	const bool reopen_closed_nodes;
 	const double suboptimality_factor;
 
 	const double expected_work_error_margin;
 
+	// reuse the evaluator values from insertion time when moving nodes to focal instead of recomputing them
+	const bool cache_focal_values;
+
 	enum class AlternationMode { NONE, F, F_HAT, BOTH } const alternation_mode;
 
 	enum class Queue { DXES, F, F_HAT };
@@ -24,16 +32,38 @@ class DynamicExpectedEffortSearch : public suboptimal_search::EagerSuboptimalSea
 
 	int f_min;
 
-	floating_point_open_list::BestFirstOpenList<N, StateID> focal_list;
+	// the heap is selected at runtime, but the list is held by value to keep the calls non-virtual
+	floating_point_open_list::BestFirstOpenListVariant<N, StateID> focal_list;
+
+	struct OpenListEntry {
+		int g;
+		StateID state_id;
+	};
+
+	// evaluator values of the last insertion of a state (only stored with cache_focal_values)
+	struct FocalValues {
+		EvaluatorValues evaluator_values;
+		double f_hat;
+	};
+	std::unique_ptr<PerStateInformation<FocalValues>> focal_values;
+
+	struct OpenListCompare {
+		auto operator()(const OpenListEntry &lhs, const OpenListEntry &rhs) const -> bool { return lhs.g < rhs.g; }
+	};
 
 	// iterable bucket-based open list (ordered by f)
 	// each bucket is a heap sorted by high g
-	std::map<int, std::vector<std::pair<int, StateID>>> open_list;
+	f_bucket_open_list::FBucketOpenList<OpenListEntry, OpenListCompare> open_list;
 
-	static constexpr auto open_list_compare = [](const std::pair<int, StateID> &lhs, const std::pair<int, StateID> &rhs) {
-		return lhs.first < rhs.first;
-	};
+	OpenListCompaction compaction;
+	void compact_open_lists();
+
+	// rebuild focal from the open list with the evaluator values of the current error models
+	void reorder_focal();
+	ExpectedWorkReorderScheduler reorder_scheduler;
 
+	std::shared_ptr<Evaluator> heuristic;
+	std::shared_ptr<Evaluator> distance;
 	std::shared_ptr<Evaluator> f_evaluator;
 
 	std::shared_ptr<floating_point_evaluator::FloatingPointEvaluator> f_hat_evaluator;
@@ -46,8 +76,6 @@ class DynamicExpectedEffortSearch : public suboptimal_search::EagerSuboptimalSea
 	void reward_progress() override;
 
 protected:
-	using typename suboptimal_search::EagerSuboptimalSearch<N>::EvaluatorValues;
-
 	using suboptimal_search::EagerSuboptimalSearch<N>::search_space;
 	using suboptimal_search::EagerSuboptimalSearch<N>::state_registry;
 	using suboptimal_search::EagerSuboptimalSearch<N>::statistics;
@@ -60,6 +88,8 @@ protected:
 public:
 	explicit DynamicExpectedEffortSearch(const options::Options &opts);
 	virtual ~DynamicExpectedEffortSearch() = default;
+
+	void print_statistics() const override;
 };
 } // namespace bounded_suboptimal_search
 
@@ -0,0 +1,127 @@
+#include "expected_work_reorder_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "../heuristic_error/heuristic_error.h"
+#include "../option_parser.h"
+#include "../utils/logging.h"
+#include "f_hat_min_evaluator.h"
+#include "suboptimality_bound_assumptions_nancy_evaluator.h"
+
+namespace bounded_suboptimal_search {
+// phi(0) and phi(1) for the density phi of the standard normal distribution
+static constexpr auto max_normal_density = 0.3989422804014327;
+static constexpr auto max_normal_density_times_argument = 0.24197072451914337;
+
+// bound on |S / S' - 1| for a standard deviation S whose variance changes from old_variance to new_variance
+static auto get_stddev_change(double old_variance, double new_variance) -> double {
+	if (old_variance == new_variance)
+		return 0.;
+	if (!(old_variance > 0.) || !(new_variance > 0.))
+		return std::numeric_limits<double>::infinity();
+	return std::abs(std::sqrt(old_variance / new_variance) - 1);
+}
+
+ExpectedWorkReorderScheduler::ExpectedWorkReorderScheduler(const options::Options &opts)
+	: tolerance(opts.get<double>("reorder_tolerance")),
+	  percentage_based_error(opts.get<bool>("percentage_based_error")),
+	  heuristic_error(opts.get<std::shared_ptr<heuristic_error::HeuristicError>>("heuristic_error")),
+	  distance_error(opts.get<std::shared_ptr<heuristic_error::HeuristicError>>("distance_error")),
+	  f_hat_min_evaluator(std::static_pointer_cast<FHatMinEvaluator>(opts.get<std::shared_ptr<floating_point_evaluator::FloatingPointEvaluator>>("f_hat_min_evaluator"))),
+	  nancy_assumptions_evaluator(opts.get<std::shared_ptr<NancyAssumptionsSBSEvaluator>>("nancy_assumptions_evaluator")),
+	  reference(),
+	  max_h(0),
+	  max_d(0),
+	  num_reorders(0),
+	  num_skipped_reorders(0) {}
+
+auto ExpectedWorkReorderScheduler::get_model_state() const -> ModelState {
+	auto state = ModelState();
+	state.heuristic_error_mean = heuristic_error->get_average_heuristic_error();
+	state.heuristic_error_variance = heuristic_error->get_heuristic_error_variance();
+	state.distance_error_mean = distance_error->get_average_heuristic_error();
+	state.f_hat_min = f_hat_min_evaluator->get_f_hat_min();
+	// f-hat-min is not a number before its first update
+	state.cost_bound_stddev = std::isfinite(state.f_hat_min) ? nancy_assumptions_evaluator->get_cost_bound_stddev() : 0.;
+	return state;
+}
+
+auto ExpectedWorkReorderScheduler::get_drift() const -> double {
+	constexpr auto inf = std::numeric_limits<double>::infinity();
+	if (nancy_assumptions_evaluator->get_cost_bound_variance_method() == NancyAssumptionsSBSEvaluator::CostBoundVarianceMethod::ZERO_IMPROVED)
+		return inf;
+	const auto current = get_model_state();
+	if (!std::isfinite(current.f_hat_min) || !std::isfinite(reference.f_hat_min))
+		return inf;
+	// d-hat = d * distance factor
+	const auto reference_distance_factor = 1 / (1 - reference.distance_error_mean);
+	const auto current_distance_factor = 1 / (1 - current.distance_error_mean);
+	if (!std::isfinite(reference_distance_factor) || !std::isfinite(current_distance_factor))
+		return inf;
+
+	// largest shift of f-hat (max(...) in the debiased heuristic is 1-Lipschitz)
+	const auto f_hat_shift = percentage_based_error
+			? max_h * std::abs(current.heuristic_error_mean - reference.heuristic_error_mean)
+			: max_d * std::abs(current.heuristic_error_mean * current_distance_factor - reference.heuristic_error_mean * reference_distance_factor);
+	const auto cost_bound_shift = nancy_assumptions_evaluator->get_suboptimality_factor() * std::abs(current.f_hat_min - reference.f_hat_min);
+	const auto mean_shift = f_hat_shift + cost_bound_shift;
+
+	// the current combined standard deviation S' is at least the current standard deviation of the cost bound
+	const auto min_stddev = current.cost_bound_stddev;
+	auto stddev_change = 0.;
+	if (nancy_assumptions_evaluator->uses_online_variance()) {
+		// S^2 is the sum of the cost bound variance and heuristic error variance * d-hat, so its relative change is at most the larger one of both terms
+		stddev_change = std::max(get_stddev_change(reference.cost_bound_stddev * reference.cost_bound_stddev, current.cost_bound_stddev * current.cost_bound_stddev),
+		                         get_stddev_change(reference.heuristic_error_variance * reference_distance_factor,
+		                                           current.heuristic_error_variance * current_distance_factor));
+	} else {
+		// the standard deviation of the solution cost (f-hat - f) / 2 moves by at most half of the shift of f-hat
+		const auto stddev_shift = std::abs(current.cost_bound_stddev - reference.cost_bound_stddev) + f_hat_shift / 2;
+		stddev_change = stddev_shift == 0. ? 0. : min_stddev > 0. ? stddev_shift / min_stddev : inf;
+	}
+	const auto argument_shift = mean_shift == 0. ? 0. : min_stddev > 0. ? mean_shift / min_stddev : inf;
+	return max_normal_density * argument_shift + max_normal_density_times_argument * stddev_change;
+}
+
+auto ExpectedWorkReorderScheduler::should_reorder(bool bounds_changed) -> bool {
+	if (!is_enabled())
+		return bounds_changed;
+	const auto drift = get_drift();
+	// fall back to re-keying on changes of the bounds if the drift cannot be bounded (or is not a number)
+	if (!std::isfinite(drift))
+		return bounds_changed;
+	if (drift > tolerance)
+		return true;
+	if (bounds_changed)
+		++num_skipped_reorders;
+	return false;
+}
+
+void ExpectedWorkReorderScheduler::initialize() {
+	if (is_enabled())
+		reference = get_model_state();
+}
+
+void ExpectedWorkReorderScheduler::report_reorder() {
+	++num_reorders;
+	if (is_enabled())
+		reference = get_model_state();
+}
+
+void ExpectedWorkReorderScheduler::print_statistics() const {
+	utils::g_log << "Focal reorders: " << num_reorders << std::endl;
+	if (!is_enabled())
+		return;
+	utils::g_log << "Skipped focal reorders: " << num_skipped_reorders << std::endl;
+}
+
+void add_reorder_tolerance_option(options::OptionParser &parser) {
+	parser.add_option<double>("reorder_tolerance",
+	                          "Only recompute the expected work values of focal once the error models have drifted so far since the last recomputation "
+	                          "that the probability of some node in focal to be within the bound may have changed by more than this tolerance "
+	                          "(first-order estimate). Disabled if negative.",
+	                          "-1");
+}
+} // namespace bounded_suboptimal_search
@@ -0,0 +1,109 @@
+#ifndef BOUNDED_SUBOPTIMAL_SEARCH_EXPECTED_WORK_REORDER_SCHEDULER_H
+#define BOUNDED_SUBOPTIMAL_SEARCH_EXPECTED_WORK_REORDER_SCHEDULER_H
+
+#include <memory>
+
+namespace heuristic_error {
+class HeuristicError;
+}
+
+namespace options {
+class OptionParser;
+class Options;
+} // namespace options
+
+namespace bounded_suboptimal_search {
+class FHatMinEvaluator;
+class NancyAssumptionsSBSEvaluator;
+
+/*
+  Decides when the expected work values of the focal list must be recomputed
+  (re-keyed) because the error models they are based on have changed.
+
+  The expected work of a node is d-hat / p, where p = 1 - Phi(z) is the
+  probability that its solution is within the bound and
+  z = (f-hat - w * f-hat-min) / S with the combined standard deviation S of
+  the belief distributions (see NancyAssumptionsSBSEvaluator). The factor
+  1 / (1 - average distance error) of d-hat is the same for all nodes and
+  does not change their order, so only changes of p matter.
+
+  The scheduler stores the state of the error models at the last re-key:
+  the mean and variance of the heuristic error, the mean of the distance
+  error and f-hat-min with its standard deviation. From the difference to
+  the current state and upper bounds on the h and d values in focal, it
+  bounds how far z can have moved for any node: the shift of f-hat - w *
+  f-hat-min divided by a lower bound on S, plus the relative change of S.
+  Since Phi has Lipschitz constant phi(0) and |z * phi(z)| <= phi(1), the
+  resulting first-order bound on the change of p is cheap to compute. The
+  focal list is only re-keyed once this bound exceeds the tolerance.
+
+  If the drift cannot be bounded (with the ZERO_IMPROVED cost bound
+  variance method or a zero standard deviation),
+  focal is re-keyed on changes of f_min and f-hat-min as without the
+  scheduler.
+*/
+class ExpectedWorkReorderScheduler {
+	// maximal estimated change of the probabilities before re-keying focal (disabled if negative)
+	const double tolerance;
+	const bool percentage_based_error;
+
+	std::shared_ptr<heuristic_error::HeuristicError> heuristic_error;
+	std::shared_ptr<heuristic_error::HeuristicError> distance_error;
+	std::shared_ptr<FHatMinEvaluator> f_hat_min_evaluator;
+	std::shared_ptr<NancyAssumptionsSBSEvaluator> nancy_assumptions_evaluator;
+
+	struct ModelState {
+		double heuristic_error_mean;
+		double heuristic_error_variance;
+		double distance_error_mean;
+		double f_hat_min;
+		double cost_bound_stddev;
+	};
+
+	// state of the error models at the last re-key
+	ModelState reference;
+
+	// upper bounds on the h and d values of the nodes in focal
+	int max_h;
+	int max_d;
+
+	int num_reorders;
+	int num_skipped_reorders;
+
+	auto get_model_state() const -> ModelState;
+
+public:
+	explicit ExpectedWorkReorderScheduler(const options::Options &opts);
+
+	auto is_enabled() const -> bool { return tolerance >= 0; }
+
+	// must be called once the initial state has been evaluated (the values of focal are up to date)
+	void initialize();
+
+	// must be called for every node added to focal
+	void report_focal_node(int h, int d) {
+		max_h = h > max_h ? h : max_h;
+		max_d = d > max_d ? d : max_d;
+	}
+
+	// estimated maximal change of the probability p of any node in focal since the last re-key (infinite if it cannot be bounded)
+	auto get_drift() const -> double;
+
+	/*
+	  Decide whether focal should be re-keyed now. The engine tells whether
+	  it would have re-keyed focal without the scheduler (because f_min or
+	  f-hat-min changed); only declined re-keys in this case are counted as
+	  skipped.
+	*/
+	auto should_reorder(bool bounds_changed) -> bool;
+
+	// must be called after every re-key of focal
+	void report_reorder();
+
+	void print_statistics() const;
+};
+
+extern void add_reorder_tolerance_option(options::OptionParser &parser);
+} // namespace bounded_suboptimal_search
+
+#endif
@@ -30,7 +30,8 @@ ExplicitEstimationSearch<tie_breaking>::ExplicitEstimationSearch(const Options &
 	  d_hat_evaluator(opts.get<std::shared_ptr<FloatingPointEvaluator>>("d_hat_evaluator")),
 	  f_hat_evaluator(opts.get<std::shared_ptr<FloatingPointEvaluator>>("f_hat_evaluator")),
 	  debiased_bound(0.),
-	  focal_list(focal_list_compare) {
+	  focal_list_positions(state_registry, "EES focal list positions"),
+	  focal_list(focal_list_positions) {
 	if (!opts.get_list<std::shared_ptr<Evaluator>>("preferred").empty()) {
 		std::cerr << "EES currently does not support preferred operators, exiting." << std::endl;
 		utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
@@ -67,15 +68,14 @@ void ExplicitEstimationSearch<tie_breaking>::open_list_pop() {
 }
 
 template <bool tie_breaking>
-void ExplicitEstimationSearch<tie_breaking>::open_list_push(EvaluationContext &eval_context, const EvaluatorValues &evaluator_values, StateID state_id,
-                                                            std::optional<FocalListHandleType> focal_handle) {
+void ExplicitEstimationSearch<tie_breaking>::open_list_push(EvaluationContext &eval_context, const EvaluatorValues &evaluator_values, StateID state_id) {
 	const auto f_hat = evaluator_values[F_HAT_INDEX];
 	auto &state_ids = open_list[f_hat];
 	if constexpr (tie_breaking) {
-		state_ids.emplace_back(eval_context.get_g_value(), state_id, focal_handle);
+		state_ids.emplace_back(eval_context.get_g_value(), state_id);
 		std::push_heap(std::begin(state_ids), std::end(state_ids), tie_breaking_open_list_compare);
 	} else {
-		state_ids.emplace_back(state_id, focal_handle);
+		state_ids.emplace_back(state_id);
 	}
 }
 
@@ -101,7 +101,6 @@ void ExplicitEstimationSearch<tie_breaking>::update_focal() {
 		const auto upper = open_list.upper_bound(*current_debiased_bound);
 		for (auto it = lower; it != upper; ++it) {
 			for (auto &open_list_element : it->second) {
-				assert(!std::get<std::optional<FocalListHandleType>>(open_list_element));
 				const auto state_id = std::get<StateID>(open_list_element);
 				const auto state = state_registry.lookup_state(state_id);
 				const auto node = search_space.get_node(state);
@@ -110,14 +109,13 @@ void ExplicitEstimationSearch<tie_breaking>::update_focal() {
 					// ignore nodes that are closed or reopened and this one doesn't have the updated g-value
 					continue;
 				const auto d_hat = d_hat_evaluator->compute_result(eval_context);
-				// update handle
 				if constexpr (tie_breaking) {
 					const auto f_hat = f_hat_evaluator->compute_result(eval_context);
 					assert(!eval_context.is_evaluator_value_infinite(heuristic.get()));
 					const auto h = eval_context.get_evaluator_value(heuristic.get());
-					std::get<std::optional<FocalListHandleType>>(open_list_element).emplace(focal_list.emplace(std::make_tuple(d_hat, f_hat, h), std::move(state_id)));
+					focal_list.push_or_update(std::make_tuple(d_hat, f_hat, h), state_id);
 				} else {
-					std::get<std::optional<FocalListHandleType>>(open_list_element).emplace(focal_list.emplace(d_hat, std::move(state_id)));
+					focal_list.push_or_update(d_hat, state_id);
 				}
 			}
 		}
@@ -126,18 +124,16 @@ void ExplicitEstimationSearch<tie_breaking>::update_focal() {
 		const auto lower = open_list.upper_bound(*current_debiased_bound);
 		const auto upper = open_list.upper_bound(debiased_bound);
 		for (auto it = lower; it != upper; ++it) {
-			for (auto &open_list_element : it->second) {
-				auto &focal_handle = std::get<std::optional<FocalListHandleType>>(open_list_element);
+			for (const auto &open_list_element : it->second) {
 				const auto state_id = std::get<StateID>(open_list_element);
 				const auto state = state_registry.lookup_state(state_id);
 				const auto node = search_space.get_node(state);
 				auto eval_context = EvaluationContext(state, node.get_g(), false, &statistics);
 				if (!node.is_closed() && f_hat_evaluator->compute_result(eval_context) == it->first) {
-					// the node should have a (valid!) handle
-					assert(focal_handle);
-					focal_list.erase(*focal_handle);
+					// the node should be in the focal list
+					assert(focal_list.contains(state_id));
+					focal_list.erase(state_id);
 				}
-				focal_handle.reset();
 			}
 		}
 	}
@@ -186,7 +182,7 @@ auto ExplicitEstimationSearch<tie_breaking>::fetch_next_node() -> std::optional<
 
 	update_focal();
 
-	auto best_d_hat = fetch_top(focal_list, [](const auto &focal_pair) { return focal_pair.second; });
+	auto best_d_hat = fetch_top(focal_list, [](const auto &state_id) { return state_id; });
 	if (best_d_hat) {
 		auto best_d_hat_eval_context = EvaluationContext(best_d_hat->get_state(), best_d_hat->get_g(), false, &statistics, false);
 		if (get_cost_estimate(best_d_hat_eval_context) <= bound) {
@@ -211,17 +207,19 @@ auto ExplicitEstimationSearch<tie_breaking>::fetch_next_node() -> std::optional<
 
 template <bool tie_breaking>
 void ExplicitEstimationSearch<tie_breaking>::insert(EvaluationContext &eval_context, const EvaluatorValues &evaluator_values, StateID state_id, bool preferred) {
-	auto focal_handle = std::optional<typename decltype(focal_list)::handle_type>();
+	// a reopened state replaces its previous entry in the focal list (if any)
 	if (evaluator_values[F_HAT_INDEX] <= debiased_bound) {
 		if constexpr (tie_breaking) {
 			assert(!eval_context.is_evaluator_value_infinite(heuristic.get()));
 			const auto h = eval_context.get_evaluator_value(heuristic.get());
-			focal_handle.emplace(focal_list.emplace(std::make_tuple(evaluator_values[D_HAT_INDEX], evaluator_values[F_HAT_INDEX], h), state_id));
+			focal_list.push_or_update(std::make_tuple(evaluator_values[D_HAT_INDEX], evaluator_values[F_HAT_INDEX], h), state_id);
 		} else {
-			focal_handle.emplace(focal_list.emplace(evaluator_values[D_HAT_INDEX], state_id));
+			focal_list.push_or_update(evaluator_values[D_HAT_INDEX], state_id);
 		}
+	} else if (focal_list.contains(state_id)) {
+		focal_list.erase(state_id);
 	}
-	open_list_push(eval_context, evaluator_values, state_id, focal_handle);
+	open_list_push(eval_context, evaluator_values, state_id);
 	if constexpr (tie_breaking) {
 		assert(!eval_context.is_evaluator_value_infinite(heuristic.get()));
 		const auto h = eval_context.get_evaluator_value(heuristic.get());
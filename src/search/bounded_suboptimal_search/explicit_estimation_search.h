@@ -1,11 +1,12 @@
 #ifndef BOUNDED_SUBOPTIMAL_SEARCH_EXPLICIT_ESTIMATION_SEARCH_H
 #define BOUNDED_SUBOPTIMAL_SEARCH_EXPLICIT_ESTIMATION_SEARCH_H
 
-#include <boost/heap/fibonacci_heap.hpp>
 #include <map>
+#include <tuple>
 
 #include "../floating_point_open_list/best_first_open_list.h"
 #include "../suboptimal_search/eager_suboptimal_search.h"
+#include "state_heap.h"
 
 namespace bounded_suboptimal_search {
 template <bool tie_breaking>
@@ -43,16 +44,13 @@ protected:
 	void insert(EvaluationContext &eval_context, const EvaluatorValues &evaluator_values, StateID state_id, bool preferred) override;
 
 	// ordered by d-hat, ties are broken by f-hat and h
-	using FocalListValueType = std::conditional_t<tie_breaking, std::pair<std::tuple<double, double, int>, StateID>, std::pair<double, StateID>>;
-	static constexpr auto focal_list_compare = [](const FocalListValueType &lhs, const FocalListValueType &rhs) {
-		return lhs.first > rhs.first;
-	};
-
-	boost::heap::fibonacci_heap<FocalListValueType, boost::heap::compare<decltype(focal_list_compare)>> focal_list;
-	using FocalListHandleType = typename decltype(focal_list)::handle_type;
+	// each open state is contained at most once, with the key of its most recent insertion
+	using FocalListKeyType = std::conditional_t<tie_breaking, std::tuple<double, double, int>, double>;
+	StateHeapPositions focal_list_positions;
+	StateHeap<FocalListKeyType> focal_list;
 
-	using NonTieBreakingOpenListValueType = std::pair<StateID, std::optional<FocalListHandleType>>;
-	using TieBreakingOpenListValueType = std::tuple<int, StateID, std::optional<FocalListHandleType>>; // includes the node's g-value
+	using NonTieBreakingOpenListValueType = std::tuple<StateID>;
+	using TieBreakingOpenListValueType = std::tuple<int, StateID>; // includes the node's g-value
 	using OpenListValueType = std::conditional_t<tie_breaking, TieBreakingOpenListValueType, NonTieBreakingOpenListValueType>;
 	// if tie breaking is enabled, the vector is a heap sorted by high g
 	std::map<double, std::vector<OpenListValueType>> open_list;
@@ -63,7 +61,7 @@ protected:
 
 	auto open_list_top() -> std::optional<SearchNode>;
 	void open_list_pop();
-	void open_list_push(EvaluationContext &eval_context, const EvaluatorValues &evaluator_values, StateID state_id, std::optional<FocalListHandleType> focal_handle);
+	void open_list_push(EvaluationContext &eval_context, const EvaluatorValues &evaluator_values, StateID state_id);
 
 	// ordered by f
 	floating_point_open_list::BestFirstOpenList<tie_breaking ? 2 : 1, StateID> cleanup_list;
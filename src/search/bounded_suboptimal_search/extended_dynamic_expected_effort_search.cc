@@ -34,8 +34,11 @@ ExtendedDynamicExpectedEffortSearch<N>::ExtendedDynamicExpectedEffortSearch(cons
 	  suboptimality_factor(opts.get<double>("suboptimality_factor")),
 	  expected_work_error_margin(opts.get<double>("expected_work_error_margin")),
 	  f_min(0),
+	  open_list_positions(state_registry, "open list positions"),
+	  open_list_f(0, "open list f-values", true),
 	  h_error(opts.get<std::shared_ptr<heuristic_error::HeuristicError>>("h_error")),
 	  expansion_delay(expansion_delay),
+	  open_list_insertion_time(0, "open list insertion times", true),
 	  expected_work_evaluator(opts.get<std::shared_ptr<FloatingPointEvaluator>>("expected_work_evaluator")),
 	  f_evaluator(std::make_shared<sum_evaluator::SumEvaluator>(
 			  std::vector<std::shared_ptr<Evaluator>>{std::make_shared<g_evaluator::GEvaluator>(), opts.get<std::shared_ptr<Evaluator>>("heuristic")})),
@@ -66,7 +69,7 @@ auto ExtendedDynamicExpectedEffortSearch<N>::fetch_next_node() -> std::optional<
 	// open list buckets should not be empty
 	assert(!std::begin(open_list)->second.empty());
 	// the open list should never contain any closed nodes
-	assert(!search_space.get_node(state_registry.lookup_state(std::begin(open_list)->second.top().second)).is_closed());
+	assert(!search_space.get_node(state_registry.lookup_state(std::begin(open_list)->second.top())).is_closed());
 	const auto current_f_min = std::begin(open_list)->first;
 
 	// update f_min if necessary
@@ -134,7 +137,7 @@ auto ExtendedDynamicExpectedEffortSearch<N>::fetch_next_node() -> std::optional<
 		const auto target_f_value = it->first;
 		number_of_nodes_for_f_value[target_f_value] = it->second.size();
 
-		const auto open_list_state_id = it->second.top().second;
+		const auto open_list_state_id = it->second.top();
 		const auto open_list_state = state_registry.lookup_state(open_list_state_id);
 		auto open_list_eval_context = EvaluationContext(open_list_state, node->get_g(), false, &statistics);
 		const auto potential_expected_work = expected_work_evaluator->compute_result(open_list_eval_context);
@@ -164,7 +167,7 @@ auto ExtendedDynamicExpectedEffortSearch<N>::fetch_next_node() -> std::optional<
 	}
 
 	if (expand_best_f) {
-		const auto best_f_id = std::begin(open_list)->second.top().second;
+		const auto best_f_id = std::begin(open_list)->second.top();
 		const auto best_f = state_registry.lookup_state(best_f_id);
 		node.emplace(search_space.get_node(best_f));
 		++best_f_expansions;
@@ -173,17 +176,8 @@ auto ExtendedDynamicExpectedEffortSearch<N>::fetch_next_node() -> std::optional<
 		focal_list.pop();
 	}
 
-	// clean up all corresponding nodes from the open list
-	auto handles_it = open_list_handles.find(node->get_state_id());
-	assert(handles_it != std::end(open_list_handles));
-	for (auto &[f, handle] : handles_it->second) {
-		auto open_list_it = open_list.find(f);
-		assert(open_list_it != std::end(open_list));
-		open_list_it->second.erase(handle);
-		if (open_list_it->second.empty())
-			open_list.erase(open_list_it);
-	}
-	open_list_handles.erase(handles_it);
+	// remove the node from the open list
+	open_list_erase(node->get_state_id());
 
 	// we update f-hat-min after we have found a node for expansion but before closing it to ensure that the f-hat list is non-empty when updating f-hat-min
 	update_f_hat_min();
@@ -199,11 +193,14 @@ void ExtendedDynamicExpectedEffortSearch<N>::insert(EvaluationContext &eval_cont
 	open_list_insertion_time[eval_context.get_state()] = statistics.get_expanded();
 	assert(!eval_context.is_evaluator_value_infinite(f_evaluator.get()));
 	const auto f = eval_context.get_evaluator_value(f_evaluator.get());
+	// a reopened node replaces its previous entry in the open list
+	if (open_list_positions[state_id] != -1)
+		open_list_erase(state_id);
 	auto open_list_it = open_list.find(f);
 	if (open_list_it == std::end(open_list))
-		open_list_it = open_list.emplace(f, open_list_compare).first;
-	const auto handle = open_list_it->second.emplace(eval_context.get_g_value(), state_id);
-	open_list_handles[state_id].emplace_front(f, handle);
+		open_list_it = open_list.emplace(f, OpenListBucketType(open_list_positions)).first;
+	open_list_it->second.push(eval_context.get_g_value(), state_id);
+	open_list_f[eval_context.get_state()] = f;
 
 	const auto f_hat = f_hat_evaluator->compute_result(eval_context);
 	f_hat_list.push({f_hat}, state_id, preferred);
@@ -212,6 +209,15 @@ void ExtendedDynamicExpectedEffortSearch<N>::insert(EvaluationContext &eval_cont
 		focal_list.push(evaluator_values, state_id, preferred);
 }
 
+template <std::size_t N>
+void ExtendedDynamicExpectedEffortSearch<N>::open_list_erase(StateID state_id) {
+	auto open_list_it = open_list.find(open_list_f.get(state_registry, state_id));
+	assert(open_list_it != std::end(open_list));
+	open_list_it->second.erase(state_id);
+	if (open_list_it->second.empty())
+		open_list.erase(open_list_it);
+}
+
 template <std::size_t N>
 void ExtendedDynamicExpectedEffortSearch<N>::update_f_hat_min() {
 	while (true) {
@@ -267,6 +273,7 @@ static auto _parse_edxes(OptionParser &parser) -> std::shared_ptr<SearchEngine>
 	add_warm_start_options(parser);
 	add_percentage_based_error_option(parser);
 	add_online_variance_option(parser);
+	add_normal_cdf_option(parser);
 	add_f_hat_then_d_tie_breaking_option(parser);
 	add_options_to_parser(parser);
 
@@ -308,6 +315,7 @@ static auto _parse_edxes(OptionParser &parser) -> std::shared_ptr<SearchEngine>
 
 	auto nancy_assumptions_opts = options::Options();
 	nancy_assumptions_opts.set("cache_estimates", false);
+	nancy_assumptions_opts.set<NormalCDFMethod>("normal_cdf", opts.get<NormalCDFMethod>("normal_cdf"));
 	nancy_assumptions_opts.set("suboptimality_factor", opts.get<double>("suboptimality_factor"));
 	nancy_assumptions_opts.set<std::shared_ptr<Evaluator>>("f", f_evaluator);
 	nancy_assumptions_opts.set<std::shared_ptr<FloatingPointEvaluator>>("d_hat", debiased_distance);
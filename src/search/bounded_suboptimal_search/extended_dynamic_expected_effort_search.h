@@ -1,8 +1,6 @@
 #ifndef BOUNDED_SUBOPTIMAL_SEARCH_EXTENDED_DYNAMIC_EXPECTED_EFFORT_SEARCH_H
 #define BOUNDED_SUBOPTIMAL_SEARCH_EXTENDED_DYNAMIC_EXPECTED_EFFORT_SEARCH_H
 
-#include <boost/heap/fibonacci_heap.hpp>
-#include <forward_list>
 #include <functional>
 #include <map>
 
@@ -10,6 +8,7 @@
 #include "../floating_point_open_list/best_first_open_list.h"
 #include "../suboptimal_search/eager_suboptimal_search.h"
 #include "f_hat_min_evaluator.h"
+#include "state_heap.h"
 
 namespace bounded_suboptimal_search {
 template <std::size_t N>
@@ -21,16 +20,14 @@ class ExtendedDynamicExpectedEffortSearch : public suboptimal_search::EagerSubop
 
 	int f_min;
 
-	static constexpr auto open_list_compare = [](const std::pair<int, StateID> &lhs, const std::pair<int, StateID> &rhs) {
-		return lhs.first < rhs.first;
-	};
-	using OpenListBucketType = boost::heap::fibonacci_heap<std::pair<int, StateID>, boost::heap::compare<decltype(open_list_compare)>>;
-	using OpenListHandleType = typename OpenListBucketType::handle_type;
+	// keyed by g, top is the node with the highest g
+	using OpenListBucketType = StateHeap<int, std::greater<int>>;
 	// iterable bucket-based open list (ordered by f)
-	// each bucket is a heap sorted by high g
+	// each open state is contained in exactly one bucket, the one of its most recent insertion
+	StateHeapPositions open_list_positions;
 	std::map<int, OpenListBucketType> open_list;
-	// each open state may have one or more nodes in the open list, this yields the corresponding handles
-	std::unordered_map<StateID, std::forward_list<std::pair<int, OpenListHandleType>>> open_list_handles;
+	// f-value of the bucket that contains the state (only meaningful while the state is open)
+	PerStateInformation<int> open_list_f;
 
 	floating_point_open_list::BestFirstOpenList<N, StateID> focal_list;
 
@@ -45,6 +42,7 @@ class ExtendedDynamicExpectedEffortSearch : public suboptimal_search::EagerSubop
 	std::shared_ptr<FHatMinEvaluator> f_hat_min_evaluator;
 	floating_point_open_list::BestFirstOpenList<1, StateID> f_hat_list; // open list to keep track of f-hat-min
 
+	void open_list_erase(StateID state_id);
 	void update_f_hat_min();
 
 	void reward_progress() override;
@@ -0,0 +1,28 @@
+#include "open_list_compaction.h"
+
+#include "../option_parser.h"
+#include "../utils/logging.h"
+
+namespace bounded_suboptimal_search {
+OpenListCompaction::OpenListCompaction(const options::Options &opts)
+	: threshold(opts.get<double>("compaction_threshold")), num_compactions(0), num_removed_entries(0) {}
+
+void OpenListCompaction::report_compaction(std::size_t removed_entries) {
+	++num_compactions;
+	num_removed_entries += removed_entries;
+}
+
+void OpenListCompaction::print_statistics() const {
+	if (!is_enabled())
+		return;
+	utils::g_log << "Open list compactions: " << num_compactions << std::endl;
+	utils::g_log << "Removed stale open list entries: " << num_removed_entries << std::endl;
+}
+
+void add_compaction_option(options::OptionParser &parser) {
+	parser.add_option<double>("compaction_threshold",
+	                          "Rebuild the open lists without entries of closed or re-inserted states once the fraction of such stale entries exceeds this "
+	                          "threshold. Disabled if negative.",
+	                          "-1");
+}
+} // namespace bounded_suboptimal_search
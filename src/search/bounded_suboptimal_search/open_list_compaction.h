@@ -0,0 +1,81 @@
+#ifndef BOUNDED_SUBOPTIMAL_SEARCH_OPEN_LIST_COMPACTION_H
+#define BOUNDED_SUBOPTIMAL_SEARCH_OPEN_LIST_COMPACTION_H
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "../algorithms/f_bucket_open_list.h"
+#include "../state_id.h"
+
+namespace options {
+class OptionParser;
+class Options;
+} // namespace options
+
+namespace bounded_suboptimal_search {
+/*
+  Lazy deletion with threshold-triggered compaction.
+
+  The engines keep entries of closed (or re-inserted) states in their open
+  lists and only skip them when they are popped. This class decides when the
+  open lists should be rebuilt without these stale entries: the engines count
+  the entries of their f-ordered open list, which contains at least one entry
+  for every open state, so the number of stale entries is the number of
+  entries minus the number of open states.
+*/
+class OpenListCompaction {
+	// fraction of stale entries that triggers a compaction (disabled if negative)
+	const double threshold;
+
+	// avoid frequent compactions of small open lists
+	static constexpr std::size_t min_entries = 1024;
+
+	int num_compactions;
+	std::size_t num_removed_entries;
+
+public:
+	explicit OpenListCompaction(const options::Options &opts);
+
+	auto is_enabled() const -> bool { return threshold >= 0; }
+	auto should_compact(std::size_t num_entries, std::size_t num_open_states) const -> bool {
+		return is_enabled() && num_entries >= min_entries && num_entries - std::min(num_entries, num_open_states) > threshold * num_entries;
+	}
+
+	void report_compaction(std::size_t removed_entries);
+
+	void print_statistics() const;
+};
+
+extern void add_compaction_option(options::OptionParser &parser);
+
+/*
+  Remove the entries of closed states and all but one entry of each open
+  state from an f-bucket open list. For each state, the entry with the lowest
+  g value is kept, which is the one that was inserted last. Returns the
+  number of removed entries.
+*/
+template <class Entry, class Compare, class GetStateID, class GetG, class IsClosed>
+auto compact_f_buckets(f_bucket_open_list::FBucketOpenList<Entry, Compare> &open_list, GetStateID get_state_id, GetG get_g, IsClosed is_closed)
+		-> std::size_t {
+	// lowest g value of each open state (or -1 once the entry has been kept)
+	auto min_g = std::unordered_map<StateID, int>();
+	open_list.for_each([&min_g, &get_state_id, &get_g, &is_closed](const auto &entry) {
+		const auto id = get_state_id(entry);
+		if (is_closed(id))
+			return;
+		auto [it, inserted] = min_g.emplace(id, get_g(entry));
+		if (!inserted)
+			it->second = std::min(it->second, get_g(entry));
+	});
+	return open_list.remove_if([&min_g, &get_state_id, &get_g](const auto &entry) {
+		const auto g_it = min_g.find(get_state_id(entry));
+		if (g_it == std::end(min_g) || g_it->second != get_g(entry))
+			return true;
+		g_it->second = -1;
+		return false;
+	});
+}
+} // namespace bounded_suboptimal_search
+
+#endif
@@ -1,6 +1,9 @@
 #include "reordering_dynamic_expected_effort_search.h"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
+#include <unordered_map>
 
 #include "../evaluation_context.h"
 #include "../evaluators/g_evaluator.h"
@@ -11,6 +14,7 @@
 #include "../floating_point_open_list/best_first_open_list.h"
 #include "../floating_point_open_list/floating_point_open_list.h"
 #include "../heuristic_error/debiased_distance.h"
+#include "../heuristic_error/heuristic_error.h"
 #include "../heuristic_error/one_step_distance_error.h"
 #include "../option_parser.h"
 #include "../plugin.h"
@@ -29,6 +33,15 @@ ReorderingDynamicExpectedEffortSearch<N>::ReorderingDynamicExpectedEffortSearch(
 	  reopen_closed_nodes(opts.get<bool>("reopen_closed")),
 	  suboptimality_factor(opts.get<double>("suboptimality_factor")),
 	  f_min(0),
+	  focal_map(FocalBucketHash(focal_buckets), FocalBucketEqual(focal_buckets)),
+	  reorder_scheduler(opts),
+	  batch_reorder(opts.get<bool>("batch_reorder")),
+	  percentage_based_error(opts.get<bool>("percentage_based_error")),
+	  admissible_h(opts.get<bool>("admissible_h")),
+	  heuristic_error(opts.get<std::shared_ptr<heuristic_error::HeuristicError>>("heuristic_error")),
+	  distance_error(opts.get<std::shared_ptr<heuristic_error::HeuristicError>>("distance_error")),
+	  nancy_assumptions_evaluator(opts.get<std::shared_ptr<NancyAssumptionsSBSEvaluator>>("nancy_assumptions_evaluator")),
+	  compaction(opts),
 	  heuristic(opts.get<std::shared_ptr<Evaluator>>("heuristic")),
 	  distance(opts.get<std::shared_ptr<Evaluator>>("distance")),
 	  f_evaluator(std::make_shared<sum_evaluator::SumEvaluator>(std::vector<std::shared_ptr<Evaluator>>{std::make_shared<g_evaluator::GEvaluator>(), heuristic})),
@@ -47,58 +60,42 @@ void ReorderingDynamicExpectedEffortSearch<N>::initialize_extra(EvaluationContex
 	const auto d_hat = d_hat_evaluator->compute_result(eval_context);
 	if (!FloatingPointEvaluator::is_dead_end(f_hat) && !FloatingPointEvaluator::is_dead_end(d_hat))
 		f_hat_min_evaluator->update(f_hat, d_hat);
+	reorder_scheduler.initialize();
 }
 
 template <std::size_t N>
 auto ReorderingDynamicExpectedEffortSearch<N>::fetch_next_node() -> std::optional<SearchNode> {
-	// remove closed nodes from the front of the open list
-	while (true) {
-		if (open_list.empty())
-			return {};
-		auto &state_ids = std::begin(open_list)->second;
-		const auto id = state_ids.front().second;
-		const auto s = state_registry.lookup_state(id);
-		const auto node = search_space.get_node(s);
-		if (!node.is_closed())
-			break;
-		std::pop_heap(std::begin(state_ids), std::end(state_ids), open_list_compare);
-		state_ids.pop_back();
-		if (state_ids.empty())
-			open_list.erase(std::begin(open_list));
-	}
+	if (compaction.should_compact(open_list.size(), this->get_num_open_nodes()))
+		compact_open_lists();
 
-	assert(!open_list.empty());
-	assert(!std::begin(open_list)->second.empty());
-	const auto current_f_min = std::begin(open_list)->first;
-
-	auto reordered_focal = false;
-
-	// update f_min if necessary
-	if (current_f_min > f_min) {
-		// first we take this opportunity to reorder focal
-		reorder_focal();
-		reordered_focal = true;
-		// f_min increased --> fix focal by copying all nodes that were previously
-		// outside the bound (i.e. suboptimality factor * current_f_min) and are now
-		// inside it (i.e. suboptimality_factor * f_min)
-		const auto lower = open_list.upper_bound(suboptimality_factor * f_min);
-		const auto upper = open_list.upper_bound(suboptimality_factor * current_f_min);
-		for (auto it = lower; it != upper; ++it) {
-			for (auto [_, state_id] : it->second) {
-				const auto state = state_registry.lookup_state(state_id);
-				const auto node = search_space.get_node(state);
-				if (node.is_closed())
-					continue;
-				auto eval_context = EvaluationContext(state, node.get_g(), false, &statistics);
-				push_focal(eval_context);
-			}
+	// remove closed nodes from the front of the open list
+	open_list.prune_top([this](const auto &entry) { return search_space.get_node(state_registry.lookup_state(entry.second)).is_closed(); });
+	if (open_list.empty())
+		return {};
+	const auto current_f_min = open_list.get_min_f();
+
+	if (reorder_scheduler.is_enabled()) {
+		// reorder focal once the error models have drifted too far, before adding the nodes that are now within the bound
+		const auto f_hat_min_changed = update_f_hat_min();
+		if (reorder_scheduler.should_reorder(current_f_min > f_min || f_hat_min_changed))
+			reorder_focal();
+		if (current_f_min > f_min)
+			update_f_min(current_f_min);
+	} else {
+		auto reordered_focal = false;
+
+		// update f_min if necessary
+		if (current_f_min > f_min) {
+			// first we take this opportunity to reorder focal
+			reorder_focal();
+			reordered_focal = true;
+			update_f_min(current_f_min);
 		}
-		f_min = current_f_min;
-	}
 
-	// update f_hat_min and reorder focal if we have a new best_f_hat node (and didn't reorder focal before due to an updated f_min)
-	if (update_f_hat_min() && !reordered_focal)
-		reorder_focal();
+		// update f_hat_min and reorder focal if we have a new best_f_hat node (and didn't reorder focal before due to an updated f_min)
+		if (update_f_hat_min() && !reordered_focal)
+			reorder_focal();
+	}
 
 	auto node = std::optional<SearchNode>();
 	while (true) {
@@ -121,12 +118,27 @@ auto ReorderingDynamicExpectedEffortSearch<N>::fetch_next_node() -> std::optiona
 	return node;
 }
 
+template <std::size_t N>
+void ReorderingDynamicExpectedEffortSearch<N>::update_f_min(int new_f_min) {
+	// f_min increased --> fix focal by copying all nodes that were previously
+	// outside the bound (i.e. suboptimality factor * f_min) and are now
+	// inside it (i.e. suboptimality_factor * new_f_min)
+	open_list.for_each_in_range(suboptimality_factor * f_min, suboptimality_factor * new_f_min, [this](const auto &entry) {
+		const auto state = state_registry.lookup_state(entry.second);
+		const auto node = search_space.get_node(state);
+		if (node.is_closed())
+			return;
+		auto eval_context = EvaluationContext(state, node.get_g(), false, &statistics);
+		push_focal(eval_context);
+	});
+	f_min = new_f_min;
+}
+
 template <std::size_t N>
 void ReorderingDynamicExpectedEffortSearch<N>::insert(EvaluationContext &eval_context, const EvaluatorValues &evaluator_values, StateID state_id, bool preferred) {
 	assert(!eval_context.is_evaluator_value_infinite(f_evaluator.get()));
 	const auto f = eval_context.get_evaluator_value(f_evaluator.get());
-	open_list[f].emplace_back(eval_context.get_g_value(), state_id);
-	std::push_heap(std::begin(open_list[f]), std::end(open_list[f]), open_list_compare);
+	open_list.push(f, {eval_context.get_g_value(), state_id});
 
 	const auto f_hat = f_hat_evaluator->compute_result(eval_context);
 	f_hat_list.push({f_hat}, state_id, preferred);
@@ -142,16 +154,18 @@ void ReorderingDynamicExpectedEffortSearch<N>::push_focal(EvaluationContext &eva
 	const auto h = eval_context.get_evaluator_value(heuristic.get());
 	assert(!eval_context.is_evaluator_value_infinite(distance.get()));
 	const auto d = eval_context.get_evaluator_value(distance.get());
-	auto &focal_gh = focal_map[g][h];
-	auto it = focal_gh.find(d);
-	if (it == std::end(focal_gh)) {
-		auto new_bucket = std::make_shared<FocalListBucket>(g, h, d, get_evaluator_values());
-		it = focal_gh.emplace(d, new_bucket).first;
-		focal_list.push_back(new_bucket);
-		std::push_heap(std::begin(focal_list), std::end(focal_list), compare_focal);
+	const auto new_index = allocate_focal_bucket(g, h, d);
+	const auto [index, inserted] = focal_map.insert(new_index);
+	if (inserted) {
+		focal_buckets[index].evaluator_values = get_evaluator_values();
+		reorder_scheduler.report_focal_node(h, d);
+		focal_list.push_back(index);
+		std::push_heap(std::begin(focal_list), std::end(focal_list), get_focal_compare());
+	} else {
+		// there already is a bucket for these (g, h, d) values
+		free_focal_buckets.push_back(new_index);
 	}
-	auto &bucket = *it->second;
-	bucket.state_ids.push_back(eval_context.get_state().get_id());
+	focal_buckets[index].state_ids.push_back(eval_context.get_state().get_id());
 }
 
 template <std::size_t N>
@@ -164,42 +178,169 @@ void ReorderingDynamicExpectedEffortSearch<N>::push_focal(EvaluationContext &eva
 	push_focal(eval_context, [&evaluator_values]() { return evaluator_values; });
 }
 
+template <std::size_t N>
+auto ReorderingDynamicExpectedEffortSearch<N>::allocate_focal_bucket(int g, int h, int d) -> int {
+	if (free_focal_buckets.empty()) {
+		focal_buckets.emplace_back(g, h, d);
+		return static_cast<int>(focal_buckets.size()) - 1;
+	}
+	const auto index = free_focal_buckets.back();
+	free_focal_buckets.pop_back();
+	auto &bucket = focal_buckets[index];
+	assert(bucket.state_ids.empty());
+	bucket.g = g;
+	bucket.h = h;
+	bucket.d = d;
+	return index;
+}
+
+template <std::size_t N>
+void ReorderingDynamicExpectedEffortSearch<N>::release_focal_bucket(int index) {
+	[[maybe_unused]] const auto erased = focal_map.erase(index);
+	assert(erased);
+	// keep the capacity of the state id vector for the next bucket using this slot
+	focal_buckets[index].state_ids.clear();
+	free_focal_buckets.push_back(index);
+}
+
 template <std::size_t N>
 auto ReorderingDynamicExpectedEffortSearch<N>::top_focal() -> StateID {
 	assert(!focal_list.empty());
-	assert(!focal_list.front()->state_ids.empty());
-	return focal_list.front()->state_ids.back();
+	assert(!focal_buckets[focal_list.front()].state_ids.empty());
+	return focal_buckets[focal_list.front()].state_ids.back();
 }
 
 template <std::size_t N>
 void ReorderingDynamicExpectedEffortSearch<N>::pop_focal() {
 	assert(!focal_list.empty());
-	assert(!focal_list.front()->state_ids.empty());
-	focal_list.front()->state_ids.pop_back();
-	if (focal_list.front()->state_ids.empty()) {
-		const auto g_it = focal_map.find(focal_list.front()->g);
-		const auto h_it = g_it->second.find(focal_list.front()->h);
-		h_it->second.erase(focal_list.front()->d);
-		if (h_it->second.empty())
-			g_it->second.erase(h_it);
-		if (g_it->second.empty())
-			focal_map.erase(g_it);
-		std::pop_heap(std::begin(focal_list), std::end(focal_list), compare_focal);
-		assert(focal_list.back()->state_ids.empty());
+	auto &state_ids = focal_buckets[focal_list.front()].state_ids;
+	assert(!state_ids.empty());
+	state_ids.pop_back();
+	if (state_ids.empty()) {
+		std::pop_heap(std::begin(focal_list), std::end(focal_list), get_focal_compare());
+		release_focal_bucket(focal_list.back());
 		focal_list.pop_back();
 	}
 }
 
 template <std::size_t N>
 void ReorderingDynamicExpectedEffortSearch<N>::reorder_focal() {
-	for (auto &bucket : focal_list) {
-		assert(!bucket->state_ids.empty());
-		const auto state_id = bucket->state_ids.front();
-		const auto state = state_registry.lookup_state(state_id);
-		auto eval_context = EvaluationContext(state, bucket->g, false, &statistics);
-		bucket->evaluator_values = this->compute_results(eval_context);
+	if (!batch_reorder || !recompute_focal_values_batch()) {
+		for (const auto index : focal_list) {
+			auto &bucket = focal_buckets[index];
+			assert(!bucket.state_ids.empty());
+			const auto state_id = bucket.state_ids.front();
+			const auto state = state_registry.lookup_state(state_id);
+			auto eval_context = EvaluationContext(state, bucket.g, false, &statistics);
+			bucket.evaluator_values = this->compute_results(eval_context);
+		}
+	}
+	std::make_heap(std::begin(focal_list), std::end(focal_list), get_focal_compare());
+	reorder_scheduler.report_reorder();
+}
+
+template <std::size_t N>
+auto ReorderingDynamicExpectedEffortSearch<N>::recompute_focal_values_batch() -> bool {
+	// the debiased distance is infinite or undefined if the average distance error is one
+	const auto distance_error_factor = 1 - distance_error->get_average_heuristic_error();
+	if (!(distance_error_factor > 0.))
+		return false;
+	const auto average_heuristic_error = heuristic_error->get_average_heuristic_error();
+
+	const auto n = focal_list.size();
+	reorder_f.resize(n);
+	reorder_g.resize(n);
+	reorder_f_hat.resize(n);
+	reorder_d_hat.resize(n);
+	reorder_probabilities.resize(n);
+
+	// same computations as the debiased distance, debiased heuristic and f-hat evaluators (see _parse_reordering_dxes)
+	for (std::size_t i = 0; i < n; ++i) {
+		const auto &bucket = focal_buckets[focal_list[i]];
+		const auto g = static_cast<double>(bucket.g);
+		const auto h = static_cast<double>(bucket.h);
+		const auto d_hat = bucket.d / distance_error_factor;
+		const auto h_hat = percentage_based_error ? h * average_heuristic_error : std::max(admissible_h ? h : 0., h + d_hat * average_heuristic_error);
+		reorder_f[i] = g + h;
+		reorder_g[i] = g;
+		reorder_f_hat[i] = g + h_hat;
+		reorder_d_hat[i] = d_hat;
+	}
+
+	nancy_assumptions_evaluator->compute_values(reorder_f.data(), reorder_g.data(), reorder_f_hat.data(), reorder_d_hat.data(), reorder_probabilities.data(), n);
+
+	// expected work: d-hat divided by the probability (see DivisionEvaluator)
+	for (std::size_t i = 0; i < n; ++i) {
+		auto &bucket = focal_buckets[focal_list[i]];
+		auto &evaluator_values = bucket.evaluator_values;
+		const auto probability = reorder_probabilities[i];
+		if (FloatingPointEvaluator::is_dead_end(probability))
+			evaluator_values[0] = FloatingPointEvaluator::DEAD_END;
+		else if (probability == 0.)
+			evaluator_values[0] = std::numeric_limits<double>::infinity();
+		else
+			evaluator_values[0] = reorder_d_hat[i] / probability;
+		if constexpr (N == 3) {
+			evaluator_values[1] = reorder_f_hat[i];
+			evaluator_values[2] = static_cast<double>(bucket.d);
+		}
+	}
+	return true;
+}
+
+template <std::size_t N>
+void ReorderingDynamicExpectedEffortSearch<N>::compact_open_lists() {
+	const auto is_closed = [this](StateID id) { return search_space.get_node(state_registry.lookup_state(id)).is_closed(); };
+	const auto removed_open_list_entries = compact_f_buckets(
+			open_list, [](const auto &entry) { return entry.second; }, [](const auto &entry) { return entry.first; }, is_closed);
+	const auto removed_focal_entries = compact_focal();
+	const auto removed_f_hat_entries = f_hat_list.remove_stale(is_closed);
+	compaction.report_compaction(removed_open_list_entries + removed_focal_entries + removed_f_hat_entries);
+}
+
+template <std::size_t N>
+auto ReorderingDynamicExpectedEffortSearch<N>::compact_focal() -> std::size_t {
+	// for each open state, keep only the entry in the bucket that would be expanded first
+	auto best_bucket = std::unordered_map<StateID, int>();
+	for (const auto index : focal_list) {
+		for (const auto &state_id : focal_buckets[index].state_ids) {
+			if (search_space.get_node(state_registry.lookup_state(state_id)).is_closed())
+				continue;
+			auto [it, inserted] = best_bucket.emplace(state_id, index);
+			if (!inserted && focal_buckets[index] < focal_buckets[it->second])
+				it->second = index;
+		}
 	}
-	std::make_heap(std::begin(focal_list), std::end(focal_list), compare_focal);
+	auto removed = std::size_t{0};
+	for (const auto index : focal_list) {
+		auto &state_ids = focal_buckets[index].state_ids;
+		const auto old_size = state_ids.size();
+		state_ids.erase(std::remove_if(std::begin(state_ids), std::end(state_ids),
+		                               [&best_bucket, index](const auto state_id) {
+			                               const auto it = best_bucket.find(state_id);
+			                               if (it == std::end(best_bucket) || it->second != index)
+				                               return true;
+			                               // keep only the first occurrence within the bucket
+			                               best_bucket.erase(it);
+			                               return false;
+		                               }),
+		                std::end(state_ids));
+		removed += old_size - state_ids.size();
+		if (state_ids.empty())
+			release_focal_bucket(index);
+	}
+	focal_list.erase(
+			std::remove_if(std::begin(focal_list), std::end(focal_list), [this](const auto index) { return focal_buckets[index].state_ids.empty(); }),
+			std::end(focal_list));
+	std::make_heap(std::begin(focal_list), std::end(focal_list), get_focal_compare());
+	return removed;
+}
+
+template <std::size_t N>
+void ReorderingDynamicExpectedEffortSearch<N>::print_statistics() const {
+	EagerSuboptimalSearch<N>::print_statistics();
+	compaction.print_statistics();
+	reorder_scheduler.print_statistics();
 }
 
 template <std::size_t N>
@@ -245,7 +386,13 @@ static auto _parse_reordering_dxes(OptionParser &parser) -> std::shared_ptr<Sear
 	add_warm_start_options(parser);
 	add_percentage_based_error_option(parser);
 	add_online_variance_option(parser);
+	add_normal_cdf_option(parser);
 	add_f_hat_then_d_tie_breaking_option(parser);
+	add_compaction_option(parser);
+	add_reorder_tolerance_option(parser);
+	parser.add_option<bool>("batch_reorder",
+	                        "recompute the expected work of all focal buckets in closed form when reordering focal instead of evaluating one state per bucket",
+	                        "true");
 	add_options_to_parser(parser);
 
 	auto opts = parser.parse();
@@ -286,6 +433,7 @@ static auto _parse_reordering_dxes(OptionParser &parser) -> std::shared_ptr<Sear
 
 	auto nancy_assumptions_opts = options::Options();
 	nancy_assumptions_opts.set("cache_estimates", false);
+	nancy_assumptions_opts.set<NormalCDFMethod>("normal_cdf", opts.get<NormalCDFMethod>("normal_cdf"));
 	nancy_assumptions_opts.set("suboptimality_factor", opts.get<double>("suboptimality_factor"));
 	nancy_assumptions_opts.set<std::shared_ptr<Evaluator>>("f", f_evaluator);
 	nancy_assumptions_opts.set<std::shared_ptr<FloatingPointEvaluator>>("d_hat", debiased_distance);
@@ -307,6 +455,9 @@ static auto _parse_reordering_dxes(OptionParser &parser) -> std::shared_ptr<Sear
 	opts.set<std::shared_ptr<FloatingPointEvaluator>>("f_hat_evaluator", f_hat_evaluator);
 	opts.set<std::shared_ptr<FloatingPointEvaluator>>("d_hat_evaluator", debiased_distance);
 	opts.set<std::shared_ptr<FloatingPointEvaluator>>("f_hat_min_evaluator", f_hat_min_evaluator);
+	opts.set<std::shared_ptr<heuristic_error::HeuristicError>>("heuristic_error", heuristic_error);
+	opts.set<std::shared_ptr<heuristic_error::HeuristicError>>("distance_error", distance_error);
+	opts.set<std::shared_ptr<NancyAssumptionsSBSEvaluator>>("nancy_assumptions_evaluator", nancy_assumptions_evaluator);
 
 	if (opts.get<bool>("enable_tie_breaking")) {
 		auto d_evaluator = std::make_shared<FloatingPointEvaluatorWrapper>(opts.get<std::shared_ptr<Evaluator>>("distance"));
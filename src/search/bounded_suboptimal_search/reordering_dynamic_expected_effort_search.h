@@ -2,12 +2,20 @@
 #define BOUNDED_SUBOPTIMAL_SEARCH_REORDERING_DYNAMIC_EXPECTED_EFFORT_SEARCH_H
 
 #include <functional>
-#include <map>
-#include <unordered_map>
 
+#include "../algorithms/f_bucket_open_list.h"
+#include "../algorithms/int_hash_set.h"
 #include "../floating_point_open_list/best_first_open_list.h"
 #include "../suboptimal_search/eager_suboptimal_search.h"
+#include "../utils/hash.h"
+#include "expected_work_reorder_scheduler.h"
 #include "f_hat_min_evaluator.h"
+#include "open_list_compaction.h"
+#include "suboptimality_bound_assumptions_nancy_evaluator.h"
+
+namespace heuristic_error {
+class HeuristicError;
+}
 
 namespace bounded_suboptimal_search {
 template <std::size_t N>
@@ -20,7 +28,7 @@ class ReorderingDynamicExpectedEffortSearch : public suboptimal_search::EagerSub
 	int f_min;
 
 	struct FocalListBucket {
-		FocalListBucket(int g, int h, int d, const EvaluatorValues &evaluator_values) : g(g), h(h), d(d), evaluator_values(evaluator_values) {}
+		FocalListBucket(int g, int h, int d) : g(g), h(h), d(d), evaluator_values() {}
 
 		int g;
 		int h;
@@ -32,14 +40,50 @@ class ReorderingDynamicExpectedEffortSearch : public suboptimal_search::EagerSub
 		auto operator<(const FocalListBucket &other) const -> bool { return evaluator_values < other.evaluator_values; }
 	};
 
-	// g -> h -> d -> bucket
-	std::unordered_map<int, std::unordered_map<int, std::unordered_map<int, std::shared_ptr<FocalListBucket>>>> focal_map;
-	std::vector<std::shared_ptr<FocalListBucket>> focal_list;
+	struct FocalBucketHash {
+		const std::vector<FocalListBucket> &focal_buckets;
+		explicit FocalBucketHash(const std::vector<FocalListBucket> &focal_buckets) : focal_buckets(focal_buckets) {}
+
+		auto operator()(int index) const -> int_hash_set::HashType {
+			const auto &bucket = focal_buckets[index];
+			auto hash_state = utils::HashState();
+			utils::feed(hash_state, bucket.g);
+			utils::feed(hash_state, bucket.h);
+			utils::feed(hash_state, bucket.d);
+			return int_hash_set::get_hash(hash_state);
+		}
+	};
+
+	struct FocalBucketEqual {
+		const std::vector<FocalListBucket> &focal_buckets;
+		explicit FocalBucketEqual(const std::vector<FocalListBucket> &focal_buckets) : focal_buckets(focal_buckets) {}
 
-	static constexpr auto compare_focal = [](const auto &lhs, const auto &rhs) {
-		return !(*lhs < *rhs);
+		auto operator()(int lhs, int rhs) const -> bool {
+			const auto &lhs_bucket = focal_buckets[lhs];
+			const auto &rhs_bucket = focal_buckets[rhs];
+			return lhs_bucket.g == rhs_bucket.g && lhs_bucket.h == rhs_bucket.h && lhs_bucket.d == rhs_bucket.d;
+		}
 	};
 
+	// pool of focal buckets, referred to by their index; the indices of removed buckets are reused
+	std::vector<FocalListBucket> focal_buckets;
+	std::vector<int> free_focal_buckets;
+
+	// (g, h, d) -> index of the bucket
+	int_hash_set::IntHashSet<FocalBucketHash, FocalBucketEqual> focal_map;
+
+	// heap of bucket indices
+	std::vector<int> focal_list;
+
+	auto get_focal_compare() const {
+		return [this](int lhs, int rhs) {
+			return !(focal_buckets[lhs] < focal_buckets[rhs]);
+		};
+	}
+
+	auto allocate_focal_bucket(int g, int h, int d) -> int;
+	void release_focal_bucket(int index);
+
 	void push_focal(EvaluationContext &eval_context, std::function<EvaluatorValues()> get_evaluator_values);
 	void push_focal(EvaluationContext &eval_context);
 	void push_focal(EvaluationContext &eval_context, const EvaluatorValues &evaluator_values);
@@ -49,14 +93,41 @@ class ReorderingDynamicExpectedEffortSearch : public suboptimal_search::EagerSub
 
 	// recompute the evaluator values for each (g, h, d)-bucket and reorder the focal list accordingly
 	void reorder_focal();
+	ExpectedWorkReorderScheduler reorder_scheduler;
+
+	/*
+	  Recompute the evaluator values of all focal buckets in closed form from
+	  their (g, h, d) values and the current error estimates, avoiding the
+	  state lookup and evaluation context per bucket. Returns false (without
+	  changing any values) if the closed form is not applicable.
+	*/
+	auto recompute_focal_values_batch() -> bool;
+
+	const bool batch_reorder;
+	const bool percentage_based_error;
+	const bool admissible_h;
+	std::shared_ptr<heuristic_error::HeuristicError> heuristic_error;
+	std::shared_ptr<heuristic_error::HeuristicError> distance_error;
+	std::shared_ptr<NancyAssumptionsSBSEvaluator> nancy_assumptions_evaluator;
+
+	// structure-of-arrays buffers for recompute_focal_values_batch (kept to reuse the allocations)
+	std::vector<double> reorder_f;
+	std::vector<double> reorder_g;
+	std::vector<double> reorder_f_hat;
+	std::vector<double> reorder_d_hat;
+	std::vector<double> reorder_probabilities;
+
+	struct OpenListCompare {
+		auto operator()(const std::pair<int, StateID> &lhs, const std::pair<int, StateID> &rhs) const -> bool { return lhs.first < rhs.first; }
+	};
 
 	// iterable bucket-based open list (ordered by f)
 	// each bucket is a heap sorted by high g
-	std::map<int, std::vector<std::pair<int, StateID>>> open_list;
+	f_bucket_open_list::FBucketOpenList<std::pair<int, StateID>, OpenListCompare> open_list;
 
-	static constexpr auto open_list_compare = [](const std::pair<int, StateID> &lhs, const std::pair<int, StateID> &rhs) {
-		return lhs.first < rhs.first;
-	};
+	OpenListCompaction compaction;
+	void compact_open_lists();
+	auto compact_focal() -> std::size_t;
 
 	std::shared_ptr<Evaluator> heuristic;
 	std::shared_ptr<Evaluator> distance;
@@ -68,6 +139,8 @@ class ReorderingDynamicExpectedEffortSearch : public suboptimal_search::EagerSub
 	floating_point_open_list::BestFirstOpenList<1, StateID> f_hat_list; // open list to keep track of f-hat-min
 
 	auto update_f_hat_min() -> bool;
+	// add the nodes that are within the bound after an increase of f_min to focal
+	void update_f_min(int new_f_min);
 
 	void reward_progress() override;
 
@@ -84,6 +157,8 @@ protected:
 public:
 	explicit ReorderingDynamicExpectedEffortSearch(const options::Options &opts);
 	virtual ~ReorderingDynamicExpectedEffortSearch() = default;
+
+	void print_statistics() const override;
 };
 } // namespace bounded_suboptimal_search
 
@@ -0,0 +1,36 @@
+#ifndef BOUNDED_SUBOPTIMAL_SEARCH_STATE_HEAP_H
+#define BOUNDED_SUBOPTIMAL_SEARCH_STATE_HEAP_H
+
+#include <functional>
+#include <string>
+
+#include "../algorithms/indexed_heap.h"
+#include "../per_state_information.h"
+#include "../state_id.h"
+
+namespace bounded_suboptimal_search {
+/*
+  Positions of the states of one registry in indexed heaps (see
+  algorithms/indexed_heap.h), stored as a field of the per-state records
+  instead of in a hash map.
+*/
+class StateHeapPositions {
+	const StateRegistry &state_registry;
+	PerStateInformation<int> positions;
+
+public:
+	StateHeapPositions(const StateRegistry &state_registry, const std::string &name)
+		: state_registry(state_registry), positions(-1, name, true) {}
+
+	StateHeapPositions(const StateHeapPositions &other) = delete;
+	auto operator=(const StateHeapPositions &other) -> StateHeapPositions & = delete;
+
+	auto operator[](StateID id) -> int & { return positions.get(state_registry, id); }
+};
+
+// heap of states whose top is the state with the minimal key with respect to Compare
+template <class Key, class Compare = std::less<Key>>
+using StateHeap = indexed_heap::IndexedHeap<Key, StateID, StateHeapPositions, Compare>;
+} // namespace bounded_suboptimal_search
+
+#endif
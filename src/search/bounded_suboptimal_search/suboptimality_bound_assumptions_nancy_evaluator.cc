@@ -1,6 +1,8 @@
 #include "suboptimality_bound_assumptions_nancy_evaluator.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "../evaluation_context.h"
 #include "../option_parser.h"
@@ -8,10 +10,6 @@
 #include "../suboptimal_search/util.h"
 
 namespace bounded_suboptimal_search {
-auto NancyAssumptionsSBSEvaluator::cumulative_distribution(double x) -> double {
-	return (1 + std::erf(x / std::sqrt(2.))) / 2.;
-}
-
 NancyAssumptionsSBSEvaluator::NancyAssumptionsSBSEvaluator(const options::Options &opts)
 	: floating_point_evaluator::FloatingPointEvaluator(opts),
 	  suboptimality_factor(opts.get<double>("suboptimality_factor")),
@@ -22,80 +20,124 @@ NancyAssumptionsSBSEvaluator::NancyAssumptionsSBSEvaluator(const options::Option
 	  heuristic_error(opts.get<std::shared_ptr<heuristic_error::HeuristicError>>("heuristic_error")),
 	  use_online_variance(opts.get<bool>("use_online_variance")),
 	  admissible_h(opts.get<bool>("admissible_h")),
-	  cost_bound_variance_method(opts.get<CostBoundVarianceMethod>("cost_bound_variance_method")) {}
+	  cost_bound_variance_method(opts.get<CostBoundVarianceMethod>("cost_bound_variance_method")),
+	  normal_cdf_method(opts.get<suboptimal_search::NormalCDFMethod>("normal_cdf", suboptimal_search::NormalCDFMethod::ERF)),
+	  cdf_buffer(),
+	  cdf_lower_bound_buffer() {}
 
 auto NancyAssumptionsSBSEvaluator::compute_value(EvaluationContext &eval_context) -> double {
 	if (eval_context.is_evaluator_value_infinite(f_evaluator.get()))
 		return DEAD_END;
 
-	const auto f = eval_context.get_evaluator_value(f_evaluator.get());
+	const auto f = static_cast<double>(eval_context.get_evaluator_value(f_evaluator.get()));
+	const auto g = static_cast<double>(eval_context.get_g_value());
 	const auto f_hat = f_hat_evaluator->compute_result(eval_context);
 	assert(!FloatingPointEvaluator::is_dead_end(f_hat));
-	const auto f_hat_min = f_hat_min_evaluator->get_f_hat_min();
+	const auto d_hat = d_hat_evaluator->compute_result(eval_context);
+	assert(!FloatingPointEvaluator::is_dead_end(d_hat));
+	auto value = 0.;
+	compute_values(&f, &g, &f_hat, &d_hat, &value, 1);
+	return value;
+}
 
-	if (std::isinf(f_hat_min) || std::isinf(f_hat))
-		// the heuristic error is likely not yet initialized in this case
+auto NancyAssumptionsSBSEvaluator::get_cost_bound_stddev() const -> double {
+	switch (cost_bound_variance_method) {
+	case CostBoundVarianceMethod::HEURISTIC_ERROR:
+		return std::sqrt(heuristic_error->get_heuristic_error_variance() * f_hat_min_evaluator->get_d_hat());
+	case CostBoundVarianceMethod::F_MIN_VARIANCE:
+		return std::sqrt(f_hat_min_evaluator->get_variance());
+	case CostBoundVarianceMethod::F_MIN_VARIANCE_TIMES_DISTANCE:
+		return std::sqrt(f_hat_min_evaluator->get_variance() * f_hat_min_evaluator->get_d_hat());
+	case CostBoundVarianceMethod::ZERO:
+	case CostBoundVarianceMethod::ZERO_IMPROVED:
 		return 0.;
+	}
+	utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+}
+
+void NancyAssumptionsSBSEvaluator::compute_values(const double *f, const double *g, const double *f_hat, const double *d_hat, double *values,
+                                                  std::size_t n) const {
+	const auto f_hat_min = f_hat_min_evaluator->get_f_hat_min();
+	if (std::isinf(f_hat_min)) {
+		// the heuristic error is likely not yet initialized in this case
+		std::fill(values, values + n, 0.);
+		return;
+	}
 
 	// belief distribution about the solution cost (f-hat)
-	const auto solution_cost_mean = static_cast<double>(f_hat);
-	assert(!FloatingPointEvaluator::is_dead_end(d_hat_evaluator->compute_result(eval_context)));
-	const auto solution_cost_stddev = use_online_variance
-	                                        ? std::sqrt(heuristic_error->get_heuristic_error_variance() * d_hat_evaluator->compute_result(eval_context))
-	                                        : std::abs(f_hat - f) / 2;
-	assert(solution_cost_stddev >= 0.);
+	const auto heuristic_error_variance = heuristic_error->get_heuristic_error_variance();
+	const auto solution_cost_stddev = [this, f, f_hat, d_hat, heuristic_error_variance](std::size_t i) {
+		return use_online_variance ? std::sqrt(heuristic_error_variance * d_hat[i]) : std::abs(f_hat[i] - f[i]) / 2;
+	};
 
 	// belief distribution about the cost bound
 	const auto cost_bound_mean = suboptimality_factor * f_hat_min;
-	auto cost_bound_stddev = 0.;
-	switch (cost_bound_variance_method) {
-	case CostBoundVarianceMethod::HEURISTIC_ERROR:
-		cost_bound_stddev = std::sqrt(heuristic_error->get_heuristic_error_variance() * f_hat_min_evaluator->get_d_hat());
-		break;
-	case CostBoundVarianceMethod::F_MIN_VARIANCE:
-		cost_bound_stddev = std::sqrt(f_hat_min_evaluator->get_variance());
-		break;
-	case CostBoundVarianceMethod::F_MIN_VARIANCE_TIMES_DISTANCE:
-		cost_bound_stddev = std::sqrt(f_hat_min_evaluator->get_variance() * f_hat_min_evaluator->get_d_hat());
-		break;
-	case CostBoundVarianceMethod::ZERO:
-		cost_bound_stddev = 0.;
-		break;
-	case CostBoundVarianceMethod::ZERO_IMPROVED: {
-		if (solution_cost_stddev == 0.)
-			return solution_cost_mean <= cost_bound_mean ? 1. : 0.;
-		const auto lower_bound = admissible_h ? f : eval_context.get_g_value();
-		const auto cdf_xi = cumulative_distribution((cost_bound_mean - solution_cost_mean) / solution_cost_stddev);
-		const auto cdf_alpha = cumulative_distribution((lower_bound - solution_cost_mean) / solution_cost_stddev);
+	if (cost_bound_variance_method == CostBoundVarianceMethod::ZERO_IMPROVED) {
+		// truncated gaussian: (cdf(xi) - cdf(alpha)) / (1 - cdf(alpha)); the degenerate cases are encoded as infinite arguments
+		constexpr auto inf = std::numeric_limits<double>::infinity();
+		cdf_buffer.resize(n);
+		cdf_lower_bound_buffer.resize(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			cdf_lower_bound_buffer[i] = -inf;
+			if (std::isinf(f_hat[i])) {
+				cdf_buffer[i] = -inf;
+				continue;
+			}
+			const auto stddev = solution_cost_stddev(i);
+			if (stddev == 0.) {
+				cdf_buffer[i] = f_hat[i] <= cost_bound_mean ? inf : -inf;
+				continue;
+			}
+			const auto lower_bound = admissible_h ? f[i] : g[i];
+			cdf_buffer[i] = (cost_bound_mean - f_hat[i]) / stddev;
+			cdf_lower_bound_buffer[i] = (lower_bound - f_hat[i]) / stddev;
+		}
+		suboptimal_search::normal_cdf(cdf_buffer.data(), cdf_buffer.data(), n, normal_cdf_method);
+		suboptimal_search::normal_cdf(cdf_lower_bound_buffer.data(), cdf_lower_bound_buffer.data(), n, normal_cdf_method);
+		for (std::size_t i = 0; i < n; ++i) {
+			const auto cdf_xi = cdf_buffer[i];
+			const auto cdf_alpha = cdf_lower_bound_buffer[i];
+			values[i] = (cdf_xi - cdf_alpha) / (1 - cdf_alpha);
 #ifndef NDEBUG
-		const auto is_valid_probility = [](double p) {
-			return p >= 0. && p <= 1.;
-		};
-		std::cout << "g=" << eval_context.get_g_value() << ", f=" << f << ", fhat=" << f_hat << ", p=" << (cdf_xi - cdf_alpha) / (1 - cdf_alpha) << std::endl;
-		assert(is_valid_probility(cdf_xi));
-		assert(is_valid_probility(cdf_alpha));
-		assert(is_valid_probility((cdf_xi - cdf_alpha) / (1 - cdf_alpha)));
+			const auto is_valid_probility = [](double p) {
+				return p >= 0. && p <= 1.;
+			};
+			std::cout << "g=" << g[i] << ", f=" << f[i] << ", fhat=" << f_hat[i] << ", p=" << values[i] << std::endl;
+			assert(is_valid_probility(cdf_xi));
+			assert(is_valid_probility(cdf_alpha));
+			assert(is_valid_probility(values[i]));
 #endif
-		return (cdf_xi - cdf_alpha) / (1 - cdf_alpha);
-	}
-	default:
-		utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+		}
+		return;
 	}
+	const auto cost_bound_stddev = get_cost_bound_stddev();
 	assert(cost_bound_stddev >= 0.);
+	const auto cost_bound_variance = cost_bound_stddev * cost_bound_stddev;
 
+	// arguments of the normal CDF; the degenerate cases are encoded as infinite arguments
+	constexpr auto inf = std::numeric_limits<double>::infinity();
+	cdf_buffer.resize(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		if (std::isinf(f_hat[i])) {
+			cdf_buffer[i] = inf;
+			continue;
+		}
+		const auto stddev_i = solution_cost_stddev(i);
+		assert(stddev_i >= 0.);
 
-	// distribution describing the difference between the two distributions
-	const auto mean = cost_bound_mean - solution_cost_mean;
-	const auto stddev = std::sqrt(cost_bound_stddev * cost_bound_stddev + solution_cost_stddev * solution_cost_stddev);
-	assert(stddev >= 0.);
-
-	if (stddev == 0.)
-		return mean >= 0. ? 1. : 0.;
+		// distribution describing the difference between the two distributions
+		const auto mean = cost_bound_mean - f_hat[i];
+		const auto stddev = std::sqrt(cost_bound_variance + stddev_i * stddev_i);
+		assert(stddev >= 0.);
+		cdf_buffer[i] = stddev == 0. ? (mean >= 0. ? -inf : inf) : -mean / stddev;
+	}
+	suboptimal_search::normal_cdf(cdf_buffer.data(), cdf_buffer.data(), n, normal_cdf_method);
 
 	// the probability that the solution will be within the bound is the probability mass above zero
-	const auto p_geq_zero = 1 - cumulative_distribution(-mean / stddev);
-	assert(p_geq_zero >= 0. && p_geq_zero <= 1.);
-	return p_geq_zero;
+	for (std::size_t i = 0; i < n; ++i) {
+		values[i] = 1 - cdf_buffer[i];
+		assert(values[i] >= 0. && values[i] <= 1.);
+	}
 }
 
 static auto _parse(OptionParser &parser) -> std::shared_ptr<floating_point_evaluator::FloatingPointEvaluator> {
@@ -109,6 +151,7 @@ static auto _parse(OptionParser &parser) -> std::shared_ptr<floating_point_evalu
 	parser.add_enum_option<NancyAssumptionsSBSEvaluator::CostBoundVarianceMethod>("cost_bound_variance_method", {"HEURISTIC_ERROR", "F_MIN_VARIANCE"},
 	                                                                              "how to model the variance of the cost bound", "F_MIN_VARIANCE");
 	suboptimal_search::add_online_variance_option(parser);
+	suboptimal_search::add_normal_cdf_option(parser);
 	Options opts = parser.parse();
 	if (parser.dry_run() || parser.help_mode())
 		return nullptr;
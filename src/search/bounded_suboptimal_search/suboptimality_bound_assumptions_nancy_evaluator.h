@@ -1,8 +1,11 @@
 #ifndef BOUNDED_SUBOPTIMAL_SEARCH_SUBOPTIMALITY_BOUND_ASSUMPTIONS_NANCY_EVALUATOR_H
 #define BOUNDED_SUBOPTIMAL_SEARCH_SUBOPTIMALITY_BOUND_ASSUMPTIONS_NANCY_EVALUATOR_H
 
+#include <vector>
+
 #include "../floating_point_evaluator/floating_point_evaluator.h"
 #include "../heuristic_error/heuristic_error.h"
+#include "../suboptimal_search/normal_distribution.h"
 #include "f_hat_min_evaluator.h"
 
 class Evaluator;
@@ -23,14 +26,33 @@ protected:
 	const bool admissible_h;
 
 	const CostBoundVarianceMethod cost_bound_variance_method;
+	const suboptimal_search::NormalCDFMethod normal_cdf_method;
 
-	static auto cumulative_distribution(double x) -> double;
+	// arguments (and afterwards values) of the normal CDF evaluations in compute_values
+	mutable std::vector<double> cdf_buffer;
+	mutable std::vector<double> cdf_lower_bound_buffer;
 
 	auto compute_value(EvaluationContext &eval_context) -> double override;
 
 public:
 	explicit NancyAssumptionsSBSEvaluator(const options::Options &opts);
 	~NancyAssumptionsSBSEvaluator() override = default;
+
+	/*
+	  Compute the probability values for n nodes given as structure of arrays of
+	  their f, g, f-hat and d-hat values. This is equivalent to calling
+	  compute_value for each node, but the terms that only depend on f-hat-min
+	  and the heuristic error are computed once for the whole batch and the
+	  normal CDF is evaluated for all nodes at once.
+	*/
+	void compute_values(const double *f, const double *g, const double *f_hat, const double *d_hat, double *values, std::size_t n) const;
+
+	// standard deviation of the belief distribution about the cost bound (zero for ZERO_IMPROVED, which truncates the distributions instead)
+	auto get_cost_bound_stddev() const -> double;
+
+	auto get_suboptimality_factor() const -> double { return suboptimality_factor; }
+	auto get_cost_bound_variance_method() const -> CostBoundVarianceMethod { return cost_bound_variance_method; }
+	auto uses_online_variance() const -> bool { return use_online_variance; }
 };
 } // namespace bounded_suboptimal_search
 
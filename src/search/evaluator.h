@@ -4,6 +4,7 @@
 #include "evaluation_result.h"
 
 #include <set>
+#include <vector>
 
 class EvaluationContext;
 class GlobalState;
@@ -76,6 +77,16 @@ public:
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) = 0;
 
+    /*
+      compute_batch may compute the estimates of several states at once
+      (e.g. of all new successors of an expanded state) if this is
+      cheaper than computing them one by one. The results are used by
+      subsequent compute_result calls for these states. The default
+      implementation does nothing.
+    */
+    virtual void compute_batch(const std::vector<GlobalState> & /*states*/) {
+    }
+
     void report_value_for_initial_state(const EvaluationResult &result) const;
     void report_new_minimum_value(const EvaluationResult &result) const;
 
@@ -14,7 +14,7 @@ auto FloatingPointEvaluator::get_default_options() -> options::Options {
 }
 
 FloatingPointEvaluator::FloatingPointEvaluator(const options::Options &opts)
-	: cache(std::numeric_limits<double>::quiet_NaN()), cache_evaluator_values(opts.get<bool>("cache_estimates")) {}
+	: cache(std::numeric_limits<double>::quiet_NaN(), "floating-point evaluator cache", opts.get<bool>("cache_estimates")), cache_evaluator_values(opts.get<bool>("cache_estimates")) {}
 
 auto FloatingPointEvaluator::compute_result(EvaluationContext &eval_context) -> double {
 	const auto &global_state = eval_context.get_state();
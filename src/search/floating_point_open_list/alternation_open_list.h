@@ -7,7 +7,7 @@
 
 namespace floating_point_open_list {
 template <std::size_t N, class T>
-class AlternationOpenList : public FloatingPointOpenList<N, T> {
+class AlternationOpenList final : public FloatingPointOpenList<N, T> {
 	const int boost_amount;
 
 	struct sublist_type {
@@ -31,12 +31,14 @@ public:
 	[[nodiscard]] auto top() const -> const value_type & override;
 	[[nodiscard]] auto top_key() const -> const key_type & override;
 	[[nodiscard]] auto empty() const -> bool override;
+	[[nodiscard]] auto size() const -> std::size_t override;
 	void push(const key_type &key, const T &value, bool preferred) override;
 	void emplace(const key_type &key, T &&value, bool preferred) override;
 	void push_focal(double key, const T &value, bool preferred) override;
 	void emplace_focal(double key, T &&value, bool preferred) override;
 	void pop() override;
 	void boost_preferred() override;
+	auto remove_stale(const std::function<bool(const value_type &)> &is_stale) -> std::size_t override;
 
 	AlternationOpenList(int boost_amount, std::vector<std::unique_ptr<FloatingPointOpenList<N, T>>> &&sublists, std::vector<std::unique_ptr<FloatingPointOpenList<N, T>>> &&preferred_sublists)
 		: FloatingPointOpenList<N, T>(), boost_amount(boost_amount), sublists(initialize_sublists(std::move(sublists), std::move(preferred_sublists))) {}
@@ -78,6 +80,14 @@ auto AlternationOpenList<N, T>::empty() const -> bool {
 	return get_best_list().open_list->empty();
 }
 
+template <std::size_t N, class T>
+auto AlternationOpenList<N, T>::size() const -> std::size_t {
+	auto size = std::size_t{0};
+	for (const auto &sublist : sublists)
+		size += sublist.open_list->size();
+	return size;
+}
+
 template <std::size_t N, class T>
 void AlternationOpenList<N, T>::push(const key_type &key, const T &value, bool preferred) {
 	for (auto &sublist : sublists)
@@ -119,6 +129,14 @@ void AlternationOpenList<N, T>::boost_preferred() {
 		if (sublist.only_preferred)
 			sublist.priority -= boost_amount;
 }
+
+template <std::size_t N, class T>
+auto AlternationOpenList<N, T>::remove_stale(const std::function<bool(const value_type &)> &is_stale) -> std::size_t {
+	auto removed = std::size_t{0};
+	for (auto &sublist : sublists)
+		removed += sublist.open_list->remove_stale(is_stale);
+	return removed;
+}
 } // namespace floating_point_open_list
 
 #endif
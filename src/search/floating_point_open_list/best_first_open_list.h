@@ -1,31 +1,51 @@
 #ifndef FLOATING_POINT_OPEN_LIST_BEST_FIRST_OPEN_LIST_H
 #define FLOATING_POINT_OPEN_LIST_BEST_FIRST_OPEN_LIST_H
 
-#include <queue>
+#include <algorithm>
+#include <vector>
 
 #include "floating_point_open_list.h"
 
 namespace floating_point_open_list {
-template <std::size_t N, class T>
-class BestFirstOpenList : public FloatingPointOpenList<N, T> {
+// Compare is a (key, value) pair comparator with the semantics of std::priority_queue (i.e. the greatest element w.r.t. Compare is on top);
+// the default comparator is inlined, while a type-erased comparator (e.g. std::function) can be used if the comparison has to be selected at runtime
+template <std::size_t N, class T, class Compare = KeyGreater<N, T>>
+class BestFirstOpenList final : public FloatingPointOpenList<N, T> {
 	using typename FloatingPointOpenList<N, T>::internal_value_type;
-	using typename FloatingPointOpenList<N, T>::compare_type;
 
-	std::priority_queue<internal_value_type, std::vector<internal_value_type>, compare_type> queue;
+	// binary heap managed with the std heap algorithms (equivalent to std::priority_queue, but allows access to the entries)
+	std::vector<internal_value_type> heap;
+	Compare compare;
 
 public:
 	using typename FloatingPointOpenList<N, T>::key_type;
 	using typename FloatingPointOpenList<N, T>::value_type;
 
-	[[nodiscard]] auto top() const -> const value_type & override { return queue.top().second; }
-	[[nodiscard]] auto top_key() const -> const key_type & override { return queue.top().first; }
-	[[nodiscard]] auto empty() const -> bool override { return queue.empty(); }
-	void push(const key_type &key, const value_type &value, bool) override { queue.push({key, value}); }
-	void emplace(const key_type &key, value_type &&value, bool) override { queue.emplace(key, value); }
-	void pop() override { queue.pop(); }
-
-	BestFirstOpenList() : BestFirstOpenList(FloatingPointOpenList<N, T>::get_default_compare()) {}
-	explicit BestFirstOpenList(compare_type compare) : FloatingPointOpenList<N, T>(), queue(compare) {}
+	[[nodiscard]] auto top() const -> const value_type & override { return heap.front().second; }
+	[[nodiscard]] auto top_key() const -> const key_type & override { return heap.front().first; }
+	[[nodiscard]] auto empty() const -> bool override { return heap.empty(); }
+	[[nodiscard]] auto size() const -> std::size_t override { return heap.size(); }
+	void push(const key_type &key, const value_type &value, bool) override {
+		heap.emplace_back(key, value);
+		std::push_heap(std::begin(heap), std::end(heap), compare);
+	}
+	void emplace(const key_type &key, value_type &&value, bool) override {
+		heap.emplace_back(key, std::move(value));
+		std::push_heap(std::begin(heap), std::end(heap), compare);
+	}
+	void pop() override {
+		std::pop_heap(std::begin(heap), std::end(heap), compare);
+		heap.pop_back();
+	}
+	auto remove_stale(const std::function<bool(const value_type &)> &is_stale) -> std::size_t override {
+		const auto removed = remove_stale_and_duplicate_entries(heap, [this](const auto &lhs, const auto &rhs) { return compare(rhs, lhs); }, is_stale);
+		std::make_heap(std::begin(heap), std::end(heap), compare);
+		heap.shrink_to_fit();
+		return removed;
+	}
+
+	BestFirstOpenList() : BestFirstOpenList(Compare()) {}
+	explicit BestFirstOpenList(Compare compare) : FloatingPointOpenList<N, T>(), compare(std::move(compare)) {}
 };
 } // namespace floating_point_open_list
 
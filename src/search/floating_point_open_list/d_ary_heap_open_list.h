@@ -0,0 +1,209 @@
+#ifndef FLOATING_POINT_OPEN_LIST_D_ARY_HEAP_OPEN_LIST_H
+#define FLOATING_POINT_OPEN_LIST_D_ARY_HEAP_OPEN_LIST_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include "floating_point_open_list.h"
+
+namespace floating_point_open_list {
+/*
+  Best-first open list based on a D-ary min-heap.
+
+  Keys and values are stored in separate arrays (structure of arrays) instead
+  of an array of (key, value) pairs. This avoids padding and keeps the keys
+  that are compared during sift-down close together in memory. Additionally,
+  a higher arity reduces the depth of the heap and therefore the number of
+  (cache-missing) levels touched by pop.
+
+  If compress_primary_key is set, the first key is stored as a float and only
+  the tie-breaking keys are stored as doubles. This reduces the memory per
+  entry, but keys that differ only beyond single precision are considered
+  equal for the primary comparison (they are still ordered by the tie-breaking
+  keys). Finite keys beyond the range of float are stored as the largest
+  (or smallest) float.
+*/
+template <std::size_t N, class T, std::size_t D = 4, bool compress_primary_key = false>
+class DAryHeapOpenList final : public FloatingPointOpenList<N, T> {
+	static_assert(D >= 2, "The heap arity must be at least two.");
+
+public:
+	using typename FloatingPointOpenList<N, T>::key_type;
+	using typename FloatingPointOpenList<N, T>::value_type;
+
+private:
+	using primary_key_type = std::conditional_t<compress_primary_key, float, double>;
+	using secondary_key_type = std::array<double, N - 1>;
+
+	std::vector<primary_key_type> primary_keys;
+	std::vector<secondary_key_type> secondary_keys; // unused if N == 1
+	std::vector<value_type> values;
+
+	// materialized key of the top entry (only needed for top_key)
+	mutable key_type top_key_buffer;
+
+	// lexicographical comparison with the same semantics as KeyGreater (i.e. operator< of std::array)
+	static auto is_less(primary_key_type lhs_primary, const secondary_key_type &lhs_secondary, primary_key_type rhs_primary,
+	                    const secondary_key_type &rhs_secondary) -> bool {
+		if (lhs_primary < rhs_primary)
+			return true;
+		if (rhs_primary < lhs_primary)
+			return false;
+		for (std::size_t i = 0; i < N - 1; ++i) {
+			if (lhs_secondary[i] < rhs_secondary[i])
+				return true;
+			if (rhs_secondary[i] < lhs_secondary[i])
+				return false;
+		}
+		return false;
+	}
+
+	auto secondary_key(std::size_t index) const -> const secondary_key_type & {
+		if constexpr (N > 1) {
+			return secondary_keys[index];
+		} else {
+			static const auto empty = secondary_key_type();
+			return empty;
+		}
+	}
+
+	void move_entry(std::size_t from, std::size_t to) {
+		primary_keys[to] = primary_keys[from];
+		if constexpr (N > 1)
+			secondary_keys[to] = secondary_keys[from];
+		values[to] = std::move(values[from]);
+	}
+
+	void set_entry(std::size_t index, primary_key_type primary, const secondary_key_type &secondary, value_type &&value) {
+		primary_keys[index] = primary;
+		if constexpr (N > 1)
+			secondary_keys[index] = secondary;
+		values[index] = std::move(value);
+	}
+
+	void sift_up(std::size_t hole, primary_key_type primary, const secondary_key_type &secondary, value_type &&value) {
+		while (hole > 0) {
+			const auto parent = (hole - 1) / D;
+			if (!is_less(primary, secondary, primary_keys[parent], secondary_key(parent)))
+				break;
+			move_entry(parent, hole);
+			hole = parent;
+		}
+		set_entry(hole, primary, secondary, std::move(value));
+	}
+
+	void sift_down(std::size_t hole, primary_key_type primary, const secondary_key_type &secondary, value_type &&value) {
+		const auto size = values.size();
+		while (true) {
+			const auto first_child = D * hole + 1;
+			if (first_child >= size)
+				break;
+			const auto last_child = std::min(first_child + D, size);
+			auto best_child = first_child;
+			for (auto child = first_child + 1; child < last_child; ++child)
+				if (is_less(primary_keys[child], secondary_key(child), primary_keys[best_child], secondary_key(best_child)))
+					best_child = child;
+			if (!is_less(primary_keys[best_child], secondary_key(best_child), primary, secondary))
+				break;
+			move_entry(best_child, hole);
+			hole = best_child;
+		}
+		set_entry(hole, primary, secondary, std::move(value));
+	}
+
+	static auto get_primary_key(double key) -> primary_key_type {
+		if constexpr (compress_primary_key) {
+			// converting a finite double outside of the range of float is undefined behavior
+			constexpr auto max_key = static_cast<double>(std::numeric_limits<float>::max());
+			if (std::isfinite(key))
+				return static_cast<float>(std::clamp(key, -max_key, max_key));
+		}
+		return static_cast<primary_key_type>(key);
+	}
+
+	void insert(const key_type &key, value_type &&value) {
+		auto secondary = secondary_key_type();
+		std::copy(std::next(std::begin(key)), std::end(key), std::begin(secondary));
+		const auto primary = get_primary_key(key[0]);
+		primary_keys.emplace_back();
+		if constexpr (N > 1)
+			secondary_keys.emplace_back();
+		// the new slot is the hole that is sifted up
+		values.emplace_back(std::move(value));
+		auto new_value = std::move(values.back());
+		sift_up(values.size() - 1, primary, secondary, std::move(new_value));
+	}
+
+public:
+	[[nodiscard]] auto top() const -> const value_type & override {
+		assert(!values.empty());
+		return values.front();
+	}
+	[[nodiscard]] auto top_key() const -> const key_type & override {
+		assert(!values.empty());
+		top_key_buffer[0] = static_cast<double>(primary_keys.front());
+		const auto &secondary = secondary_key(0);
+		std::copy(std::begin(secondary), std::end(secondary), std::next(std::begin(top_key_buffer)));
+		return top_key_buffer;
+	}
+	[[nodiscard]] auto empty() const -> bool override { return values.empty(); }
+	[[nodiscard]] auto size() const -> std::size_t override { return values.size(); }
+	void push(const key_type &key, const value_type &value, bool) override { insert(key, value_type(value)); }
+	void emplace(const key_type &key, value_type &&value, bool) override { insert(key, std::move(value)); }
+	void pop() override {
+		assert(!values.empty());
+		const auto last = values.size() - 1;
+		const auto primary = primary_keys[last];
+		const auto secondary = secondary_key(last);
+		auto value = std::move(values[last]);
+		primary_keys.pop_back();
+		if constexpr (N > 1)
+			secondary_keys.pop_back();
+		values.pop_back();
+		if (!values.empty())
+			sift_down(0, primary, secondary, std::move(value));
+	}
+
+	auto remove_stale(const std::function<bool(const value_type &)> &is_stale) -> std::size_t override {
+		// sort the entries by key (a sorted array is a valid heap), keeping only the first occurrence of each non-stale value
+		auto order = std::vector<std::size_t>(values.size());
+		std::iota(std::begin(order), std::end(order), 0);
+		std::sort(std::begin(order), std::end(order), [this](const auto lhs, const auto rhs) {
+			return is_less(primary_keys[lhs], secondary_key(lhs), primary_keys[rhs], secondary_key(rhs));
+		});
+		auto seen = std::unordered_set<value_type>();
+		auto new_primary_keys = std::vector<primary_key_type>();
+		auto new_secondary_keys = std::vector<secondary_key_type>();
+		auto new_values = std::vector<value_type>();
+		for (const auto index : order) {
+			if (is_stale(values[index]) || !seen.insert(values[index]).second)
+				continue;
+			new_primary_keys.push_back(primary_keys[index]);
+			if constexpr (N > 1)
+				new_secondary_keys.push_back(secondary_keys[index]);
+			new_values.push_back(std::move(values[index]));
+		}
+		const auto removed = values.size() - new_values.size();
+		primary_keys = std::move(new_primary_keys);
+		secondary_keys = std::move(new_secondary_keys);
+		values = std::move(new_values);
+		return removed;
+	}
+
+	// number of bytes used per entry (excluding unused capacity)
+	static constexpr auto bytes_per_entry() -> std::size_t {
+		return sizeof(primary_key_type) + (N > 1 ? sizeof(secondary_key_type) : 0) + sizeof(value_type);
+	}
+
+	DAryHeapOpenList() : FloatingPointOpenList<N, T>(), top_key_buffer() {}
+};
+} // namespace floating_point_open_list
+
+#endif
@@ -1,12 +1,44 @@
 #ifndef FLOATING_POINT_OPEN_LIST_FLOATING_POINT_OPEN_LIST_H
 #define FLOATING_POINT_OPEN_LIST_FLOATING_POINT_OPEN_LIST_H
 
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "../utils/system.h"
 
 namespace floating_point_open_list {
+// lexicographical comparison of (key, value) pairs by key for std::priority_queue-based open lists, i.e. the smallest key is on top
+// (same semantics as operator> of std::array, but can be inlined by the compiler)
+template <std::size_t N, class T>
+struct KeyGreater {
+	auto operator()(const std::pair<std::array<double, N>, T> &lhs, const std::pair<std::array<double, N>, T> &rhs) const -> bool {
+		for (std::size_t i = 0; i < N; ++i) {
+			if (rhs.first[i] < lhs.first[i])
+				return true;
+			if (lhs.first[i] < rhs.first[i])
+				return false;
+		}
+		return false;
+	}
+};
+
+// sort the entries by the given (strict weak) order and remove stale entries as well as all but the first (best) entry for each value
+// returns the number of removed entries; afterwards, the entries are sorted (which is in particular a valid heap)
+template <class Entry, class Less, class IsStale>
+auto remove_stale_and_duplicate_entries(std::vector<Entry> &entries, Less less, const IsStale &is_stale) -> std::size_t {
+	std::sort(std::begin(entries), std::end(entries), less);
+	auto seen = std::unordered_set<typename Entry::second_type>();
+	const auto old_size = entries.size();
+	entries.erase(std::remove_if(std::begin(entries), std::end(entries),
+	                             [&seen, &is_stale](const auto &entry) { return is_stale(entry.second) || !seen.insert(entry.second).second; }),
+	              std::end(entries));
+	return old_size - entries.size();
+}
+
 template <std::size_t N, class T>
 class FloatingPointOpenList {
 	static_assert(N > 0, "The open list must have at least one key.");
@@ -22,6 +54,9 @@ public:
 
 protected:
 	using internal_value_type = std::pair<key_type, value_type>;
+
+public:
+	// type-erased comparator for open lists that select their comparison function at runtime
 	using compare_type = std::function<bool(const internal_value_type &, const internal_value_type &)>;
 
 	// default comparison function for open lists based on std::priority_queue (lexicographical comparison)
@@ -38,6 +73,7 @@ public:
 		utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
 	}
 	[[nodiscard]] virtual auto empty() const -> bool = 0;
+	[[nodiscard]] virtual auto size() const -> std::size_t = 0;
 	virtual void push(const key_type &key, const value_type &value, bool preferred) = 0;
 	virtual void emplace(const key_type &key, value_type &&value, bool preferred) = 0;
 	virtual void push_focal(double, const value_type &, bool) { not_focal(); }
@@ -45,6 +81,10 @@ public:
 	virtual void pop() = 0;
 	virtual void boost_preferred() {}
 
+	// lazy deletion support: remove all entries with stale values and all but the best entry of each value (requires std::hash<T>)
+	// returns the number of removed entries
+	virtual auto remove_stale(const std::function<bool(const value_type &)> &is_stale) -> std::size_t = 0;
+
 	FloatingPointOpenList() = default;
 	virtual ~FloatingPointOpenList() = default;
 
@@ -1,39 +1,68 @@
 #ifndef FLOATING_POINT_OPEN_LIST_FOCAL_OPEN_LIST_H
 #define FLOATING_POINT_OPEN_LIST_FOCAL_OPEN_LIST_H
 
-#include <queue>
+#include <algorithm>
+#include <vector>
 
 #include "floating_point_open_list.h"
 
 namespace floating_point_open_list {
-template <std::size_t N, class T>
-class FocalOpenList : public FloatingPointOpenList<N, T> {
+template <class T>
+struct FocalKeyGreater {
+	auto operator()(const std::pair<double, T> &lhs, const std::pair<double, T> &rhs) const -> bool { return lhs.first > rhs.first; }
+};
+
+template <std::size_t N, class T, class Compare = KeyGreater<N, T>, class FocalCompare = FocalKeyGreater<T>>
+class FocalOpenList final : public FloatingPointOpenList<N, T> {
 	using typename FloatingPointOpenList<N, T>::internal_value_type;
-	using typename FloatingPointOpenList<N, T>::compare_type;
 	using focal_internal_value_type = std::pair<double, T>;
-	using focal_compare_type = std::function<bool(const focal_internal_value_type &, const focal_internal_value_type &)>;
 
-	std::priority_queue<internal_value_type, std::vector<internal_value_type>, compare_type> queue;
-	std::priority_queue<focal_internal_value_type, std::vector<focal_internal_value_type>, focal_compare_type> focal;
+	// binary heaps managed with the std heap algorithms (see BestFirstOpenList)
+	std::vector<internal_value_type> queue;
+	std::vector<focal_internal_value_type> focal;
+	Compare compare;
+	FocalCompare compare_focal;
+
+	template <class Entry, class HeapCompare>
+	static void push_heap(std::vector<Entry> &heap, Entry &&entry, HeapCompare &heap_compare) {
+		heap.push_back(std::move(entry));
+		std::push_heap(std::begin(heap), std::end(heap), heap_compare);
+	}
 
-	static constexpr auto focal_default_compare = [](const auto &lhs, const auto &rhs) {
-		return lhs.first > rhs.first;
-	};
+	template <class Entry, class HeapCompare>
+	static void pop_heap(std::vector<Entry> &heap, HeapCompare &heap_compare) {
+		std::pop_heap(std::begin(heap), std::end(heap), heap_compare);
+		heap.pop_back();
+	}
+
+	template <class Entry, class HeapCompare, class IsStale>
+	static auto remove_stale(std::vector<Entry> &heap, HeapCompare &heap_compare, const IsStale &is_stale) -> std::size_t {
+		const auto removed =
+				remove_stale_and_duplicate_entries(heap, [&heap_compare](const auto &lhs, const auto &rhs) { return heap_compare(rhs, lhs); }, is_stale);
+		std::make_heap(std::begin(heap), std::end(heap), heap_compare);
+		heap.shrink_to_fit();
+		return removed;
+	}
 
 public:
 	using typename FloatingPointOpenList<N, T>::key_type;
 	using typename FloatingPointOpenList<N, T>::value_type;
 
-	[[nodiscard]] auto top() const -> const value_type & override { return !focal.empty() ? focal.top().second : queue.top().second; }
+	[[nodiscard]] auto top() const -> const value_type & override { return !focal.empty() ? focal.front().second : queue.front().second; }
 	[[nodiscard]] auto empty() const -> bool override { return focal.empty() && queue.empty(); }
-	void push(const key_type &key, const value_type &value, bool) override { queue.push({key, value}); }
-	void emplace(const key_type &key, value_type &&value, bool) override { queue.emplace(key, value); }
-	void push_focal(double key, const value_type &value, bool) override { focal.push({key, value}); }
-	void emplace_focal(double key, value_type &&value, bool) override { focal.emplace(key, value); }
-	void pop() override { if (!focal.empty()) focal.pop(); else queue.pop(); }
-
-	FocalOpenList() : FocalOpenList(FloatingPointOpenList<N, T>::get_default_compare(), focal_default_compare) {}
-	FocalOpenList(compare_type compare, focal_compare_type compare_focal) : FloatingPointOpenList<N, T>(), queue(compare), focal(compare_focal) {}
+	[[nodiscard]] auto size() const -> std::size_t override { return focal.size() + queue.size(); }
+	void push(const key_type &key, const value_type &value, bool) override { push_heap(queue, internal_value_type(key, value), compare); }
+	void emplace(const key_type &key, value_type &&value, bool) override { push_heap(queue, internal_value_type(key, std::move(value)), compare); }
+	void push_focal(double key, const value_type &value, bool) override { push_heap(focal, focal_internal_value_type(key, value), compare_focal); }
+	void emplace_focal(double key, value_type &&value, bool) override { push_heap(focal, focal_internal_value_type(key, std::move(value)), compare_focal); }
+	void pop() override { if (!focal.empty()) pop_heap(focal, compare_focal); else pop_heap(queue, compare); }
+	auto remove_stale(const std::function<bool(const value_type &)> &is_stale) -> std::size_t override {
+		return remove_stale(focal, compare_focal, is_stale) + remove_stale(queue, compare, is_stale);
+	}
+
+	FocalOpenList() : FocalOpenList(Compare(), FocalCompare()) {}
+	FocalOpenList(Compare compare, FocalCompare compare_focal)
+		: FloatingPointOpenList<N, T>(), compare(std::move(compare)), compare_focal(std::move(compare_focal)) {}
 };
 } // namespace floating_point_open_list
 
@@ -0,0 +1,69 @@
+#ifndef FLOATING_POINT_OPEN_LIST_HEAP_TYPE_H
+#define FLOATING_POINT_OPEN_LIST_HEAP_TYPE_H
+
+#include <memory>
+#include <variant>
+
+#include "best_first_open_list.h"
+#include "d_ary_heap_open_list.h"
+
+namespace floating_point_open_list {
+enum class HeapType { BINARY, D_ARY_4, D_ARY_8 };
+
+template <std::size_t N, class T, std::size_t D>
+auto create_d_ary_heap_open_list(bool compress_primary_key) -> std::unique_ptr<FloatingPointOpenList<N, T>> {
+	if (compress_primary_key)
+		return std::make_unique<DAryHeapOpenList<N, T, D, true>>();
+	return std::make_unique<DAryHeapOpenList<N, T, D, false>>();
+}
+
+// create a best-first open list using the given heap implementation (key compression is only supported by the d-ary heaps)
+template <std::size_t N, class T>
+auto create_best_first_open_list(HeapType heap_type, bool compress_primary_key) -> std::unique_ptr<FloatingPointOpenList<N, T>> {
+	switch (heap_type) {
+	case HeapType::BINARY:
+		if (compress_primary_key) {
+			std::cerr << "Key compression is not supported for binary heaps, exiting." << std::endl;
+			utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+		}
+		return std::make_unique<BestFirstOpenList<N, T>>();
+	case HeapType::D_ARY_4:
+		return create_d_ary_heap_open_list<N, T, 4>(compress_primary_key);
+	case HeapType::D_ARY_8:
+		return create_d_ary_heap_open_list<N, T, 8>(compress_primary_key);
+	}
+	utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+}
+
+// best-first open list with any of the heap implementations, held by value so that the calls (through std::visit) are not virtual
+template <std::size_t N, class T>
+using BestFirstOpenListVariant = std::variant<BestFirstOpenList<N, T>, DAryHeapOpenList<N, T, 4, false>, DAryHeapOpenList<N, T, 4, true>,
+                                              DAryHeapOpenList<N, T, 8, false>, DAryHeapOpenList<N, T, 8, true>>;
+
+template <std::size_t N, class T, std::size_t D>
+auto create_d_ary_heap_open_list_variant(bool compress_primary_key) -> BestFirstOpenListVariant<N, T> {
+	if (compress_primary_key)
+		return BestFirstOpenListVariant<N, T>(std::in_place_type<DAryHeapOpenList<N, T, D, true>>);
+	return BestFirstOpenListVariant<N, T>(std::in_place_type<DAryHeapOpenList<N, T, D, false>>);
+}
+
+// same as create_best_first_open_list, but returns the open list as a variant
+template <std::size_t N, class T>
+auto create_best_first_open_list_variant(HeapType heap_type, bool compress_primary_key) -> BestFirstOpenListVariant<N, T> {
+	switch (heap_type) {
+	case HeapType::BINARY:
+		if (compress_primary_key) {
+			std::cerr << "Key compression is not supported for binary heaps, exiting." << std::endl;
+			utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+		}
+		return BestFirstOpenListVariant<N, T>(std::in_place_type<BestFirstOpenList<N, T>>);
+	case HeapType::D_ARY_4:
+		return create_d_ary_heap_open_list_variant<N, T, 4>(compress_primary_key);
+	case HeapType::D_ARY_8:
+		return create_d_ary_heap_open_list_variant<N, T, 8>(compress_primary_key);
+	}
+	utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+}
+} // namespace floating_point_open_list
+
+#endif
@@ -20,6 +20,17 @@ GlobalState::GlobalState(
     assert(id != StateID::no_state);
 }
 
+GlobalState::GlobalState(
+    const shared_ptr<PackedStateBin[]> &decoded_buffer,
+    const StateRegistry &registry, StateID id)
+    : buffer(decoded_buffer.get()),
+      decoded_buffer(decoded_buffer),
+      registry(&registry),
+      id(id) {
+    assert(buffer);
+    assert(id != StateID::no_state);
+}
+
 int GlobalState::operator[](int var) const {
     assert(var >= 0);
     assert(var < registry->get_num_variables());
@@ -5,9 +5,21 @@
 
 #include "algorithms/int_packer.h"
 
+#include <memory>
+
+class Heuristic;
 class State;
 class StateRegistry;
 
+namespace successor_generator {
+class GeneratorFlat;
+class GeneratorPreconditionMasks;
+}
+
+namespace suboptimal_search {
+class ParallelEvaluation;
+}
+
 using PackedStateBin = int_packer::IntPacker::Bin;
 
 // For documentation on classes relevant to storing and working with registered
@@ -19,9 +31,19 @@ class GlobalState {
     template<typename>
     friend class PerStateArray;
     friend class PerStateBitset;
+    friend class Heuristic;
+    friend class successor_generator::GeneratorFlat;
+    friend class successor_generator::GeneratorPreconditionMasks;
+    friend class suboptimal_search::ParallelEvaluation;
 
     // Values for vars are maintained in a packed state and accessed on demand.
     const PackedStateBin *buffer;
+    /*
+      Keeps the buffer alive if the registry decoded it from a delta-encoded
+      representation (see StateRegistry). Null if the buffer is stored in the
+      registry itself.
+    */
+    std::shared_ptr<PackedStateBin[]> decoded_buffer;
 
     // registry isn't a reference because we want to support operator=
     const StateRegistry *registry;
@@ -30,6 +52,9 @@ class GlobalState {
     // Only used by the state registry.
     GlobalState(
         const PackedStateBin *buffer, const StateRegistry &registry, StateID id);
+    GlobalState(
+        const std::shared_ptr<PackedStateBin[]> &decoded_buffer,
+        const StateRegistry &registry, StateID id);
 
     const PackedStateBin *get_packed_buffer() const {
         return buffer;
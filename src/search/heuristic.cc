@@ -9,6 +9,7 @@
 #include "tasks/cost_adapted_task.h"
 #include "tasks/root_task.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <limits>
@@ -17,8 +18,11 @@ using namespace std;
 
 Heuristic::Heuristic(const Options &opts)
     : Evaluator(opts.get_unparsed_config(), true, true, true),
-      heuristic_cache(HEntry(NO_VALUE, true)), //TODO: is true really a good idea here?
+      heuristic_cache(HEntry(NO_VALUE, true), "heuristic cache of " + get_description(),
+                      opts.get<bool>("cache_estimates")), //TODO: is true really a good idea here?
       cache_evaluator_values(opts.get<bool>("cache_estimates")),
+      next_batch_estimate(0),
+      batch_registry(nullptr),
       task(opts.get<shared_ptr<AbstractTask>>("transform")),
       task_proxy(*task) {
 }
@@ -58,7 +62,8 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
         heuristic = heuristic_cache[state].h;
         result.set_count_evaluation(false);
     } else {
-        heuristic = compute_heuristic(state);
+        if (calculate_preferred || !lookup_batch_estimate(state, heuristic))
+            heuristic = compute_heuristic(state);
         if (cache_evaluator_values) {
             heuristic_cache[state] = HEntry(heuristic, false);
         }
@@ -96,6 +101,70 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
     return result;
 }
 
+bool Heuristic::lookup_batch_estimate(const GlobalState &state, int &estimate) {
+    if (batch_estimates.empty())
+        return false;
+    if (&state.get_registry() != batch_registry) {
+        // The state IDs of the batch have no meaning in this registry.
+        batch_estimates.clear();
+        return false;
+    }
+    StateID id = state.get_id();
+    auto batch_entry = find_if(
+        batch_estimates.begin() + next_batch_estimate, batch_estimates.end(),
+        [id](const pair<StateID, int> &entry) {
+            return entry.first == id;
+        });
+    if (batch_entry == batch_estimates.end())
+        return false;
+    estimate = batch_entry->second;
+    next_batch_estimate = batch_entry - batch_estimates.begin() + 1;
+    if (next_batch_estimate == batch_estimates.size())
+        batch_estimates.clear();
+    return true;
+}
+
+void Heuristic::compute_heuristics(
+    const vector<GlobalState> &states, vector<int> &values) {
+    for (const GlobalState &state : states) {
+        values.push_back(compute_heuristic(state));
+        preferred_operators.clear();
+    }
+}
+
+void Heuristic::compute_batch(const vector<GlobalState> &states) {
+    batch_estimates.clear();
+    next_batch_estimate = 0;
+    vector<GlobalState> uncached_states;
+    for (const GlobalState &state : states) {
+        if (!cache_evaluator_values || heuristic_cache[state].h == NO_VALUE ||
+            heuristic_cache[state].dirty)
+            uncached_states.push_back(state);
+    }
+    if (uncached_states.empty())
+        return;
+    vector<int> values;
+    compute_heuristics(uncached_states, values);
+    assert(values.size() == uncached_states.size());
+    batch_registry = &uncached_states.front().get_registry();
+    for (size_t i = 0; i < uncached_states.size(); ++i)
+        batch_estimates.emplace_back(uncached_states[i].get_id(), values[i]);
+}
+
+void Heuristic::set_batch_estimates(
+    const vector<GlobalState> &states, const vector<int> &values) {
+    assert(states.size() == values.size());
+    batch_estimates.clear();
+    next_batch_estimate = 0;
+    if (states.empty())
+        return;
+    batch_registry = &states.front().get_registry();
+    for (size_t i = 0; i < states.size(); ++i) {
+        int value = values[i] == EvaluationResult::INFTY ? DEAD_END : values[i];
+        batch_estimates.emplace_back(states[i].get_id(), value);
+    }
+}
+
 bool Heuristic::does_cache_estimates() const {
     return cache_evaluator_values;
 }
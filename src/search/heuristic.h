@@ -9,6 +9,7 @@
 #include "algorithms/ordered_set.h"
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 class TaskProxy;
@@ -54,6 +55,23 @@ protected:
     PerStateInformation<HEntry> heuristic_cache;
     bool cache_evaluator_values;
 
+    /*
+      Estimates computed by the last call of compute_batch (or set by
+      set_batch_estimates) in the order of the batch, and the registry of
+      their states. They are used by compute_result unless preferred
+      operators are requested. The search evaluates the states of a batch
+      in this order, so a state is looked up from the entry after the last
+      one found (skipping the states the search does not evaluate). The
+      estimates are dropped once the last one is used or a state of another
+      registry is evaluated.
+    */
+    std::vector<std::pair<StateID, int>> batch_estimates;
+    std::size_t next_batch_estimate;
+    const StateRegistry *batch_registry;
+
+    // Returns whether the estimate of the state was computed in the last batch.
+    bool lookup_batch_estimate(const GlobalState &state, int &estimate);
+
     // Hold a reference to the task implementation and pass it to objects that need it.
     const std::shared_ptr<AbstractTask> task;
     // Use task_proxy to access task information.
@@ -64,6 +82,15 @@ protected:
     // TODO: Call with State directly once all heuristics support it.
     virtual int compute_heuristic(const GlobalState &state) = 0;
 
+    /*
+      Compute the estimates of the given states (DEAD_END for dead ends)
+      without preferred operators and append them to values. Heuristics
+      that can share work between similar states override this, the
+      default implementation evaluates the states one by one.
+    */
+    virtual void compute_heuristics(
+        const std::vector<GlobalState> &states, std::vector<int> &values);
+
     /*
       Usage note: Marking the same operator as preferred multiple times
       is OK -- it will only appear once in the list of preferred
@@ -88,6 +115,17 @@ public:
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) override;
 
+    virtual void compute_batch(const std::vector<GlobalState> &states) override;
+
+    /*
+      Use the given estimates of the given states like estimates computed by
+      compute_batch. The estimates are given as evaluator values (INFTY for
+      dead ends) and must have been computed by an identically configured
+      heuristic, e.g. in another thread.
+    */
+    void set_batch_estimates(
+        const std::vector<GlobalState> &states, const std::vector<int> &values);
+
     virtual bool does_cache_estimates() const override;
     virtual bool is_estimate_cached(const GlobalState &state) const override;
     virtual int get_cached_estimate(const GlobalState &state) const override;
@@ -0,0 +1,91 @@
+#include "error_statistics.h"
+
+#include <cassert>
+#include <cmath>
+#include <thread>
+
+namespace heuristic_error {
+void ErrorStatistics::add(double error) {
+	++count;
+	const auto delta = error - mean;
+	mean += delta / count;
+	const auto delta2 = error - mean;
+	M2_sum += std::abs(delta * delta2);
+}
+
+void ErrorStatistics::merge(const ErrorStatistics &other) {
+	if (other.count == 0)
+		return;
+	if (count == 0) {
+		*this = other;
+		return;
+	}
+	const auto total_count = static_cast<double>(count) + other.count;
+	const auto delta = other.mean - mean;
+	mean += delta * other.count / total_count;
+	M2_sum += other.M2_sum + delta * delta * count * other.count / total_count;
+	count += other.count;
+}
+
+auto ErrorStatistics::get_variance() const -> double {
+	assert(count > 0);
+	assert(M2_sum >= 0);
+	return count == 1 ? 0. : M2_sum / (count - 1);
+}
+
+auto ErrorStatistics::get_snapshot() const -> ErrorSnapshot {
+	auto snapshot = ErrorSnapshot();
+	snapshot.count = count;
+	snapshot.mean = mean;
+	snapshot.variance = count == 0 ? 0. : get_variance();
+	return snapshot;
+}
+
+SharedErrorStatistics::SharedErrorStatistics(int num_contributors)
+	: num_contributors(num_contributors),
+	  slots(std::make_unique<Slot[]>(num_contributors)),
+	  epoch(0) {}
+
+void SharedErrorStatistics::publish(int contributor, const ErrorStatistics &statistics) {
+	assert(0 <= contributor && contributor < num_contributors);
+	auto &slot = slots[contributor];
+	const auto version = slot.version.load(std::memory_order_relaxed);
+	slot.version.store(version + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.count.store(statistics.count, std::memory_order_relaxed);
+	slot.mean.store(statistics.mean, std::memory_order_relaxed);
+	slot.M2_sum.store(statistics.M2_sum, std::memory_order_relaxed);
+	slot.version.store(version + 2, std::memory_order_release);
+	epoch.fetch_add(1, std::memory_order_acq_rel);
+}
+
+auto SharedErrorStatistics::read_slot(const Slot &slot) const -> ErrorStatistics {
+	auto statistics = ErrorStatistics();
+	while (true) {
+		const auto version = slot.version.load(std::memory_order_acquire);
+		if (version % 2 == 1) {
+			// the contributor is writing the slot
+			std::this_thread::yield();
+			continue;
+		}
+		statistics.count = slot.count.load(std::memory_order_relaxed);
+		statistics.mean = slot.mean.load(std::memory_order_relaxed);
+		statistics.M2_sum = slot.M2_sum.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.version.load(std::memory_order_relaxed) == version)
+			return statistics;
+	}
+}
+
+auto SharedErrorStatistics::get_statistics(std::uint64_t &out_epoch) const -> ErrorStatistics {
+	auto statistics = ErrorStatistics();
+	// read all slots again if a contributor published in the meantime, so that the result belongs to a single epoch
+	do {
+		out_epoch = get_epoch();
+		statistics = ErrorStatistics();
+		for (auto i = 0; i < num_contributors; ++i)
+			statistics.merge(read_slot(slots[i]));
+	} while (get_epoch() != out_epoch);
+	return statistics;
+}
+} // namespace heuristic_error
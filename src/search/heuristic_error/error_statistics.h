@@ -0,0 +1,70 @@
+#ifndef HEURISTIC_ERROR_ERROR_STATISTICS_H
+#define HEURISTIC_ERROR_ERROR_STATISTICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace heuristic_error {
+// Mean and variance of the heuristic errors as seen by the evaluators.
+struct ErrorSnapshot {
+	int count = 0;
+	double mean = 0;
+	double variance = 0;
+};
+
+// Mean and variance of a sequence of heuristic errors.
+struct ErrorStatistics {
+	int count = 0;
+	double mean = 0;
+	double M2_sum = 0;
+
+	// see https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Welford's_online_algorithm
+	void add(double error);
+	// add the samples of other (Chan et al.'s parallel algorithm, see the same page)
+	void merge(const ErrorStatistics &other);
+
+	auto get_variance() const -> double;
+	auto get_snapshot() const -> ErrorSnapshot;
+};
+
+/*
+  Error statistics to which the heuristic error models of several threads
+  (the contributors) contribute their samples, without locks.
+
+  Every contributor publishes the statistics of all its samples so far to
+  its own slot, which is protected by a sequence lock with a single writer:
+  the version of the slot is odd while it is written, and readers retry
+  until they read the same even version before and after copying the slot.
+  Hence, writers never wait, and readers always get a consistent
+  (count, mean, M2) triple of each slot, which they combine with Chan et
+  al.'s formula. Every publication increases the epoch of the statistics,
+  so readers can tell whether anything changed since their last read.
+*/
+class SharedErrorStatistics {
+	struct alignas(64) Slot {
+		std::atomic<std::uint64_t> version{0};
+		std::atomic<int> count{0};
+		std::atomic<double> mean{0};
+		std::atomic<double> M2_sum{0};
+	};
+
+	const int num_contributors;
+	std::unique_ptr<Slot[]> slots;
+	std::atomic<std::uint64_t> epoch;
+
+	auto read_slot(const Slot &slot) const -> ErrorStatistics;
+
+public:
+	explicit SharedErrorStatistics(int num_contributors);
+
+	// must only be called by the thread of the given contributor
+	void publish(int contributor, const ErrorStatistics &statistics);
+
+	auto get_epoch() const -> std::uint64_t { return epoch.load(std::memory_order_acquire); }
+	// the statistics of all published samples and the epoch they belong to
+	auto get_statistics(std::uint64_t &out_epoch) const -> ErrorStatistics;
+};
+} // namespace heuristic_error
+
+#endif
@@ -7,11 +7,12 @@ namespace heuristic_error {
 class OneStepDistanceError : public OneStepError {
 	// This class implements the one-step distance error estimation (Thayer, Dionne, and Ruml, 2011).
 protected:
-	void add_successor(StateID state_id, int op_cost, int evaluator_value) override;
-	auto compute_error(const GlobalState &state, const GlobalState &best_successor) const -> double override;
+	auto compute_error(int evaluator_value, int best_successor_key) const -> double override;
 
 public:
 	OneStepDistanceError(const options::Options &opts);
+
+	auto get_successor_key(int, int evaluator_value) const -> int override { return evaluator_value; }
 };
 } // namespace heuristic_error
 
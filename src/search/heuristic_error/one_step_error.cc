@@ -10,46 +10,96 @@ namespace heuristic_error {
 OneStepError::OneStepError(const options::Options &opts)
 	: HeuristicError(opts),
 	  state_registry(nullptr),
-	  average_heuristic_error(0),
-	  heuristic_errors_M2_sum(0),
-	  count(0),
+	  snapshot_interval(opts.get<int>("snapshot_interval", 1)),
 	  current_state_id(StateID::no_state),
-	  best_successor_id(StateID::no_state),
-	  best_successor_value(NO_VALUE) {}
+	  best_successor_key(NO_VALUE),
+	  contributor(-1),
+	  num_published_samples(0),
+	  shared_epoch(0) {}
+
+void OneStepError::add_options_to_parser(options::OptionParser &parser) {
+	HeuristicError::add_options_to_parser(parser);
+	parser.add_option<int>("snapshot_interval",
+	                       "only update the error seen by the evaluators once it misses this many samples, so that evaluator values are stable in between "
+	                       "(1 updates it after every sample)",
+	                       "1", options::Bounds("1", "infinity"));
+}
+
+void OneStepError::set_warm_start(int samples, double value) {
+	statistics = ErrorStatistics();
+	statistics.count = samples;
+	statistics.mean = value;
+	warm_start = statistics;
+	snapshot = statistics.get_snapshot();
+}
+
+void OneStepError::update_snapshot() {
+	if (statistics.count - snapshot.count >= snapshot_interval)
+		snapshot = statistics.get_snapshot();
+}
 
 void OneStepError::set_expanding_state(const GlobalState &state) {
 	current_state_id = state.get_id();
-	best_successor_value = NO_VALUE;
+	best_successor_key = NO_VALUE;
 }
 
-void OneStepError::add_successor(const SearchNode &successor_node, int op_cost) {
-	assert(successor_node.is_open() || successor_node.is_closed());
-	auto eval_context = EvaluationContext(successor_node.get_state(), successor_node.get_g(), true, nullptr);
+auto OneStepError::get_value(const SearchNode &node) const -> int {
+	assert(node.is_open() || node.is_closed());
+	const auto state = node.get_state();
+	if (evaluator->does_cache_estimates() && evaluator->is_estimate_cached(state)) {
+		// the node was just evaluated by the search, so avoid creating an evaluation context
+		const auto value = evaluator->get_cached_estimate(state);
+		// negative cached estimates denote dead ends
+		return value >= 0 ? value : NO_VALUE;
+	}
+	auto eval_context = EvaluationContext(state, node.get_g(), true, nullptr);
 	if (eval_context.is_evaluator_value_infinite(evaluator.get()))
+		return NO_VALUE;
+	return eval_context.get_evaluator_value(evaluator.get());
+}
+
+void OneStepError::add_successor(const SearchNode &successor_node, int op_cost) {
+	const auto value = get_value(successor_node);
+	if (value == NO_VALUE)
 		return;
-	const auto value = eval_context.get_evaluator_value(evaluator.get());
-	add_successor(successor_node.get_state_id(), op_cost, value);
+	const auto key = get_successor_key(op_cost, value);
+	if (best_successor_key == NO_VALUE || key < best_successor_key)
+		best_successor_key = key;
 }
 
 void OneStepError::update_error() {
-	if (best_successor_value == NO_VALUE)
+	if (best_successor_key == NO_VALUE)
 		return;
 	const auto state = state_registry->lookup_state(current_state_id);
-	const auto successor_state = state_registry->lookup_state(best_successor_id);
 	assert(evaluator->is_estimate_cached(state));
-	assert(evaluator->is_estimate_cached(successor_state));
-	const auto error = compute_error(state, successor_state);
-	// see https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Welford's_online_algorithm
-	++count;
-	const auto delta = error - average_heuristic_error;
-	average_heuristic_error += delta / count;
-	const auto delta2 = error - average_heuristic_error;
-	heuristic_errors_M2_sum += std::abs(delta * delta2);
-}
-
-auto OneStepError::get_heuristic_error_variance() const -> double {
-	assert(count > 0);
-	assert(heuristic_errors_M2_sum >= 0);
-	return count == 1 ? 0. : heuristic_errors_M2_sum / (count - 1);
+	add_sample(evaluator->get_cached_estimate(state), best_successor_key);
+}
+
+void OneStepError::add_sample(int evaluator_value, int best_successor_key) {
+	const auto error = compute_error(evaluator_value, best_successor_key);
+	statistics.add(error);
+	if (shared_statistics)
+		own_samples.add(error);
+	update_snapshot();
+}
+
+void OneStepError::share_statistics(std::shared_ptr<SharedErrorStatistics> shared_statistics, int contributor) {
+	this->shared_statistics = std::move(shared_statistics);
+	this->contributor = contributor;
+}
+
+void OneStepError::synchronize_statistics() {
+	assert(shared_statistics);
+	if (own_samples.count != num_published_samples) {
+		shared_statistics->publish(contributor, own_samples);
+		num_published_samples = own_samples.count;
+	}
+	if (shared_statistics->get_epoch() == shared_epoch)
+		return;
+	// the shared statistics include the samples of this model, so they replace the statistics of this model
+	const auto all_samples = shared_statistics->get_statistics(shared_epoch);
+	statistics = warm_start;
+	statistics.merge(all_samples);
+	update_snapshot();
 }
 } // namespace heuristic_error
@@ -1,7 +1,12 @@
 #ifndef HEURISTIC_ERROR_ONE_STEP_ERROR_H
 #define HEURISTIC_ERROR_ONE_STEP_ERROR_H
 
+#include <cassert>
+#include <cstdint>
+#include <memory>
+
 #include "../state_id.h"
+#include "error_statistics.h"
 #include "heuristic_error.h"
 
 namespace heuristic_error {
@@ -10,30 +15,78 @@ class OneStepError : public HeuristicError {
 protected:
 	const StateRegistry *state_registry;
 
-	double average_heuristic_error;
-	double heuristic_errors_M2_sum;
-	int count;
+	// the statistics of all samples known to this model and the snapshot of them that is seen by the evaluators
+	ErrorStatistics statistics;
+	ErrorSnapshot snapshot;
+	/*
+	  The snapshot is only renewed once it misses at least this many samples,
+	  so that evaluator values stay stable in between (1: after each sample).
+	*/
+	int snapshot_interval;
 
 	StateID current_state_id;
-	StateID best_successor_id;
-	int best_successor_value;
+	int best_successor_key;
 
-	static constexpr auto NO_VALUE = -1;
+	void set_warm_start(int samples, double value);
+	void update_snapshot();
+
+	virtual auto compute_error(int evaluator_value, int best_successor_key) const -> double = 0;
 
-	virtual void add_successor(StateID state_id, int op_cost, int evaluator_value) = 0;
-	virtual auto compute_error(const GlobalState &state, const GlobalState &best_successor) const -> double = 0;
+private:
+	/*
+	  Only used if the statistics are shared with the models of other
+	  threads: the warm start, the samples of this model (published as
+	  the given contributor) and the epoch of the shared statistics that
+	  were last added to the statistics of this model.
+	*/
+	std::shared_ptr<SharedErrorStatistics> shared_statistics;
+	int contributor;
+	ErrorStatistics warm_start;
+	ErrorStatistics own_samples;
+	int num_published_samples;
+	std::uint64_t shared_epoch;
 
 public:
+	static constexpr auto NO_VALUE = -1;
+
 	OneStepError(const options::Options &opts);
 
+	static void add_options_to_parser(options::OptionParser &parser);
+
 	void initialize(const StateRegistry &state_registry) override { this->state_registry = &state_registry; }
 
 	void set_expanding_state(const GlobalState &state) override;
 	void add_successor(const SearchNode &successor_node, int op_cost) override;
 	void update_error() override;
 
-	auto get_average_heuristic_error() const -> double override { return average_heuristic_error; }
-	auto get_heuristic_error_variance() const -> double override;
+	auto get_average_heuristic_error() const -> double override { return snapshot.mean; }
+	auto get_heuristic_error_variance() const -> double override {
+		assert(snapshot.count > 0);
+		return snapshot.variance;
+	}
+
+	void set_snapshot_interval(int snapshot_interval) { this->snapshot_interval = snapshot_interval; }
+
+	/*
+	  Interface for searches in which the successors of an expanded state
+	  may be evaluated by other threads (see suboptimal_search/state_exchange.h),
+	  which report their values back instead of passing them to add_successor.
+	*/
+	// evaluator value of an open or closed node, NO_VALUE for dead ends
+	auto get_value(const SearchNode &node) const -> int;
+	// the successor with the smallest key is used to compute the error of the expanded state
+	virtual auto get_successor_key(int op_cost, int evaluator_value) const -> int = 0;
+	void add_sample(int evaluator_value, int best_successor_key);
+
+	/*
+	  Contribute the samples of this model to statistics that several models
+	  (typically the same model in different threads) share. Each call to
+	  synchronize_statistics publishes the samples of this model and adds
+	  the samples published by the other models to the statistics of this
+	  model, neither of which waits for the other threads.
+	*/
+	void share_statistics(std::shared_ptr<SharedErrorStatistics> shared_statistics, int contributor);
+	void synchronize_statistics();
 };
 } // namespace heuristic_error
 
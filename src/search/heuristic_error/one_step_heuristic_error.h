@@ -9,14 +9,14 @@ class OneStepHeuristicError : public OneStepError {
 protected:
 	const int warm_start_samples;
 	const double warm_start_value;
-	int best_successor_op_cost;
 
-	void add_successor(StateID state_id, int op_cost, int evaluator_value) override;
-	auto compute_error(const GlobalState &state, const GlobalState &best_successor) const -> double override;
+	auto compute_error(int evaluator_value, int best_successor_key) const -> double override;
 
 public:
 	OneStepHeuristicError(const options::Options &opts);
 
+	auto get_successor_key(int op_cost, int evaluator_value) const -> int override { return evaluator_value + op_cost; }
+
 	void notify_initial_state() override;
 	void notify_initial_state(EvaluationContext &eval_context, int cost_bound, int distance) override;
 };
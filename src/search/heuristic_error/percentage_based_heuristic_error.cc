@@ -9,14 +9,12 @@ namespace heuristic_error {
 PercentageBasedHeuristicError::PercentageBasedHeuristicError(const options::Options &opts)
 	: OneStepError(opts),
 	  warm_start_samples(opts.get<int>("warm_start_samples")),
-	  warm_start_value(opts.get<double>("warm_start_value")),
-	  best_successor_op_cost(0) {}
+	  warm_start_value(opts.get<double>("warm_start_value")) {}
 
 void PercentageBasedHeuristicError::notify_initial_state() {
 	if (warm_start_samples == 0)
 		return;
-	count = warm_start_samples;
-	average_heuristic_error = warm_start_value;
+	set_warm_start(warm_start_samples, warm_start_value);
 }
 
 void PercentageBasedHeuristicError::notify_initial_state(EvaluationContext &eval_context, int cost_bound, int distance) {
@@ -27,24 +25,14 @@ void PercentageBasedHeuristicError::notify_initial_state(EvaluationContext &eval
 	const auto initial_value = eval_context.get_evaluator_value(evaluator.get());
 	if (initial_value == 0)
 		return;
-	count = warm_start_samples;
-	average_heuristic_error = static_cast<double>(cost_bound) / initial_value;
+	set_warm_start(warm_start_samples, static_cast<double>(cost_bound) / initial_value);
 }
 
-void PercentageBasedHeuristicError::add_successor(StateID state_id, int op_cost, int evaluator_value) {
-	const auto f_value = evaluator_value + op_cost;
-	if (best_successor_value == NO_VALUE || f_value < best_successor_value) {
-		best_successor_value = f_value;
-		best_successor_op_cost = op_cost;
-		best_successor_id = state_id;
-	}
-}
-
-auto PercentageBasedHeuristicError::compute_error(const GlobalState &state, const GlobalState &best_successor) const -> double {
-	if (evaluator->get_cached_estimate(state) == 0)
+auto PercentageBasedHeuristicError::compute_error(int evaluator_value, int best_successor_key) const -> double {
+	if (evaluator_value == 0)
 		// report the heuristic as 100% accurate on states where it evaluates to zero
 		return 1.;
-	return (static_cast<double>(evaluator->get_cached_estimate(best_successor)) + best_successor_op_cost) / evaluator->get_cached_estimate(state);
+	return static_cast<double>(best_successor_key) / evaluator_value;
 }
 
 static auto _parse(OptionParser &parser) -> std::shared_ptr<HeuristicError> {
@@ -55,7 +43,7 @@ static auto _parse(OptionParser &parser) -> std::shared_ptr<HeuristicError> {
 	                       "0", Bounds("0", "infinity"));
 	parser.add_option<double>("warm_start_value", "Value to warm-start the heuristic error with (default: 0.9 -- assume underestimation by 10%).", ".9",
 	                          Bounds("0", "infinity"));
-	HeuristicError::add_options_to_parser(parser);
+	OneStepError::add_options_to_parser(parser);
 	Options opts = parser.parse();
 	if (parser.dry_run() || parser.help_mode())
 		return nullptr;
@@ -7,6 +7,7 @@
 #include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 
@@ -14,12 +15,35 @@ using namespace std;
 
 namespace additive_heuristic {
 const int AdditiveHeuristic::MAX_COST_VALUE;
+const int AdditiveHeuristic::MAX_LANES;
+const int AdditiveHeuristic::LANE_INFINITY;
 
 // construction and destruction
 AdditiveHeuristic::AdditiveHeuristic(const Options &opts)
     : RelaxationHeuristic(opts),
-      did_write_overflow_warning(false) {
+      did_write_overflow_warning(false),
+      incremental(opts.get<bool>("incremental", false)),
+      has_complete_exploration(false) {
     utils::g_log << "Initializing additive heuristic..." << endl;
+    if (incremental) {
+        build_achievers();
+        propagated_cost.resize(propositions.size(), -1);
+        is_dirty.resize(propositions.size(), false);
+    }
+}
+
+void AdditiveHeuristic::build_achievers() {
+    int num_propositions = propositions.size();
+    achievers_begin.assign(num_propositions + 1, 0);
+    for (PropID effect : operator_effects)
+        ++achievers_begin[effect + 1];
+    for (PropID prop_id = 0; prop_id < num_propositions; ++prop_id)
+        achievers_begin[prop_id + 1] += achievers_begin[prop_id];
+    achievers.resize(unary_operators.size());
+    vector<int> next(achievers_begin.begin(), achievers_begin.end() - 1);
+    int num_unary_ops = unary_operators.size();
+    for (OpID op_id = 0; op_id < num_unary_ops; ++op_id)
+        achievers[next[operator_effects[op_id]]++] = op_id;
 }
 
 void AdditiveHeuristic::write_overflow_warning() {
@@ -42,15 +66,14 @@ void AdditiveHeuristic::setup_exploration_queue() {
         prop.cost = -1;
         prop.marked = false;
     }
+    marked_propositions.clear();
 
-    // Deal with operators and axioms without preconditions.
-    for (UnaryOperator &op : unary_operators) {
-        op.unsatisfied_preconditions = op.num_preconditions;
-        op.cost = op.base_cost; // will be increased by precondition costs
+    // Operator costs will be increased by precondition costs.
+    reset_operators();
 
-        if (op.unsatisfied_preconditions == 0)
-            enqueue_if_necessary(op.effect, op.base_cost, get_op_id(op));
-    }
+    // Deal with operators and axioms without preconditions.
+    for (OpID op_id : operators_without_preconditions)
+        enqueue_if_necessary(operator_effects[op_id], operator_costs[op_id], op_id);
 }
 
 void AdditiveHeuristic::setup_exploration_queue_state(const State &state) {
@@ -60,7 +83,7 @@ void AdditiveHeuristic::setup_exploration_queue_state(const State &state) {
     }
 }
 
-void AdditiveHeuristic::relaxed_exploration() {
+void AdditiveHeuristic::relaxed_exploration(bool stop_at_goals) {
     int unsolved_goals = goal_propositions.size();
     while (!queue.empty()) {
         pair<int, PropID> top_pair = queue.pop();
@@ -72,17 +95,16 @@ void AdditiveHeuristic::relaxed_exploration() {
         assert(prop_cost <= distance);
         if (prop_cost < distance)
             continue;
-        if (prop->is_goal && --unsolved_goals == 0)
+        if (prop->is_goal && --unsolved_goals == 0 && stop_at_goals)
             return;
         for (OpID op_id : precondition_of_pool.get_slice(
                  prop->precondition_of, prop->num_precondition_occurences)) {
-            UnaryOperator *unary_op = get_operator(op_id);
-            increase_cost(unary_op->cost, prop_cost);
-            --unary_op->unsatisfied_preconditions;
-            assert(unary_op->unsatisfied_preconditions >= 0);
-            if (unary_op->unsatisfied_preconditions == 0)
-                enqueue_if_necessary(unary_op->effect,
-                                     unary_op->cost, op_id);
+            increase_cost(operator_costs[op_id], prop_cost);
+            --unsatisfied_preconditions[op_id];
+            assert(unsatisfied_preconditions[op_id] >= 0);
+            if (unsatisfied_preconditions[op_id] == 0)
+                enqueue_if_necessary(operator_effects[op_id],
+                                     operator_costs[op_id], op_id);
         }
     }
 }
@@ -91,7 +113,7 @@ void AdditiveHeuristic::mark_preferred_operators(
     const State &state, PropID goal_id) {
     Proposition *goal = get_proposition(goal_id);
     if (!goal->marked) { // Only consider each subgoal once.
-        goal->marked = true;
+        mark_proposition(goal_id);
         OpID op_id = goal->reached_by;
         if (op_id != NO_OP) { // We have not yet chained back to a start node.
             UnaryOperator *unary_op = get_operator(op_id);
@@ -113,10 +135,179 @@ void AdditiveHeuristic::mark_preferred_operators(
     }
 }
 
-int AdditiveHeuristic::compute_add_and_ff(const State &state) {
+void AdditiveHeuristic::complete_exploration(const State &state) {
     setup_exploration_queue();
     setup_exploration_queue_state(state);
-    relaxed_exploration();
+    relaxed_exploration(false);
+
+    int num_propositions = propositions.size();
+    for (PropID prop_id = 0; prop_id < num_propositions; ++prop_id)
+        propagated_cost[prop_id] = propositions[prop_id].cost;
+    explored_state.resize(state.size());
+    for (FactProxy fact : state)
+        explored_state[fact.get_variable().get_id()] = get_prop_id(fact);
+    // Clamped costs break the bookkeeping of the operator costs.
+    has_complete_exploration = !did_write_overflow_warning;
+}
+
+void AdditiveHeuristic::mark_dirty(PropID prop_id) {
+    assert(!is_dirty[prop_id]);
+    is_dirty[prop_id] = true;
+    dirty_propositions.push_back(prop_id);
+}
+
+bool AdditiveHeuristic::find_equivalent_supporter(PropID prop_id) {
+    Proposition *prop = get_proposition(prop_id);
+    for (int i = achievers_begin[prop_id]; i < achievers_begin[prop_id + 1]; ++i) {
+        OpID op_id = achievers[i];
+        if (unsatisfied_preconditions[op_id] != 0 || operator_costs[op_id] != prop->cost)
+            continue;
+        bool preconditions_classified = true;
+        if (get_operator(op_id)->base_cost == 0) {
+            for (PropID precond : get_preconditions(op_id)) {
+                if (propagated_cost[precond] == prop->cost) {
+                    preconditions_classified = false;
+                    break;
+                }
+            }
+        }
+        if (preconditions_classified) {
+            prop->reached_by = op_id;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AdditiveHeuristic::update_exploration(const State &state) {
+    assert(has_complete_exploration);
+    const vector<int> &values = state.get_values();
+    changed_variables.clear();
+    int num_variables = values.size();
+    for (int var = 0; var < num_variables; ++var) {
+        if (explored_state[var] != get_prop_id(var, values[var]))
+            changed_variables.push_back(var);
+    }
+    if (2 * changed_variables.size() > values.size())
+        return false;
+
+    unmark_propositions();
+    queue.clear();
+
+    /*
+      Invalidate the facts that are no longer true and all propositions
+      whose best supporter depends on them, unless they have another
+      supporter of the same cost. Propositions are processed in order of
+      their old cost, so the preconditions of such a supporter that are
+      strictly cheaper have already been classified.
+    */
+    assert(dirty_propositions.empty());
+    for (int var : changed_variables) {
+        mark_dirty(explored_state[var]);
+        queue.push(0, explored_state[var]);
+    }
+    while (!queue.empty()) {
+        pair<int, PropID> top_pair = queue.pop();
+        int old_cost = top_pair.first;
+        PropID prop_id = top_pair.second;
+        Proposition *prop = get_proposition(prop_id);
+        assert(propagated_cost[prop_id] == old_cost && prop->cost == old_cost);
+        if (prop->reached_by != NO_OP && find_equivalent_supporter(prop_id))
+            continue;
+        prop->cost = -1;
+        prop->reached_by = NO_OP;
+        propagated_cost[prop_id] = -1;
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop->precondition_of, prop->num_precondition_occurences)) {
+            operator_costs[op_id] -= old_cost;
+            ++unsatisfied_preconditions[op_id];
+            PropID effect = operator_effects[op_id];
+            if (!is_dirty[effect] && get_proposition(effect)->reached_by == op_id &&
+                propagated_cost[effect] != -1) {
+                mark_dirty(effect);
+                queue.push(propagated_cost[effect], effect);
+            }
+        }
+    }
+
+    // Seed the queue with the new facts and the remaining achievers of the invalidated propositions.
+    for (int var : changed_variables) {
+        PropID prop_id = get_prop_id(var, values[var]);
+        explored_state[var] = prop_id;
+        Proposition *prop = get_proposition(prop_id);
+        prop->cost = 0;
+        prop->reached_by = NO_OP;
+        queue.push(0, prop_id);
+    }
+    for (PropID prop_id : dirty_propositions) {
+        is_dirty[prop_id] = false;
+        Proposition *prop = get_proposition(prop_id);
+        if (prop->cost != -1)
+            // The proposition is a new fact or kept its cost.
+            continue;
+        for (int i = achievers_begin[prop_id]; i < achievers_begin[prop_id + 1]; ++i) {
+            OpID op_id = achievers[i];
+            if (unsatisfied_preconditions[op_id] == 0 &&
+                (prop->cost == -1 || prop->cost > operator_costs[op_id])) {
+                prop->cost = operator_costs[op_id];
+                prop->reached_by = op_id;
+            }
+        }
+        if (prop->cost != -1)
+            queue.push(prop->cost, prop_id);
+    }
+    dirty_propositions.clear();
+
+    /*
+      Propagate all cost changes. Costs only decrease from here on and
+      h^add costs of effects are at least as high as those of their
+      preconditions, so each proposition is final when it is popped.
+    */
+    while (!queue.empty()) {
+        pair<int, PropID> top_pair = queue.pop();
+        int distance = top_pair.first;
+        PropID prop_id = top_pair.second;
+        Proposition *prop = get_proposition(prop_id);
+        assert(prop->cost != -1 && prop->cost <= distance);
+        int old_cost = propagated_cost[prop_id];
+        if (prop->cost < distance || old_cost == distance)
+            continue;
+        propagated_cost[prop_id] = distance;
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop->precondition_of, prop->num_precondition_occurences)) {
+            int &op_cost = operator_costs[op_id];
+            if (old_cost == -1) {
+                op_cost += distance;
+                --unsatisfied_preconditions[op_id];
+            } else {
+                op_cost += distance - old_cost;
+            }
+            assert(unsatisfied_preconditions[op_id] >= 0);
+            if (unsatisfied_preconditions[op_id] == 0) {
+                Proposition *effect = get_proposition(operator_effects[op_id]);
+                if (effect->cost == -1 || effect->cost > op_cost) {
+                    if (op_cost > MAX_COST_VALUE) {
+                        // Let the full exploration deal with (and warn about) the overflow.
+                        return false;
+                    }
+                    effect->cost = op_cost;
+                    effect->reached_by = op_id;
+                    queue.push(op_cost, operator_effects[op_id]);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+int AdditiveHeuristic::compute_add_and_ff(const State &state) {
+    if (!incremental) {
+        setup_exploration_queue();
+        setup_exploration_queue_state(state);
+        relaxed_exploration(true);
+    } else if (!has_complete_exploration || !update_exploration(state)) {
+        complete_exploration(state);
+    }
 
     int total_cost = 0;
     for (PropID goal_id : goal_propositions) {
@@ -129,6 +320,210 @@ int AdditiveHeuristic::compute_add_and_ff(const State &state) {
     return total_cost;
 }
 
+void AdditiveHeuristic::setup_lane_exploration(
+    const vector<State> &states, int begin, int end) {
+    num_lanes = end - begin;
+    assert(num_lanes > 0 && num_lanes <= MAX_LANES);
+    lane_costs.assign(propositions.size() * num_lanes, LANE_INFINITY);
+    lane_operator_costs.resize(num_lanes);
+    if (queued_key.empty())
+        queued_key.resize(unary_operators.size(), LANE_INFINITY);
+    if (achievers_begin.empty())
+        build_achievers();
+    lane_queue.clear();
+
+    /*
+      Proposition costs are only used to tell whether a proposition has
+      been reached in any lane, and unsatisfied_preconditions counts the
+      preconditions that have not been reached in any lane. Operators
+      are only queued once all their preconditions have been reached.
+      This overwrites the labels of the incremental exploration.
+    */
+    for (Proposition &prop : propositions)
+        prop.cost = -1;
+    reset_operators();
+    has_complete_exploration = false;
+
+    for (OpID op_id : operators_without_preconditions)
+        enqueue_operator_in_lanes(op_id, base_costs[op_id]);
+    for (int lane = 0; lane < num_lanes; ++lane) {
+        for (FactProxy fact : states[begin + lane]) {
+            PropID prop_id = get_prop_id(fact);
+            lane_costs[prop_id * num_lanes + lane] = 0;
+            Proposition *prop = get_proposition(prop_id);
+            if (prop->cost != -1)
+                continue;
+            prop->cost = 0;
+            for (OpID op_id : precondition_of_pool.get_slice(
+                     prop->precondition_of, prop->num_precondition_occurences)) {
+                if (--unsatisfied_preconditions[op_id] == 0)
+                    enqueue_operator_in_lanes(op_id, base_costs[op_id]);
+            }
+        }
+    }
+}
+
+bool AdditiveHeuristic::lane_exploration() {
+    int unreached_goal_lanes = 0;
+    for (PropID goal_id : goal_propositions) {
+        for (int lane = 0; lane < num_lanes; ++lane) {
+            if (get_lane_cost(goal_id, lane) == LANE_INFINITY)
+                ++unreached_goal_lanes;
+        }
+    }
+    int goal_cost_bound = LANE_INFINITY;
+    if (unreached_goal_lanes == 0)
+        goal_cost_bound = 0;
+
+    int *operator_costs_in_lanes = lane_operator_costs.data();
+    while (!lane_queue.empty()) {
+        pair<int, OpID> top_pair = lane_queue.pop();
+        int key = top_pair.first;
+        OpID op_id = top_pair.second;
+        if (queued_key[op_id] != key)
+            continue;
+        queued_key[op_id] = LANE_INFINITY;
+        /*
+          Improvements found from here on are at least as expensive as
+          key, so the goal costs cannot decrease anymore.
+        */
+        if (key >= goal_cost_bound)
+            break;
+
+        int base_cost = base_costs[op_id];
+        for (int lane = 0; lane < num_lanes; ++lane)
+            operator_costs_in_lanes[lane] = base_cost;
+        for (PropID precond : get_preconditions(op_id)) {
+            const int *precondition_costs = &lane_costs[precond * num_lanes];
+            for (int lane = 0; lane < num_lanes; ++lane)
+                operator_costs_in_lanes[lane] = min(
+                    operator_costs_in_lanes[lane] + precondition_costs[lane],
+                    static_cast<int>(LANE_INFINITY));
+        }
+
+        PropID effect_id = operator_effects[op_id];
+        int *effect_costs = &lane_costs[effect_id * num_lanes];
+        Proposition *effect = get_proposition(effect_id);
+        if (effect->is_goal) {
+            for (int lane = 0; lane < num_lanes; ++lane) {
+                if (effect_costs[lane] == LANE_INFINITY &&
+                    operator_costs_in_lanes[lane] != LANE_INFINITY)
+                    --unreached_goal_lanes;
+            }
+        }
+        int min_improved_cost = LANE_INFINITY;
+        int max_improved_cost = 0;
+        for (int lane = 0; lane < num_lanes; ++lane) {
+            int cost = operator_costs_in_lanes[lane];
+            bool improved = cost < effect_costs[lane];
+            effect_costs[lane] = improved ? cost : effect_costs[lane];
+            min_improved_cost = min(min_improved_cost, improved ? cost : LANE_INFINITY);
+            max_improved_cost = max(max_improved_cost, improved ? cost : 0);
+        }
+        if (min_improved_cost == LANE_INFINITY)
+            continue;
+        if (max_improved_cost > MAX_COST_VALUE)
+            return false;
+
+        if (effect->is_goal && unreached_goal_lanes == 0) {
+            goal_cost_bound = 0;
+            for (PropID goal_id : goal_propositions) {
+                for (int lane = 0; lane < num_lanes; ++lane)
+                    goal_cost_bound = max(goal_cost_bound, get_lane_cost(goal_id, lane));
+            }
+        }
+
+        bool newly_reached = effect->cost == -1;
+        effect->cost = 0;
+        for (OpID succ_op_id : precondition_of_pool.get_slice(
+                 effect->precondition_of, effect->num_precondition_occurences)) {
+            if (newly_reached)
+                --unsatisfied_preconditions[succ_op_id];
+            if (unsatisfied_preconditions[succ_op_id] == 0)
+                enqueue_operator_in_lanes(
+                    succ_op_id, base_costs[succ_op_id] + min_improved_cost);
+        }
+    }
+    return true;
+}
+
+bool AdditiveHeuristic::explore_in_lanes(
+    const vector<State> &states, int begin, int end) {
+    setup_lane_exploration(states, begin, end);
+    bool success = lane_exploration();
+    // Reset the keys of the operators that are still queued.
+    while (!lane_queue.empty())
+        queued_key[lane_queue.pop().second] = LANE_INFINITY;
+    return success;
+}
+
+int AdditiveHeuristic::get_lane_operator_cost(OpID op_id, int lane) const {
+    int cost = base_costs[op_id];
+    for (PropID precond : get_preconditions(op_id))
+        cost = min(cost + get_lane_cost(precond, lane), static_cast<int>(LANE_INFINITY));
+    return cost;
+}
+
+OpID AdditiveHeuristic::get_lane_supporter(PropID prop_id, int lane) const {
+    int cost = get_lane_cost(prop_id, lane);
+    assert(cost != 0 && cost != LANE_INFINITY);
+    /*
+      Like the regular exploration (which keeps the first operator that
+      reaches the cost of the proposition), prefer the supporter whose
+      most expensive precondition is cheapest, i.e., the one that would
+      be applied first.
+    */
+    OpID supporter = NO_OP;
+    int supporter_trigger_cost = LANE_INFINITY;
+    for (int i = achievers_begin[prop_id]; i < achievers_begin[prop_id + 1]; ++i) {
+        OpID op_id = achievers[i];
+        int op_cost = base_costs[op_id];
+        int trigger_cost = 0;
+        for (PropID precond : get_preconditions(op_id)) {
+            int precond_cost = get_lane_cost(precond, lane);
+            op_cost = min(op_cost + precond_cost, static_cast<int>(LANE_INFINITY));
+            trigger_cost = max(trigger_cost, precond_cost);
+        }
+        if (op_cost == cost && trigger_cost < supporter_trigger_cost) {
+            supporter = op_id;
+            supporter_trigger_cost = trigger_cost;
+        }
+    }
+    assert(supporter != NO_OP);
+    return supporter;
+}
+
+int AdditiveHeuristic::get_lane_goal_cost(int lane) {
+    int total_cost = 0;
+    for (PropID goal_id : goal_propositions) {
+        int goal_cost = get_lane_cost(goal_id, lane);
+        if (goal_cost == LANE_INFINITY)
+            return DEAD_END;
+        increase_cost(total_cost, goal_cost);
+    }
+    return total_cost;
+}
+
+void AdditiveHeuristic::compute_heuristics(
+    const vector<GlobalState> &global_states, vector<int> &values) {
+    vector<State> states;
+    states.reserve(global_states.size());
+    for (const GlobalState &global_state : global_states)
+        states.push_back(convert_global_state(global_state));
+    int num_states = states.size();
+    for (int begin = 0; begin < num_states; begin += MAX_LANES) {
+        int end = min(num_states, begin + MAX_LANES);
+        if (explore_in_lanes(states, begin, end)) {
+            for (int lane = 0; lane < num_lanes; ++lane)
+                values.push_back(get_lane_goal_cost(lane));
+        } else {
+            // Let the regular exploration deal with (and warn about) the overflow.
+            for (int i = begin; i < end; ++i)
+                values.push_back(compute_add_and_ff(states[i]));
+        }
+    }
+}
+
 int AdditiveHeuristic::compute_heuristic(const State &state) {
     int h = compute_add_and_ff(state);
     if (h != DEAD_END) {
@@ -146,6 +541,15 @@ void AdditiveHeuristic::compute_heuristic_for_cegar(const State &state) {
     compute_heuristic(state);
 }
 
+void AdditiveHeuristic::add_options_to_parser(OptionParser &parser) {
+    Heuristic::add_options_to_parser(parser);
+    parser.add_option<bool>(
+        "incremental",
+        "repair the relaxed exploration of the previously evaluated state "
+        "instead of exploring each state from scratch",
+        "false");
+}
+
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_synopsis("Additive heuristic", "");
     parser.document_language_support("action costs", "supported");
@@ -160,7 +564,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "yes for tasks without axioms");
     parser.document_property("preferred operators", "yes");
 
-    Heuristic::add_options_to_parser(parser);
+    AdditiveHeuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
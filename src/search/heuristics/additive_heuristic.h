@@ -7,6 +7,8 @@
 #include "../utils/collections.h"
 
 #include <cassert>
+#include <limits>
+#include <vector>
 
 class State;
 
@@ -32,11 +34,83 @@ class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     priority_queues::AdaptiveQueue<PropID> queue;
     bool did_write_overflow_warning;
 
+    /*
+      Incremental exploration: instead of exploring every state from
+      scratch, we keep the cost labels of the last explored state and
+      repair them for the facts that differ between the two states.
+      Facts that are no longer true invalidate all propositions whose
+      best supporter (reached_by) transitively depends on them and that
+      have no other supporter of the same cost; these are re-seeded
+      from their remaining achievers. Together with the
+      facts that became true, they are then propagated with the same
+      Dijkstra-style exploration as in the full computation. This
+      yields the same h^add values as a full exploration, but ties
+      between equally cheap supporters may be broken differently
+      (which can change h^FF values and preferred operators).
+
+      This requires the labels of a complete exploration, i.e., the
+      exploration does not stop once all goals are reached, and is
+      only done if at most half of the variables changed. We fall
+      back to a full exploration otherwise (and permanently after a
+      cost overflow).
+    */
+    const bool incremental;
+    bool has_complete_exploration;
+    // explored_state[var]: proposition of the value of var in the last explored state
+    std::vector<PropID> explored_state;
+    // cost of each proposition as accounted for in the unary operator costs
+    std::vector<int> propagated_cost;
+    // achievers of proposition p: achievers[achievers_begin[p], achievers_begin[p + 1])
+    std::vector<int> achievers_begin;
+    std::vector<OpID> achievers;
+    std::vector<bool> is_dirty;
+    std::vector<PropID> dirty_propositions;
+    std::vector<int> changed_variables;
+    // propositions marked during the extraction of preferred operators
+    std::vector<PropID> marked_propositions;
+
+    /*
+      Batch exploration (see compute_heuristics): the h^add costs of up
+      to MAX_LANES states are computed together, with one lane per
+      state. lane_costs[prop_id * num_lanes + lane] is the cost of the
+      proposition in the state of the lane (LANE_INFINITY if it has not
+      been reached). Unary operators are queued by the minimal cost
+      over the lanes in which one of their preconditions changed and
+      are then evaluated for all lanes at once. Siblings share most of
+      their facts, so most operators are only evaluated once per batch
+      instead of once per state. Since all lanes are updated by the
+      same (branch-free) loops, the compiler can vectorize them.
+    */
+    static const int LANE_INFINITY = std::numeric_limits<int>::max() / 2;
+    static_assert(MAX_COST_VALUE < LANE_INFINITY, "LANE_INFINITY must exceed MAX_COST_VALUE");
+    int num_lanes;
+    std::vector<int> lane_costs;
+    // lane costs of the operator that is currently evaluated
+    std::vector<int> lane_operator_costs;
+    // queued_key[op_id]: key with which the operator is queued (LANE_INFINITY if it is not queued)
+    std::vector<int> queued_key;
+    priority_queues::AdaptiveQueue<OpID> lane_queue;
+
+    void enqueue_operator_in_lanes(OpID op_id, int key) {
+        if (key < queued_key[op_id]) {
+            queued_key[op_id] = key;
+            lane_queue.push(key, op_id);
+        }
+    }
+    void setup_lane_exploration(const std::vector<State> &states, int begin, int end);
+    bool lane_exploration();
+
     void setup_exploration_queue();
     void setup_exploration_queue_state(const State &state);
-    void relaxed_exploration();
+    void relaxed_exploration(bool stop_at_goals);
     void mark_preferred_operators(const State &state, PropID goal_id);
 
+    void build_achievers();
+    void complete_exploration(const State &state);
+    bool find_equivalent_supporter(PropID prop_id);
+    bool update_exploration(const State &state);
+    void mark_dirty(PropID prop_id);
+
     void enqueue_if_necessary(PropID prop_id, int cost, OpID op_id) {
         assert(cost >= 0);
         Proposition *prop = get_proposition(prop_id);
@@ -66,9 +140,53 @@ protected:
 
     // Common part of h^add and h^ff computation.
     int compute_add_and_ff(const State &state);
+
+    void unmark_propositions() {
+        for (PropID prop_id : marked_propositions)
+            get_proposition(prop_id)->marked = false;
+        marked_propositions.clear();
+    }
+
+    static const int MAX_LANES = 64;
+    /*
+      Compute the h^add costs of states[begin, end) (at most MAX_LANES
+      states) in lanes. Returns false if a cost exceeds MAX_COST_VALUE;
+      the lane costs are not exact then. After a successful exploration,
+      the lane costs of all propositions with a cost of at most the
+      most expensive goal in any lane are exact.
+    */
+    bool explore_in_lanes(const std::vector<State> &states, int begin, int end);
+
+    int get_lane_cost(PropID prop_id, int lane) const {
+        assert(lane < num_lanes);
+        return lane_costs[prop_id * num_lanes + lane];
+    }
+
+    // cost of the unary operator in the given lane (after explore_in_lanes)
+    int get_lane_operator_cost(OpID op_id, int lane) const;
+    /*
+      Achiever of the proposition whose cost in the given lane equals the
+      cost of the proposition. The proposition must have been reached by
+      an operator, i.e., it must have a positive finite cost.
+    */
+    OpID get_lane_supporter(PropID prop_id, int lane) const;
+
+    int get_lane_goal_cost(int lane);
+
+    virtual void compute_heuristics(
+        const std::vector<GlobalState> &states, std::vector<int> &values) override;
+
+    void mark_proposition(PropID prop_id) {
+        Proposition *prop = get_proposition(prop_id);
+        assert(!prop->marked);
+        prop->marked = true;
+        marked_propositions.push_back(prop_id);
+    }
 public:
     explicit AdditiveHeuristic(const options::Options &opts);
 
+    static void add_options_to_parser(options::OptionParser &parser);
+
     /*
       TODO: The two methods below are temporarily needed for the CEGAR
       heuristic. In the long run it might be better to split the
@@ -9,10 +9,16 @@ FFDistanceWrapper::FFDistanceWrapper(const options::Options &opts)
 	: Heuristic(opts), ff_heuristic(std::static_pointer_cast<FFHeuristic>(opts.get<std::shared_ptr<Evaluator>>("heuristic"))) {}
 
 auto FFDistanceWrapper::compute_heuristic(const GlobalState &global_state) -> int {
-	if (ff_heuristic->last_evaluated != global_state.get_id())
-		ff_heuristic->compute_heuristic_for_distance_wrapper(global_state);
-	assert(ff_heuristic->last_evaluated == global_state.get_id());
-	return ff_heuristic->last_relaxed_plan_length;
+	if (ff_heuristic->last_evaluated == global_state.get_id())
+		return ff_heuristic->last_relaxed_plan_length;
+	return ff_heuristic->compute_heuristic_for_distance_wrapper(global_state);
+}
+
+void FFDistanceWrapper::compute_heuristics(const std::vector<GlobalState> &states, std::vector<int> &values) {
+	// the relaxed plans are computed by (and stored in) the FF heuristic, so it does not need to be batched separately
+	ff_heuristic->compute_batch(states);
+	for (const auto &state : states)
+		values.push_back(compute_heuristic(state));
 }
 
 static std::shared_ptr<Heuristic> _parse(OptionParser &parser) {
@@ -11,6 +11,7 @@ public:
 	explicit FFDistanceWrapper(const options::Options &opts);
 
 	auto compute_heuristic(const GlobalState &global_state) -> int override;
+	void compute_heuristics(const std::vector<GlobalState> &states, std::vector<int> &values) override;
 	auto dead_ends_are_reliable() const -> bool override { return true; };
 };
 } // namespace ff_heuristic
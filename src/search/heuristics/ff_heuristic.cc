@@ -7,6 +7,7 @@
 #include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -18,14 +19,17 @@ FFHeuristic::FFHeuristic(const Options &opts)
       relaxed_plan(task_proxy.get_operators().size(), false),
       last_evaluated(StateID::no_state),
       last_heuristic_value(0),
-      last_relaxed_plan_length(0) {
+      last_relaxed_plan_length(0),
+      has_zero_cost_operators(
+          any_of(base_costs.begin(), base_costs.end(),
+                 [](int cost) {return cost == 0;})) {
     utils::g_log << "Initializing FF heuristic..." << endl;
 }
 
 void FFHeuristic::mark_preferred_operators_and_relaxed_plan(const State &state, PropID goal_id, bool set_preferred_operators) {
     Proposition *goal = get_proposition(goal_id);
     if (!goal->marked) { // Only consider each subgoal once.
-        goal->marked = true;
+        mark_proposition(goal_id);
         OpID op_id = goal->reached_by;
         if (op_id != NO_OP) { // We have not yet chained back to a start node.
             UnaryOperator *unary_op = get_operator(op_id);
@@ -55,6 +59,80 @@ void FFHeuristic::mark_preferred_operators_and_relaxed_plan(const State &state,
     }
 }
 
+void FFHeuristic::mark_relaxed_plan_in_lane(PropID goal_id, int lane) {
+    Proposition *goal = get_proposition(goal_id);
+    if (!goal->marked) { // Only consider each subgoal once.
+        mark_proposition(goal_id);
+        // All operators have positive cost, so only facts of the state have cost 0.
+        if (get_lane_cost(goal_id, lane) != 0) {
+            OpID op_id = get_lane_supporter(goal_id, lane);
+            for (PropID precond : get_preconditions(op_id))
+                mark_relaxed_plan_in_lane(precond, lane);
+            int operator_no = get_operator(op_id)->operator_no;
+            assert(operator_no != -1);
+            if (!relaxed_plan[operator_no]) {
+                relaxed_plan[operator_no] = true;
+                relaxed_plan_operators.push_back(operator_no);
+            }
+        }
+    }
+}
+
+int FFHeuristic::compute_relaxed_plan_in_lane(int lane) {
+    for (PropID goal_id : goal_propositions)
+        mark_relaxed_plan_in_lane(goal_id, lane);
+    unmark_propositions();
+
+    int h_ff = 0;
+    for (int op_no : relaxed_plan_operators) {
+        relaxed_plan[op_no] = false; // Clean up for next computation.
+        h_ff += task_proxy.get_operators()[op_no].get_cost();
+    }
+    return h_ff;
+}
+
+void FFHeuristic::compute_heuristics(
+    const vector<GlobalState> &global_states, vector<int> &values) {
+    batch_relaxed_plan_lengths.clear();
+    if (has_zero_cost_operators) {
+        for (const GlobalState &global_state : global_states) {
+            values.push_back(compute_heuristic(global_state, false));
+            batch_relaxed_plan_lengths.emplace_back(
+                global_state.get_id(), last_relaxed_plan_length);
+        }
+        return;
+    }
+
+    vector<State> states;
+    states.reserve(global_states.size());
+    for (const GlobalState &global_state : global_states)
+        states.push_back(convert_global_state(global_state));
+    int num_states = states.size();
+    for (int begin = 0; begin < num_states; begin += MAX_LANES) {
+        int end = min(num_states, begin + MAX_LANES);
+        if (explore_in_lanes(states, begin, end)) {
+            for (int lane = 0; lane < end - begin; ++lane) {
+                int h_ff = DEAD_END;
+                int relaxed_plan_length = DEAD_END;
+                if (get_lane_goal_cost(lane) != DEAD_END) {
+                    relaxed_plan_operators.clear();
+                    h_ff = compute_relaxed_plan_in_lane(lane);
+                    relaxed_plan_length = relaxed_plan_operators.size();
+                }
+                values.push_back(h_ff);
+                batch_relaxed_plan_lengths.emplace_back(
+                    global_states[begin + lane].get_id(), relaxed_plan_length);
+            }
+        } else {
+            for (int i = begin; i < end; ++i) {
+                values.push_back(compute_heuristic(global_states[i], false));
+                batch_relaxed_plan_lengths.emplace_back(
+                    global_states[i].get_id(), last_relaxed_plan_length);
+            }
+        }
+    }
+}
+
 auto FFHeuristic::compute_heuristic(const GlobalState &global_state, bool set_preferred_operators) -> int {
     if (global_state.get_id() == last_evaluated) {
         if (set_preferred_operators)
@@ -91,7 +169,13 @@ auto FFHeuristic::compute_heuristic(const GlobalState &global_state, bool set_pr
 }
 
 auto FFHeuristic::compute_heuristic_for_distance_wrapper(const GlobalState &global_state) -> int {
-    return compute_heuristic(global_state, false);
+    StateID id = global_state.get_id();
+    for (const auto &entry : batch_relaxed_plan_lengths) {
+        if (entry.first == id)
+            return entry.second;
+    }
+    compute_heuristic(global_state, false);
+    return last_relaxed_plan_length;
 }
 
 int FFHeuristic::compute_heuristic(const GlobalState &global_state) {
@@ -113,7 +197,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "yes for tasks without axioms");
     parser.document_property("preferred operators", "yes");
 
-    Heuristic::add_options_to_parser(parser);
+    additive_heuristic::AdditiveHeuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
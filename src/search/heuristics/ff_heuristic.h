@@ -3,6 +3,7 @@
 
 #include "additive_heuristic.h"
 
+#include <utility>
 #include <vector>
 
 namespace ff_heuristic {
@@ -35,9 +36,28 @@ class FFHeuristic : public additive_heuristic::AdditiveHeuristic {
     friend class FFDistanceWrapper;
     int last_relaxed_plan_length;
 
+    /*
+      Batch evaluation: the h^add costs are explored in lanes (see
+      AdditiveHeuristic) and the relaxed plans are extracted per lane,
+      choosing the first achiever with matching cost as supporter. Ties
+      between equally cheap supporters can therefore be broken
+      differently than in the regular computation. This requires all
+      unary operators to have positive cost (so that the supporters
+      cannot form cycles), the states are evaluated one by one
+      otherwise.
+    */
+    bool has_zero_cost_operators;
+    std::vector<int> relaxed_plan_operators;
+    // relaxed plan lengths of the states of the last batch
+    std::vector<std::pair<StateID, int>> batch_relaxed_plan_lengths;
+    void mark_relaxed_plan_in_lane(PropID goal_id, int lane);
+    int compute_relaxed_plan_in_lane(int lane);
+
     auto compute_heuristic(const GlobalState &global_state, bool set_preferred_operators) -> int;
     auto compute_heuristic_for_distance_wrapper(const GlobalState &global_state) -> int;
     virtual int compute_heuristic(const GlobalState &global_state) override;
+    virtual void compute_heuristics(
+        const std::vector<GlobalState> &states, std::vector<int> &values) override;
 public:
     explicit FFHeuristic(const options::Options &opts);
 };
@@ -28,6 +28,8 @@ namespace max_heuristic {
 HSPMaxHeuristic::HSPMaxHeuristic(const Options &opts)
     : RelaxationHeuristic(opts) {
     utils::g_log << "Initializing HSP max heuristic..." << endl;
+    if (has_unit_cost_operators)
+        utils::g_log << "All operators have unit cost, exploring in layers." << endl;
 }
 
 // heuristic computation
@@ -37,14 +39,12 @@ void HSPMaxHeuristic::setup_exploration_queue() {
     for (Proposition &prop : propositions)
         prop.cost = -1;
 
-    // Deal with operators and axioms without preconditions.
-    for (UnaryOperator &op : unary_operators) {
-        op.unsatisfied_preconditions = op.num_preconditions;
-        op.cost = op.base_cost; // will be increased by precondition costs
+    // Operator costs will be increased by precondition costs.
+    reset_operators();
 
-        if (op.unsatisfied_preconditions == 0)
-            enqueue_if_necessary(op.effect, op.base_cost);
-    }
+    // Deal with operators and axioms without preconditions.
+    for (OpID op_id : operators_without_preconditions)
+        enqueue_if_necessary(operator_effects[op_id], operator_costs[op_id]);
 }
 
 void HSPMaxHeuristic::setup_exploration_queue_state(const State &state) {
@@ -70,23 +70,73 @@ void HSPMaxHeuristic::relaxed_exploration() {
             return;
         for (OpID op_id : precondition_of_pool.get_slice(
                  prop->precondition_of, prop->num_precondition_occurences)) {
-            UnaryOperator *unary_op = get_operator(op_id);
-            unary_op->cost = max(unary_op->cost,
-                                 unary_op->base_cost + prop_cost);
-            --unary_op->unsatisfied_preconditions;
-            assert(unary_op->unsatisfied_preconditions >= 0);
-            if (unary_op->unsatisfied_preconditions == 0)
-                enqueue_if_necessary(unary_op->effect, unary_op->cost);
+            operator_costs[op_id] = max(operator_costs[op_id],
+                                        base_costs[op_id] + prop_cost);
+            --unsatisfied_preconditions[op_id];
+            assert(unsatisfied_preconditions[op_id] >= 0);
+            if (unsatisfied_preconditions[op_id] == 0)
+                enqueue_if_necessary(operator_effects[op_id], operator_costs[op_id]);
+        }
+    }
+}
+
+void HSPMaxHeuristic::layered_exploration(const State &state) {
+    assert(has_unit_cost_operators);
+    for (Proposition &prop : propositions)
+        prop.cost = -1;
+    reset_operators();
+
+    current_layer.clear();
+    next_layer.clear();
+    for (FactProxy fact : state) {
+        PropID init_prop = get_prop_id(fact);
+        propositions[init_prop].cost = 0;
+        current_layer.push_back(init_prop);
+    }
+    for (OpID op_id : operators_without_preconditions) {
+        Proposition &effect = propositions[operator_effects[op_id]];
+        if (effect.cost == -1) {
+            effect.cost = 1;
+            next_layer.push_back(operator_effects[op_id]);
         }
     }
+
+    int unsolved_goals = goal_propositions.size();
+    for (int layer = 0; !current_layer.empty(); ++layer) {
+        for (PropID prop_id : current_layer) {
+            const Proposition &prop = propositions[prop_id];
+            assert(prop.cost == layer);
+            if (prop.is_goal && --unsolved_goals == 0)
+                return;
+            for (OpID op_id : precondition_of_pool.get_slice(
+                     prop.precondition_of, prop.num_precondition_occurences)) {
+                assert(unsatisfied_preconditions[op_id] > 0);
+                if (--unsatisfied_preconditions[op_id] == 0) {
+                    // All preconditions are reached, the last one in this layer.
+                    PropID effect_id = operator_effects[op_id];
+                    Proposition &effect = propositions[effect_id];
+                    if (effect.cost == -1) {
+                        effect.cost = layer + 1;
+                        next_layer.push_back(effect_id);
+                    }
+                }
+            }
+        }
+        current_layer.swap(next_layer);
+        next_layer.clear();
+    }
 }
 
 int HSPMaxHeuristic::compute_heuristic(const GlobalState &global_state) {
     const State state = convert_global_state(global_state);
 
-    setup_exploration_queue();
-    setup_exploration_queue_state(state);
-    relaxed_exploration();
+    if (has_unit_cost_operators) {
+        layered_exploration(state);
+    } else {
+        setup_exploration_queue();
+        setup_exploration_queue_state(state);
+        relaxed_exploration();
+    }
 
     int total_cost = 0;
     for (PropID goal_id : goal_propositions) {
@@ -6,6 +6,7 @@
 #include "../algorithms/priority_queues.h"
 
 #include <cassert>
+#include <vector>
 
 namespace max_heuristic {
 using relaxation_heuristic::PropID;
@@ -17,10 +18,22 @@ using relaxation_heuristic::UnaryOperator;
 class HSPMaxHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     priority_queues::AdaptiveQueue<PropID> queue;
 
+    // propositions reached in the current and next layer of layered_exploration
+    std::vector<PropID> current_layer;
+    std::vector<PropID> next_layer;
+
     void setup_exploration_queue();
     void setup_exploration_queue_state(const State &state);
     void relaxed_exploration();
 
+    /*
+      Exploration for tasks where all unary operators have cost 1: the
+      h^max cost of a proposition is the first layer in which it is
+      reached, so we can process the propositions layer by layer
+      without a priority queue and without computing operator costs.
+    */
+    void layered_exploration(const State &state);
+
     void enqueue_if_necessary(PropID prop_id, int cost) {
         assert(cost >= 0);
         Proposition *prop = get_proposition(prop_id);
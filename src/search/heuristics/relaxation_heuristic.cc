@@ -88,6 +88,30 @@ RelaxationHeuristic::RelaxationHeuristic(const options::Options &opts)
             precondition_of_pool.append(precondition_of_vec);
         propositions[prop_id].num_precondition_occurences = precondition_of_vec.size();
     }
+
+    // Build the exploration state of the unary operators.
+    base_costs.reserve(num_unary_ops);
+    num_preconditions.reserve(num_unary_ops);
+    operator_effects.reserve(num_unary_ops);
+    has_unit_cost_operators = true;
+    for (OpID op_id = 0; op_id < num_unary_ops; ++op_id) {
+        const UnaryOperator &op = unary_operators[op_id];
+        base_costs.push_back(op.base_cost);
+        num_preconditions.push_back(op.num_preconditions);
+        operator_effects.push_back(op.effect);
+        if (op.num_preconditions == 0)
+            operators_without_preconditions.push_back(op_id);
+        if (op.base_cost != 1)
+            has_unit_cost_operators = false;
+    }
+    operator_costs.resize(num_unary_ops);
+    unsatisfied_preconditions.resize(num_unary_ops);
+}
+
+void RelaxationHeuristic::reset_operators() {
+    copy(base_costs.begin(), base_costs.end(), operator_costs.begin());
+    copy(num_preconditions.begin(), num_preconditions.end(),
+         unsatisfied_preconditions.begin());
 }
 
 bool RelaxationHeuristic::dead_ends_are_reliable() const {
@@ -38,14 +38,16 @@ struct Proposition {
 
 static_assert(sizeof(Proposition) == 16, "Proposition has wrong size");
 
+/*
+  Static data of a unary operator. The data that changes during an
+  exploration (cost and number of unsatisfied preconditions) is stored
+  separately in RelaxationHeuristic (see below).
+*/
 struct UnaryOperator {
     UnaryOperator(int num_preconditions,
                   array_pool::ArrayPoolIndex preconditions,
                   PropID effect,
                   int operator_no, int base_cost);
-    int cost; // Used for h^max cost or h^add cost;
-              // includes operator cost (base_cost)
-    int unsatisfied_preconditions;
     PropID effect;
     int base_cost;
     int num_preconditions;
@@ -53,7 +55,7 @@ struct UnaryOperator {
     int operator_no; // -1 for axioms; index into the task's operators otherwise
 };
 
-static_assert(sizeof(UnaryOperator) == 28, "UnaryOperator has wrong size");
+static_assert(sizeof(UnaryOperator) == 20, "UnaryOperator has wrong size");
 
 class RelaxationHeuristic : public Heuristic {
     void build_unary_operators(const OperatorProxy &op);
@@ -61,6 +63,9 @@ class RelaxationHeuristic : public Heuristic {
 
     // proposition_offsets[var_no]: first PropID related to variable var_no
     std::vector<PropID> proposition_offsets;
+
+    // initial values of unsatisfied_preconditions
+    std::vector<int> num_preconditions;
 protected:
     std::vector<UnaryOperator> unary_operators;
     std::vector<Proposition> propositions;
@@ -69,6 +74,35 @@ protected:
     array_pool::ArrayPool preconditions_pool;
     array_pool::ArrayPool precondition_of_pool;
 
+    /*
+      Exploration state of the unary operators in structure-of-arrays
+      layout, indexed by OpID. The inner loop of the explorations only
+      touches these arrays (and operator_effects) instead of the full
+      UnaryOperator structs, and resetting them for a new exploration
+      is a plain copy of the initial values.
+
+      operator_costs[op_id]: h^max or h^add cost of the operator
+      (including its base cost)
+      unsatisfied_preconditions[op_id]: number of preconditions that
+      have not been reached yet
+      operator_effects[op_id], base_costs[op_id]: copies of the effect
+      and base cost of unary_operators[op_id]
+    */
+    std::vector<int> operator_costs;
+    std::vector<int> unsatisfied_preconditions;
+    std::vector<PropID> operator_effects;
+    std::vector<int> base_costs;
+    // operators without preconditions
+    std::vector<OpID> operators_without_preconditions;
+    /*
+      True if all unary operators have cost 1, i.e., the task has unit
+      costs and no axioms. Then the h^max cost of each proposition is
+      the first layer of the exploration in which it is reached.
+    */
+    bool has_unit_cost_operators;
+
+    void reset_operators();
+
     array_pool::ArrayPoolSlice get_preconditions(OpID op_id) const {
         const UnaryOperator &op = unary_operators[op_id];
         return preconditions_pool.get_slice(op.preconditions, op.num_preconditions);
@@ -4,6 +4,7 @@
 #include "per_state_information.h"
 
 #include <cassert>
+#include <string>
 #include <unordered_map>
 
 class GlobalState;
@@ -47,21 +48,25 @@ public:
 
 template<class Element>
 class PerStateArray : public subscriber::Subscriber<StateRegistry> {
+    using EntryArrayVector = segmented_vector::SegmentedArrayVector<
+        Element, segment_arena::SegmentArenaAllocator<Element>>;
+
     const std::vector<Element> default_array;
-    using EntryArrayVectorMap = std::unordered_map<const StateRegistry *,
-                                                   segmented_vector::SegmentedArrayVector<Element> *>;
+    const std::string name;
+    using EntryArrayVectorMap = std::unordered_map<const StateRegistry *, EntryArrayVector *>;
     EntryArrayVectorMap entry_arrays_by_registry;
 
     mutable const StateRegistry *cached_registry;
-    mutable segmented_vector::SegmentedArrayVector<Element> *cached_entries;
+    mutable EntryArrayVector *cached_entries;
 
-    segmented_vector::SegmentedArrayVector<Element> *get_entries(const StateRegistry *registry) {
+    EntryArrayVector *get_entries(const StateRegistry *registry) {
         if (cached_registry != registry) {
             cached_registry = registry;
             auto it = entry_arrays_by_registry.find(registry);
             if (it == entry_arrays_by_registry.end()) {
-                cached_entries = new segmented_vector::SegmentedArrayVector<Element>(
-                    default_array.size());
+                cached_entries = new EntryArrayVector(
+                    default_array.size(),
+                    registry->get_per_state_allocator<Element>(name));
                 entry_arrays_by_registry[registry] = cached_entries;
                 registry->subscribe(this);
             } else {
@@ -72,16 +77,14 @@ class PerStateArray : public subscriber::Subscriber<StateRegistry> {
         return cached_entries;
     }
 
-    const segmented_vector::SegmentedArrayVector<Element> *get_entries(
-        const StateRegistry *registry) const {
+    const EntryArrayVector *get_entries(const StateRegistry *registry) const {
         if (cached_registry != registry) {
             const auto it = entry_arrays_by_registry.find(registry);
             if (it == entry_arrays_by_registry.end()) {
                 return nullptr;
             } else {
                 cached_registry = registry;
-                cached_entries = const_cast<segmented_vector::SegmentedArrayVector<Element> *>(
-                    it->second);
+                cached_entries = const_cast<EntryArrayVector *>(it->second);
             }
         }
         assert(cached_registry == registry);
@@ -89,8 +92,11 @@ class PerStateArray : public subscriber::Subscriber<StateRegistry> {
     }
 
 public:
-    explicit PerStateArray(const std::vector<Element> &default_array)
+    explicit PerStateArray(
+        const std::vector<Element> &default_array,
+        const std::string &name = "unnamed")
         : default_array(default_array),
+          name(name),
           cached_registry(nullptr),
           cached_entries(nullptr) {
     }
@@ -106,8 +112,8 @@ public:
 
     ArrayView<Element> operator[](const GlobalState &state) {
         const StateRegistry *registry = &state.get_registry();
-        segmented_vector::SegmentedArrayVector<Element> *entries = get_entries(registry);
-        int state_id = state.get_id().value;
+        EntryArrayVector *entries = get_entries(registry);
+        StateID::Value state_id = state.get_id().value;
         size_t virtual_size = registry->size();
         assert(utils::in_bounds(state_id, *registry));
         if (entries->size() < virtual_size) {
@@ -10,6 +10,9 @@
 #include "utils/collections.h"
 
 #include <cassert>
+#include <memory>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
 
 /*
@@ -36,16 +39,32 @@
   stores information. Once a StateRegistry is destroyed, it notifies all
   subscribed objects, which in turn destroy all information stored for states
   in that registry.
+
+  The segments of the SegmentedVectors are allocated with the per-state
+  allocator of the registry (see StateRegistry::get_per_state_allocator),
+  which accounts them to the name of the PerStateInformation object.
+
+  A PerStateInformation object can alternatively store its entries as a
+  field of the per-state records of the registries (see per_state_record.h),
+  so that it shares one memory location per state with the other fields.
+  Then it only falls back to its own SegmentedVectors for registries whose
+  records do not contain the field.
 */
 template<class Entry>
 class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
+    using EntryVector = segmented_vector::SegmentedVector<
+        Entry, segment_arena::SegmentArenaAllocator<Entry>>;
+
     const Entry default_value;
-    using EntryVectorMap = std::unordered_map<const StateRegistry *,
-                                              segmented_vector::SegmentedVector<Entry> * >;
+    const std::string name;
+    // Layout declaring the field of the entries in the per-state records, or null if not stored there.
+    const std::shared_ptr<PerStateRecordLayout> record_layout;
+    const int record_field;
+    using EntryVectorMap = std::unordered_map<const StateRegistry *, EntryVector *>;
     EntryVectorMap entries_by_registry;
 
     mutable const StateRegistry *cached_registry;
-    mutable segmented_vector::SegmentedVector<Entry> *cached_entries;
+    mutable EntryVector *cached_entries;
 
     /*
       Returns the SegmentedVector associated with the given StateRegistry.
@@ -53,12 +72,13 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
       Both the registry and the returned vector are cached to speed up
       consecutive calls with the same registry.
     */
-    segmented_vector::SegmentedVector<Entry> *get_entries(const StateRegistry *registry) {
+    EntryVector *get_entries(const StateRegistry *registry) {
         if (cached_registry != registry) {
             cached_registry = registry;
             auto it = entries_by_registry.find(registry);
             if (it == entries_by_registry.end()) {
-                cached_entries = new segmented_vector::SegmentedVector<Entry>();
+                cached_entries = new EntryVector(
+                    registry->get_per_state_allocator<Entry>(name));
                 entries_by_registry[registry] = cached_entries;
                 registry->subscribe(this);
             } else {
@@ -75,14 +95,14 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
       Otherwise, both the registry and the returned vector are cached to speed
       up consecutive calls with the same registry.
     */
-    const segmented_vector::SegmentedVector<Entry> *get_entries(const StateRegistry *registry) const {
+    const EntryVector *get_entries(const StateRegistry *registry) const {
         if (cached_registry != registry) {
             const auto it = entries_by_registry.find(registry);
             if (it == entries_by_registry.end()) {
                 return nullptr;
             } else {
                 cached_registry = registry;
-                cached_entries = const_cast<segmented_vector::SegmentedVector<Entry> *>(it->second);
+                cached_entries = const_cast<EntryVector *>(it->second);
             }
         }
         assert(cached_registry == registry);
@@ -92,12 +112,41 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
 public:
     PerStateInformation()
         : default_value(),
+          name("unnamed"),
+          record_layout(nullptr),
+          record_field(-1),
           cached_registry(nullptr),
           cached_entries(nullptr) {
     }
 
     explicit PerStateInformation(const Entry &default_value_)
         : default_value(default_value_),
+          name("unnamed"),
+          record_layout(nullptr),
+          record_field(-1),
+          cached_registry(nullptr),
+          cached_entries(nullptr) {
+    }
+
+    /*
+      The name is only used for the memory statistics of the per-state
+      allocator. If in_record is true, the entries are stored in the per-state
+      records if Entry is trivially copyable (otherwise they are always
+      stored separately). The field is declared in the layout of the calling
+      thread, so only registries constructed by this thread store it in their
+      records.
+    */
+    PerStateInformation(
+        const Entry &default_value_, const std::string &name, bool in_record = false)
+        : default_value(default_value_),
+          name(name),
+          record_layout(
+              in_record && std::is_trivially_copyable<Entry>::value ?
+              get_per_state_record_layout() : nullptr),
+          record_field(
+              record_layout ?
+              record_layout->add_field(
+                  sizeof(Entry), alignof(Entry), &default_value_) : -1),
           cached_registry(nullptr),
           cached_entries(nullptr) {
     }
@@ -106,15 +155,41 @@ public:
     PerStateInformation &operator=(const PerStateInformation<Entry> &) = delete;
 
     virtual ~PerStateInformation() override {
+        if (record_layout) {
+            record_layout->remove_field(record_field);
+        }
         for (auto it : entries_by_registry) {
             delete it.second;
         }
     }
 
     Entry &operator[](const GlobalState &state) {
-        const StateRegistry *registry = &state.get_registry();
-        segmented_vector::SegmentedVector<Entry> *entries = get_entries(registry);
-        int state_id = state.get_id().value;
+        return get(state.get_registry(), state.get_id());
+    }
+
+    const Entry &operator[](const GlobalState &state) const {
+        return get(state.get_registry(), state.get_id());
+    }
+
+    /*
+      Access the entry of a state by its ID. This is useful for callers that
+      only store state IDs, since it avoids looking up the state data.
+    */
+    Entry &get(const StateRegistry &state_registry, StateID id) {
+        const StateRegistry *registry = &state_registry;
+        if (record_layout) {
+            PerStateRecords *records = registry->get_per_state_records();
+            if (records && records->contains_field(record_layout.get(), record_field)) {
+                StateID::Value state_id = id.value;
+                assert(utils::in_bounds(state_id, *registry));
+                if (records->size() <= static_cast<size_t>(state_id)) {
+                    records->grow(registry->size());
+                }
+                return *static_cast<Entry *>(records->get_field(state_id, record_field));
+            }
+        }
+        EntryVector *entries = get_entries(registry);
+        StateID::Value state_id = id.value;
         size_t virtual_size = registry->size();
         assert(utils::in_bounds(state_id, *registry));
         if (entries->size() < virtual_size) {
@@ -123,15 +198,27 @@ public:
         return (*entries)[state_id];
     }
 
-    const Entry &operator[](const GlobalState &state) const {
-        const StateRegistry *registry = &state.get_registry();
-        const segmented_vector::SegmentedVector<Entry> *entries = get_entries(registry);
+    const Entry &get(const StateRegistry &state_registry, StateID id) const {
+        const StateRegistry *registry = &state_registry;
+        if (record_layout) {
+            const PerStateRecords *records = registry->get_per_state_records();
+            if (records && records->contains_field(record_layout.get(), record_field)) {
+                StateID::Value state_id = id.value;
+                assert(utils::in_bounds(state_id, *registry));
+                if (records->size() <= static_cast<size_t>(state_id)) {
+                    return default_value;
+                }
+                return *static_cast<const Entry *>(
+                    records->get_field(state_id, record_field));
+            }
+        }
+        const EntryVector *entries = get_entries(registry);
         if (!entries) {
             return default_value;
         }
-        int state_id = state.get_id().value;
+        StateID::Value state_id = id.value;
         assert(utils::in_bounds(state_id, *registry));
-        int num_entries = entries->size();
+        StateID::Value num_entries = entries->size();
         if (state_id >= num_entries) {
             return default_value;
         }
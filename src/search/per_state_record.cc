@@ -0,0 +1,68 @@
+#include "per_state_record.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+using namespace std;
+
+static size_t round_up(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+const size_t PerStateRecordLayout::NO_OFFSET = numeric_limits<size_t>::max();
+
+int PerStateRecordLayout::add_field(
+    size_t size, size_t alignment, const void *default_value) {
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    const char *bytes = static_cast<const char *>(default_value);
+    fields.push_back({size, alignment, vector<char>(bytes, bytes + size), false});
+    return fields.size() - 1;
+}
+
+void PerStateRecordLayout::remove_field(int field) {
+    assert(!fields[field].removed);
+    fields[field].removed = true;
+    fields[field].default_value.clear();
+    fields[field].default_value.shrink_to_fit();
+}
+
+vector<char> PerStateRecordLayout::create_default_record(vector<size_t> &offsets) const {
+    offsets.assign(fields.size(), NO_OFFSET);
+    vector<char> record;
+    size_t record_alignment = 1;
+    for (size_t field = 0; field < fields.size(); ++field) {
+        const Field &info = fields[field];
+        if (info.removed)
+            continue;
+        size_t offset = round_up(record.size(), info.alignment);
+        record.resize(offset + info.size, 0);
+        memcpy(record.data() + offset, info.default_value.data(), info.size);
+        record_alignment = max(record_alignment, info.alignment);
+        offsets[field] = offset;
+    }
+    // Records are never empty, so that they can be stored in a SegmentedArrayVector.
+    record.resize(max(round_up(record.size(), record_alignment), record_alignment), 0);
+    return record;
+}
+
+shared_ptr<PerStateRecordLayout> get_per_state_record_layout() {
+    /*
+      The layout is shared with the registries and PerStateInformation
+      objects using it, since they may outlive the thread.
+    */
+    static thread_local shared_ptr<PerStateRecordLayout> layout =
+        make_shared<PerStateRecordLayout>();
+    return layout;
+}
+
+
+PerStateRecords::PerStateRecords(
+    const shared_ptr<const PerStateRecordLayout> &layout,
+    const segment_arena::SegmentArenaAllocator<char> &allocator)
+    : layout(layout),
+      // offsets is declared before default_record and thus already constructed.
+      default_record(layout->create_default_record(offsets)),
+      records(default_record.size(), allocator) {
+}
@@ -0,0 +1,127 @@
+#ifndef PER_STATE_RECORD_H
+#define PER_STATE_RECORD_H
+
+#include "state_id.h"
+
+#include "algorithms/segment_arena.h"
+#include "algorithms/segmented_vector.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/*
+  Per-state records store the per-state information of several components
+  (search node infos, heuristic caches, ...) of a state next to each other,
+  so that looking up all information about a state touches one location in
+  memory instead of one location per component.
+
+  Components declare the fields they need with
+  PerStateRecordLayout::add_field when they are constructed. Usually this is
+  done implicitly by constructing a PerStateInformation object with
+  in_record = true, which declares its field in the layout of the calling
+  thread (see get_per_state_record_layout) and removes it again when it is
+  destroyed. A StateRegistry uses the layout of the thread that constructs
+  it. It lays out the records of its states when they are first accessed,
+  and from then on stores all fields of its layout that exist at this time
+  in one record per state. Fields that are declared later, or that belong to
+  another layout, are not part of the records of this registry;
+  PerStateInformation then stores them separately.
+
+  Since a search engine and its components are constructed by the same
+  thread, the records of an engine only contain the fields of the engines
+  constructed by this thread that are alive when its registry lays out its
+  records. In particular, the engines that parallel engines construct in
+  their worker threads do not share a layout. A layout must only be used by
+  one thread at a time.
+
+  Since the fields are copied and initialized as raw memory, their types must
+  be trivially copyable.
+*/
+class PerStateRecordLayout {
+    struct Field {
+        std::size_t size;
+        std::size_t alignment;
+        std::vector<char> default_value;
+        bool removed;
+    };
+
+    std::vector<Field> fields;
+public:
+    // Offset of fields that are not part of a record.
+    static const std::size_t NO_OFFSET;
+
+    /*
+      Declare a field of the given size and alignment whose initial value is
+      given by the bytes at default_value. Returns the index of the field.
+    */
+    int add_field(std::size_t size, std::size_t alignment, const void *default_value);
+
+    /*
+      Remove a field from the records laid out from now on. Field indices are
+      not reused.
+    */
+    void remove_field(int field);
+
+    int get_num_fields() const {
+        return fields.size();
+    }
+
+    /*
+      Lay out a record containing all fields that have not been removed. Sets
+      offsets[field] to the offset of each field in the record (NO_OFFSET for
+      removed fields) and returns the record containing the default values of
+      the fields, padded so that consecutive records are aligned.
+    */
+    std::vector<char> create_default_record(std::vector<std::size_t> &offsets) const;
+};
+
+// Returns the layout of the calling thread.
+extern std::shared_ptr<PerStateRecordLayout> get_per_state_record_layout();
+
+
+/*
+  The per-state records of the states of one registry, laid out according to
+  the fields of the given layout when the object is created.
+*/
+class PerStateRecords {
+    const std::shared_ptr<const PerStateRecordLayout> layout;
+    std::vector<std::size_t> offsets;
+    const std::vector<char> default_record;
+    segmented_vector::SegmentedArrayVector<
+        char, segment_arena::SegmentArenaAllocator<char>> records;
+public:
+    PerStateRecords(
+        const std::shared_ptr<const PerStateRecordLayout> &layout,
+        const segment_arena::SegmentArenaAllocator<char> &allocator);
+
+    bool contains_field(const PerStateRecordLayout *field_layout, int field) const {
+        return field_layout == layout.get() &&
+               static_cast<std::size_t>(field) < offsets.size() &&
+               offsets[field] != PerStateRecordLayout::NO_OFFSET;
+    }
+
+    std::size_t size() const {
+        return records.size();
+    }
+
+    // Add default records until there are at least num_states records.
+    void grow(std::size_t num_states) {
+        while (records.size() < num_states)
+            records.push_back(default_record.data());
+    }
+
+    void *get_field(StateID::Value id, int field) {
+        return records[id] + offsets[field];
+    }
+
+    const void *get_field(StateID::Value id, int field) const {
+        return records[id] + offsets[field];
+    }
+
+    std::size_t get_record_size() const {
+        return default_record.size();
+    }
+};
+
+#endif
@@ -24,12 +24,13 @@ using utils::ExitCode;
 
 class PruningMethod;
 
-successor_generator::SuccessorGenerator &get_successor_generator(const TaskProxy &task_proxy) {
+successor_generator::SuccessorGenerator &get_successor_generator(
+    const TaskProxy &task_proxy, successor_generator::Backend backend) {
     utils::g_log << "Building successor generator..." << flush;
     int peak_memory_before = utils::get_peak_memory_in_kb();
     utils::Timer successor_generator_timer;
     successor_generator::SuccessorGenerator &successor_generator =
-        successor_generator::g_successor_generators[task_proxy];
+        successor_generator::get_successor_generators(backend)[task_proxy];
     successor_generator_timer.stop();
     utils::g_log << "done!" << endl;
     int peak_memory_after = utils::get_peak_memory_in_kb();
@@ -44,10 +45,18 @@ successor_generator::SuccessorGenerator &get_successor_generator(const TaskProxy
 SearchEngine::SearchEngine(const Options &opts)
     : status(IN_PROGRESS),
       solution_found(false),
+      interrupted(false),
       task(tasks::g_root_task),
       task_proxy(*task),
-      state_registry(task_proxy),
-      successor_generator(get_successor_generator(task_proxy)),
+      state_registry(
+          task_proxy, opts.get<StateStorage>("state_storage"),
+          opts.get<int>("delta_encoding_interval"),
+          opts.get<int>("decoded_state_cache_size"),
+          opts.get<PerStateStorage>("per_state_storage"),
+          static_cast<size_t>(opts.get<int>("per_state_reserved_memory")) * 1024 * 1024,
+          opts.get<bool>("per_state_records")),
+      successor_generator(get_successor_generator(
+                              task_proxy, opts.get<successor_generator::Backend>("successor_generator"))),
       search_space(state_registry),
       search_progress(opts.get<utils::Verbosity>("verbosity")),
       statistics(opts.get<utils::Verbosity>("verbosity")),
@@ -89,6 +98,11 @@ void SearchEngine::search() {
     utils::CountdownTimer timer(max_time);
     while (status == IN_PROGRESS) {
         status = step();
+        if (status == IN_PROGRESS && interrupted.load(memory_order_relaxed)) {
+            utils::g_log << "Search interrupted." << endl;
+            status = INTERRUPTED;
+            break;
+        }
         if (timer.is_expired()) {
             utils::g_log << "Time limit reached. Abort search." << endl;
             status = TIMEOUT;
@@ -99,6 +113,10 @@ void SearchEngine::search() {
     utils::g_log << "Actual search time: " << timer.get_elapsed_time() << endl;
 }
 
+void SearchEngine::interrupt() {
+    interrupted.store(true, memory_order_relaxed);
+}
+
 bool SearchEngine::check_goal_and_set_plan(const GlobalState &state) {
     if (task_properties::is_goal_state(task_proxy, state)) {
         utils::g_log << "Solution found!" << endl;
@@ -149,6 +167,66 @@ void SearchEngine::add_options_to_parser(OptionParser &parser) {
         "experiments. Timed-out searches are treated as failed searches, "
         "just like incomplete search algorithms that exhaust their search space.",
         "infinity");
+    parser.add_enum_option<StateStorage>(
+        "state_storage",
+        {"MEMORY", "MAPPED_FILE"},
+        "where to store the registered states. MAPPED_FILE stores them in a "
+        "memory-mapped temporary file in $TMPDIR (default: /tmp), so that the "
+        "operating system can write out the data of states that were not "
+        "accessed recently instead of swapping. Not supported on Windows.",
+        "MEMORY");
+    parser.add_option<int>(
+        "delta_encoding_interval",
+        "if positive, store registered states as the packed bins that differ "
+        "from their parent state, with a full copy of at least every n-th "
+        "state along each path. This saves memory for tasks with many "
+        "variables at the cost of decoding states on lookup. Lookups update "
+        "a cache of decoded states, so delta encoding is not supported by "
+        "multi-threaded search engines (parallel_portfolio, hda).",
+        "0",
+        Bounds("0", "65535"));
+    parser.add_option<int>(
+        "decoded_state_cache_size",
+        "number of recently used states that are kept in decoded form if "
+        "delta_encoding_interval is positive",
+        "10000",
+        Bounds("1", "infinity"));
+    parser.add_enum_option<PerStateStorage>(
+        "per_state_storage",
+        {"MEMORY", "HUGE_PAGES", "RESERVED_RANGE"},
+        "where to allocate the per-state information of the search (search "
+        "nodes, heuristic caches, etc.). MEMORY uses the heap. HUGE_PAGES "
+        "allocates it in 2 MB blocks backed by huge pages where possible. "
+        "RESERVED_RANGE allocates it from one range of virtual memory of size "
+        "per_state_reserved_memory with transparent huge pages. Both "
+        "report the memory used by each kind of information in the "
+        "statistics. Only supported on Linux.",
+        "MEMORY");
+    parser.add_option<int>(
+        "per_state_reserved_memory",
+        "size in MB of the virtual memory range reserved for "
+        "per_state_storage=RESERVED_RANGE. At most half of the address space "
+        "limit is reserved. Note that the reserved range is included in the "
+        "reported peak memory (which measures virtual memory).",
+        "16384",
+        Bounds("2", "infinity"));
+    parser.add_option<bool>(
+        "per_state_records",
+        "store the per-state information that is accessed on most expansions "
+        "(search nodes, cached evaluator values, etc.) of each state together "
+        "in one record instead of in separate tables",
+        "true");
+    parser.add_enum_option<successor_generator::Backend>(
+        "successor_generator",
+        {"TREE", "FLAT", "PRECONDITION_MASKS"},
+        "how to compute the applicable operators of a state. TREE walks a "
+        "decision tree over the preconditions, FLAT walks the same tree "
+        "compiled into a flat table that is read without recursion, and "
+        "PRECONDITION_MASKS tests the preconditions of all operators with "
+        "bit masks on the packed state. All generate the same operators in "
+        "the same order. Which one is fastest depends on the task "
+        "(benchmarks/successor_generator_benchmark.cc compares them).",
+        "TREE");
     utils::add_verbosity_option_to_parser(parser);
 }
 
@@ -10,6 +10,7 @@
 #include "state_registry.h"
 #include "task_proxy.h"
 
+#include <atomic>
 #include <vector>
 
 namespace options {
@@ -30,12 +31,13 @@ namespace utils {
 enum class Verbosity;
 }
 
-enum SearchStatus {IN_PROGRESS, TIMEOUT, FAILED, SOLVED};
+enum SearchStatus {IN_PROGRESS, TIMEOUT, FAILED, SOLVED, INTERRUPTED};
 
 class SearchEngine {
     SearchStatus status;
     bool solution_found;
     Plan plan;
+    std::atomic<bool> interrupted;
 protected:
     // Hold a reference to the task implementation and pass it to objects that need it.
     const std::shared_ptr<AbstractTask> task;
@@ -69,10 +71,18 @@ public:
     SearchStatus get_status() const;
     const Plan &get_plan() const;
     void search();
+    /*
+      Make search() stop with status INTERRUPTED after the current step.
+      In contrast to all other methods, this may be called from a thread
+      other than the one running the search.
+    */
+    void interrupt();
     const SearchStatistics &get_statistics() const {return statistics;}
     void set_bound(int b) {bound = b;}
     int get_bound() {return bound;}
     PlanManager &get_plan_manager() {return plan_manager;}
+    // Delta-encoded state registries must only be used by one thread.
+    bool uses_delta_encoding() const {return state_registry.uses_delta_encoding();}
 
     /* The following three methods should become functions as they
        do not require access to private/protected class members. */
@@ -0,0 +1,206 @@
+#include "parallel_portfolio_search.h"
+
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../utils/logging.h"
+#include "../utils/system.h"
+#include "../utils/timer.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+namespace parallel_portfolio_search {
+static const char *get_status_name(SearchStatus status) {
+    switch (status) {
+    case IN_PROGRESS:
+        return "in progress";
+    case TIMEOUT:
+        return "timeout";
+    case FAILED:
+        return "failed";
+    case SOLVED:
+        return "solved";
+    case INTERRUPTED:
+        return "interrupted";
+    }
+    return "unknown";
+}
+
+ParallelPortfolioSearch::ParallelPortfolioSearch(
+    const Options &opts, options::Registry &registry)
+    : SearchEngine(opts),
+      engine_configs(opts.get_list<ParseTree>("engine_configs")),
+      registry(registry),
+      engines(engine_configs.size()),
+      engine_statuses(engine_configs.size(), IN_PROGRESS),
+      engine_search_times(engine_configs.size(), 0),
+      num_constructed(0),
+      num_finished(0),
+      winner(-1),
+      stopping(false) {
+}
+
+void ParallelPortfolioSearch::run_engine(int index) {
+    int num_engines = engine_configs.size();
+    shared_ptr<SearchEngine> engine;
+    {
+        /*
+          The engines are constructed one after the other, since their
+          components fill the task-level caches shared by all engines on
+          construction. Searching only starts when all engines are
+          constructed, after which these caches are only read.
+        */
+        unique_lock<mutex> lock(engines_mutex);
+        OptionParser parser(engine_configs[index], registry, no_predefinitions, false);
+        engine = parser.start_parsing<shared_ptr<SearchEngine>>();
+        if (engine->uses_delta_encoding()) {
+            cerr << "Parallel portfolio search does not support delta-encoded "
+                 << "state registries, exiting." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+        }
+        engine->set_bound(min(engine->get_bound(), bound));
+        engines[index] = engine;
+
+        ostringstream stream;
+        kptree::print_tree_bracketed(engine_configs[index], stream);
+        utils::g_log << "Constructed portfolio engine " << index << ": "
+                     << stream.str() << endl;
+
+        ++num_constructed;
+        state_changed.notify_all();
+        state_changed.wait(lock, [&]() {
+                               return num_constructed == num_engines || stopping;
+                           });
+        if (stopping)
+            engine->interrupt();
+    }
+
+    utils::Timer search_timer;
+    engine->search();
+    search_timer.stop();
+
+    {
+        lock_guard<mutex> lock(engines_mutex);
+        engine_statuses[index] = engine->get_status();
+        engine_search_times[index] = search_timer();
+        ++num_finished;
+        // the bounds of the engines are clamped to the portfolio bound, so
+        // every plan they find respects it
+        if (winner == -1 && engine->found_solution()) {
+            winner = index;
+        }
+    }
+    state_changed.notify_all();
+}
+
+void ParallelPortfolioSearch::stop_engines() {
+    stopping = true;
+    for (const shared_ptr<SearchEngine> &engine : engines) {
+        if (engine)
+            engine->interrupt();
+    }
+    state_changed.notify_all();
+}
+
+SearchStatus ParallelPortfolioSearch::step() {
+    int num_engines = engine_configs.size();
+    vector<thread> threads;
+    threads.reserve(num_engines);
+    for (int i = 0; i < num_engines; ++i) {
+        threads.emplace_back(&ParallelPortfolioSearch::run_engine, this, i);
+    }
+
+    bool timed_out = false;
+    {
+        unique_lock<mutex> lock(engines_mutex);
+        auto done = [&]() {
+                return winner != -1 || num_finished == num_engines;
+            };
+        if (isinf(max_time)) {
+            state_changed.wait(lock, done);
+        } else {
+            timed_out = !state_changed.wait_for(
+                lock, chrono::duration<double>(max_time), done);
+        }
+        stop_engines();
+    }
+    for (thread &worker : threads) {
+        worker.join();
+    }
+
+    for (const shared_ptr<SearchEngine> &engine : engines) {
+        const SearchStatistics &engine_statistics = engine->get_statistics();
+        statistics.inc_expanded(engine_statistics.get_expanded());
+        statistics.inc_evaluated_states(engine_statistics.get_evaluated_states());
+        statistics.inc_evaluations(engine_statistics.get_evaluations());
+        statistics.inc_generated(engine_statistics.get_generated());
+        statistics.inc_generated_ops(engine_statistics.get_generated_ops());
+        statistics.inc_reopened(engine_statistics.get_reopened());
+    }
+
+    if (winner != -1) {
+        utils::g_log << "Portfolio engine " << winner << " found a plan." << endl;
+        set_plan(engines[winner]->get_plan());
+        return SOLVED;
+    }
+    return timed_out ? TIMEOUT : FAILED;
+}
+
+void ParallelPortfolioSearch::print_statistics() const {
+    for (size_t i = 0; i < engines.size(); ++i) {
+        utils::g_log << "Statistics of portfolio engine " << i << " ("
+                     << get_status_name(engine_statuses[i]) << ", search time "
+                     << engine_search_times[i] << "s):" << endl;
+        engines[i]->print_statistics();
+    }
+
+    utils::g_log << "Cumulative statistics:" << endl;
+    statistics.print_detailed_statistics();
+}
+
+static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Parallel portfolio search",
+        "Runs the given search engines in parallel threads (one per engine) "
+        "and stops all of them as soon as one finds a plan within its bound. "
+        "Engines with a larger bound than the portfolio use the "
+        "bound of the portfolio. In contrast to a portfolio run by the driver, "
+        "the task is read and preprocessed only once.");
+    parser.document_note(
+        "Evaluators",
+        "Evaluators are not thread-safe, so the engines cannot share them. "
+        "Therefore, predefined evaluators (--evaluator) cannot be used in the "
+        "engine configurations; each engine must define its evaluators itself, "
+        "for example\n```\n"
+        "--search \"parallel_portfolio([dxes(lmcut(), lmcut(), bound=100), "
+        "xes(ff(), ff(), bound=100)])\"\n```");
+    parser.add_list_option<ParseTree>(
+        "engine_configs", "search engines to run in parallel");
+    SearchEngine::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    opts.verify_list_non_empty<ParseTree>("engine_configs");
+
+    if (parser.help_mode()) {
+        return nullptr;
+    } else if (parser.dry_run()) {
+        // check if the supplied search engines can be parsed
+        for (const ParseTree &config : opts.get_list<ParseTree>("engine_configs")) {
+            OptionParser test_parser(config, parser.get_registry(),
+                                     options::Predefinitions(), true);
+            test_parser.start_parsing<shared_ptr<SearchEngine>>();
+        }
+        return nullptr;
+    } else {
+        return make_shared<ParallelPortfolioSearch>(opts, parser.get_registry());
+    }
+}
+
+static Plugin<SearchEngine> _plugin("parallel_portfolio", _parse);
+}
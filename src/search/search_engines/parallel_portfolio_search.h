@@ -0,0 +1,62 @@
+#ifndef SEARCH_ENGINES_PARALLEL_PORTFOLIO_SEARCH_H
+#define SEARCH_ENGINES_PARALLEL_PORTFOLIO_SEARCH_H
+
+#include "../option_parser_util.h"
+#include "../search_engine.h"
+
+#include "../options/registries.h"
+#include "../options/predefinitions.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace options {
+class Options;
+}
+
+namespace parallel_portfolio_search {
+/*
+  Runs several search engines in parallel threads of this process until the
+  first of them finds a plan. The engines share the task and the task-level
+  tables (successor generator, axiom evaluator, ...), but nothing that
+  changes during the search: each engine has its own state registry, search
+  space and evaluators.
+*/
+class ParallelPortfolioSearch : public SearchEngine {
+    const std::vector<options::ParseTree> engine_configs;
+    // Copied for the same reason as in IteratedSearch.
+    options::Registry registry;
+    /*
+      Predefined evaluators would be shared between the engines, but
+      evaluators must not be used by several threads at the same time.
+      Therefore, the engines are parsed without predefinitions.
+    */
+    const options::Predefinitions no_predefinitions;
+
+    std::vector<std::shared_ptr<SearchEngine>> engines;
+    std::vector<SearchStatus> engine_statuses;
+    std::vector<double> engine_search_times;
+
+    // Protects all of the following members and the entries of engines.
+    std::mutex engines_mutex;
+    std::condition_variable state_changed;
+    int num_constructed;
+    int num_finished;
+    int winner;
+    bool stopping;
+
+    void run_engine(int index);
+    void stop_engines();
+
+    virtual SearchStatus step() override;
+
+public:
+    ParallelPortfolioSearch(const options::Options &opts, options::Registry &registry);
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
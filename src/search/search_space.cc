@@ -57,19 +57,48 @@ void SearchNode::open_initial() {
     info.creating_operator = OperatorID::no_operator;
 }
 
+StateID SearchNode::get_parent_state_id() const {
+    return info.parent_state_id;
+}
+
+OperatorID SearchNode::get_creating_operator() const {
+    return info.creating_operator;
+}
+
 void SearchNode::open(const SearchNode &parent_node,
                       const OperatorProxy &parent_op,
                       int adjusted_cost) {
+    open(parent_node.get_state_id(), parent_node.info.g,
+         parent_node.info.real_g, parent_op, adjusted_cost);
+}
+
+void SearchNode::reopen(const SearchNode &parent_node,
+                        const OperatorProxy &parent_op,
+                        int adjusted_cost) {
+    reopen(parent_node.get_state_id(), parent_node.info.g,
+           parent_node.info.real_g, parent_op, adjusted_cost);
+}
+
+void SearchNode::update_parent(const SearchNode &parent_node,
+                               const OperatorProxy &parent_op,
+                               int adjusted_cost) {
+    update_parent(parent_node.get_state_id(), parent_node.info.g,
+                  parent_node.info.real_g, parent_op, adjusted_cost);
+}
+
+void SearchNode::open(StateID parent_state_id, int parent_g,
+                      int parent_real_g, const OperatorProxy &parent_op,
+                      int adjusted_cost) {
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state_id();
+    info.g = parent_g + adjusted_cost;
+    info.real_g = parent_real_g + parent_op.get_cost();
+    info.parent_state_id = parent_state_id;
     info.creating_operator = OperatorID(parent_op.get_id());
 }
 
-void SearchNode::reopen(const SearchNode &parent_node,
-                        const OperatorProxy &parent_op,
+void SearchNode::reopen(StateID parent_state_id, int parent_g,
+                        int parent_real_g, const OperatorProxy &parent_op,
                         int adjusted_cost) {
     assert(info.status == SearchNodeInfo::OPEN ||
            info.status == SearchNodeInfo::CLOSED);
@@ -77,23 +106,23 @@ void SearchNode::reopen(const SearchNode &parent_node,
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
     info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state_id();
+    info.g = parent_g + adjusted_cost;
+    info.real_g = parent_real_g + parent_op.get_cost();
+    info.parent_state_id = parent_state_id;
     info.creating_operator = OperatorID(parent_op.get_id());
 }
 
 // like reopen, except doesn't change status
-void SearchNode::update_parent(const SearchNode &parent_node,
-                               const OperatorProxy &parent_op,
+void SearchNode::update_parent(StateID parent_state_id, int parent_g,
+                               int parent_real_g, const OperatorProxy &parent_op,
                                int adjusted_cost) {
     assert(info.status == SearchNodeInfo::OPEN ||
            info.status == SearchNodeInfo::CLOSED);
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state_id();
+    info.g = parent_g + adjusted_cost;
+    info.real_g = parent_real_g + parent_op.get_cost();
+    info.parent_state_id = parent_state_id;
     info.creating_operator = OperatorID(parent_op.get_id());
 }
 
@@ -120,7 +149,8 @@ void SearchNode::dump(const TaskProxy &task_proxy) const {
 }
 
 SearchSpace::SearchSpace(StateRegistry &state_registry)
-    : state_registry(state_registry) {
+    : search_node_infos(SearchNodeInfo(), "search node infos", true),
+      state_registry(state_registry) {
 }
 
 SearchNode SearchSpace::get_node(const GlobalState &state) {
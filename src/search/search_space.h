@@ -35,6 +35,9 @@ public:
     int get_g() const;
     int get_real_g() const;
 
+    StateID get_parent_state_id() const;
+    OperatorID get_creating_operator() const;
+
     void open_initial();
     void open(const SearchNode &parent_node,
               const OperatorProxy &parent_op,
@@ -45,6 +48,19 @@ public:
     void update_parent(const SearchNode &parent_node,
                        const OperatorProxy &parent_op,
                        int adjusted_cost);
+
+    /*
+      Variants of the methods above for parents that are not in the search
+      space of this node (e.g. states owned by another thread in a
+      hash-distributed search): parent_state_id refers to the registry of
+      the parent and its g values are given explicitly.
+    */
+    void open(StateID parent_state_id, int parent_g, int parent_real_g,
+              const OperatorProxy &parent_op, int adjusted_cost);
+    void reopen(StateID parent_state_id, int parent_g, int parent_real_g,
+                const OperatorProxy &parent_op, int adjusted_cost);
+    void update_parent(StateID parent_state_id, int parent_g, int parent_real_g,
+                       const OperatorProxy &parent_op, int adjusted_cost);
     void close();
     void mark_as_dead_end();
 
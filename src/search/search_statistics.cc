@@ -18,6 +18,7 @@ SearchStatistics::SearchStatistics(utils::Verbosity verbosity)
     generated_states = 0;
     dead_end_states = 0;
     generated_ops = 0;
+    avoided_reevaluations = 0;
 
     lastjump_expanded_states = 0;
     lastjump_reopened_states = 0;
@@ -70,6 +71,10 @@ void SearchStatistics::print_detailed_statistics() const {
     utils::g_log << "Evaluations: " << evaluations << endl;
     utils::g_log << "Generated " << generated_states << " state(s)." << endl;
     utils::g_log << "Dead ends: " << dead_end_states << " state(s)." << endl;
+    if (avoided_reevaluations > 0) {
+        utils::g_log << "Avoided re-evaluations: " << avoided_reevaluations
+                     << " state(s)." << endl;
+    }
 
     if (lastjump_f_value >= 0) {
         utils::g_log << "Expanded until last jump: "
@@ -25,6 +25,7 @@ class SearchStatistics {
     int dead_end_states;
 
     int generated_ops;    // no of operators that were returned as applicable
+    int avoided_reevaluations; // no of states moved between open lists using cached evaluator values
 
     // Statistics related to f values
     int lastjump_f_value; //f value obtained in the last jump
@@ -46,6 +47,7 @@ public:
     void inc_generated_ops(int inc = 1) {generated_ops += inc;}
     void inc_evaluations(int inc = 1) {evaluations += inc;}
     void inc_dead_ends(int inc = 1) {dead_end_states += inc;}
+    void inc_avoided_reevaluations(int inc = 1) {avoided_reevaluations += inc;}
 
     // Methods that access statistics.
     int get_expanded() const {return expanded_states;}
@@ -54,6 +56,7 @@ public:
     int get_generated() const {return generated_states;}
     int get_reopened() const {return reopened_states;}
     int get_generated_ops() const {return generated_ops;}
+    int get_avoided_reevaluations() const {return avoided_reevaluations;}
 
     /*
       Call the following method with the f value of every expanded
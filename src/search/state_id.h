@@ -1,12 +1,25 @@
 #ifndef STATE_ID_H
 #define STATE_ID_H
 
+#include <cstdint>
 #include <iostream>
 
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
 class StateID {
+public:
+    /*
+      State IDs are 32-bit by default, which limits the number of registered
+      states to 2^31 - 1. The CMake option USE_64BIT_STATE_IDS lifts this
+      limit at the cost of more memory in the registry's hash set.
+    */
+#ifdef USE_64BIT_STATE_IDS
+    using Value = std::int64_t;
+#else
+    using Value = int;
+#endif
+private:
     friend class StateRegistry;
     friend std::ostream &operator<<(std::ostream &os, StateID id);
     template<typename>
@@ -15,8 +28,8 @@ class StateID {
     friend class PerStateArray;
     friend class PerStateBitset;
 
-    int value;
-    explicit StateID(int value_)
+    Value value;
+    explicit StateID(Value value_)
         : value(value_) {
     }
 
@@ -25,9 +38,6 @@ class StateID {
     // No implementation to prevent default construction
     StateID();
 public:
-    ~StateID() {
-    }
-
     static const StateID no_state;
 
     bool operator==(const StateID &other) const {
@@ -42,7 +52,7 @@ public:
 namespace std {
 template <>
 struct hash<StateID> {
-    auto operator()(const StateID &state_id) const { return hash<int>()(state_id.value); }
+    auto operator()(const StateID &state_id) const { return hash<StateID::Value>()(state_id.value); }
 };
 }
 
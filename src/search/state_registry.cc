@@ -3,21 +3,54 @@
 #include "per_state_information.h"
 #include "task_proxy.h"
 
+#include "task_utils/packed_effects.h"
 #include "task_utils/task_properties.h"
 #include "utils/logging.h"
+#include "utils/memory.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
 
 using namespace std;
 
-StateRegistry::StateRegistry(const TaskProxy &task_proxy)
+StateRegistry::StateRegistry(
+    const TaskProxy &task_proxy, StateStorage state_storage,
+    int delta_encoding_interval, int decoded_state_cache_size,
+    PerStateStorage per_state_storage, size_t per_state_reserved_bytes,
+    bool use_per_state_records)
     : task_proxy(task_proxy),
       state_packer(task_properties::g_state_packers[task_proxy]),
+      packed_effects(packed_effects::g_packed_effects[task_proxy]),
       axiom_evaluator(g_axiom_evaluators[task_proxy]),
+      task_has_axioms(task_properties::has_axioms(task_proxy)),
       num_variables(task_proxy.get_variables().size()),
-      state_data_pool(get_bins_per_state()),
+      state_data_arena(
+          state_storage == StateStorage::MAPPED_FILE ?
+          make_shared<mapped_file_arena::MappedFileArena>() : nullptr),
+      state_data_pool(
+          get_bins_per_state(),
+          mapped_file_arena::MappedFileAllocator<PackedStateBin>(state_data_arena)),
       registered_states(
-          StateIDSemanticHash(state_data_pool, get_bins_per_state()),
-          StateIDSemanticEqual(state_data_pool, get_bins_per_state())),
-      cached_initial_state(0) {
+          StateIDSemanticHash(*this, get_bins_per_state()),
+          StateIDSemanticEqual(*this, get_bins_per_state())),
+      per_state_arena(
+          per_state_storage == PerStateStorage::MEMORY ? nullptr :
+          make_shared<segment_arena::SegmentArena>(
+              per_state_storage == PerStateStorage::HUGE_PAGES ?
+              segment_arena::Backing::HUGE_PAGES :
+              segment_arena::Backing::RESERVED_RANGE,
+              per_state_reserved_bytes)),
+      per_state_record_layout(
+          use_per_state_records ? get_per_state_record_layout() : nullptr),
+      cached_initial_state(0),
+      delta_encoding_interval(delta_encoding_interval),
+      decoded_state_cache_size(max(decoded_state_cache_size, 1)),
+      delta_records(mapped_file_arena::MappedFileAllocator<DeltaRecord>(state_data_arena)),
+      delta_entries(mapped_file_arena::MappedFileAllocator<BinDelta>(state_data_arena)),
+      pending_state_id(-1),
+      num_decoded_state_cache_hits(0),
+      num_decoded_state_cache_misses(0) {
 }
 
 
@@ -25,6 +58,74 @@ StateRegistry::~StateRegistry() {
     delete cached_initial_state;
 }
 
+const PackedStateBin *StateRegistry::get_state_data(
+    StateID::Value id, DecodedState &decoded) const {
+    if (!uses_delta_encoding()) {
+        return state_data_pool[id];
+    }
+    if (id == pending_state_id) {
+        decoded = pending_state;
+    } else {
+        decoded = decode_state(id);
+    }
+    return decoded.get();
+}
+
+StateRegistry::DecodedState StateRegistry::decode_state(StateID::Value id) const {
+    auto it = decoded_state_positions.find(id);
+    if (it != decoded_state_positions.end()) {
+        ++num_decoded_state_cache_hits;
+        decoded_states.splice(decoded_states.begin(), decoded_states, it->second);
+        return it->second->second;
+    }
+    ++num_decoded_state_cache_misses;
+
+    /*
+      Collect the states between id and the closest snapshot or cached
+      ancestor, then apply their deltas starting from that ancestor.
+    */
+    int bins_per_state = get_bins_per_state();
+    DecodedState decoded(new PackedStateBin[bins_per_state]);
+    vector<StateID::Value> path;
+    StateID::Value ancestor = id;
+    while (true) {
+        const DeltaRecord &record = delta_records[ancestor];
+        if (record.parent == -1) {
+            const PackedStateBin *data = state_data_pool[record.begin];
+            copy(data, data + bins_per_state, decoded.get());
+            break;
+        }
+        auto cached = decoded_state_positions.find(ancestor);
+        if (cached != decoded_state_positions.end()) {
+            const PackedStateBin *data = cached->second->second.get();
+            copy(data, data + bins_per_state, decoded.get());
+            break;
+        }
+        path.push_back(ancestor);
+        ancestor = record.parent;
+    }
+    for (auto path_it = path.rbegin(); path_it != path.rend(); ++path_it) {
+        const DeltaRecord &record = delta_records[*path_it];
+        for (size_t i = record.begin; i < record.begin + record.size; ++i) {
+            const BinDelta &delta = delta_entries[i];
+            decoded[delta.bin] = delta.value;
+        }
+    }
+    cache_decoded_state(id, decoded);
+    return decoded;
+}
+
+void StateRegistry::cache_decoded_state(
+    StateID::Value id, const DecodedState &decoded) const {
+    assert(!decoded_state_positions.count(id));
+    if (static_cast<int>(decoded_states.size()) == decoded_state_cache_size) {
+        decoded_state_positions.erase(decoded_states.back().first);
+        decoded_states.pop_back();
+    }
+    decoded_states.emplace_front(id, decoded);
+    decoded_state_positions[id] = decoded_states.begin();
+}
+
 StateID StateRegistry::insert_id_or_pop_state() {
     /*
       Attempt to insert a StateID for the last state of state_data_pool
@@ -33,16 +134,78 @@ StateID StateRegistry::insert_id_or_pop_state() {
       state data pool.
     */
     StateID id(state_data_pool.size() - 1);
-    pair<int, bool> result = registered_states.insert(id.value);
+    pair<int_hash_set::KeyType, bool> result = registered_states.insert(id.value);
     bool is_new_entry = result.second;
     if (!is_new_entry) {
         state_data_pool.pop_back();
     }
-    assert(registered_states.size() == static_cast<int>(state_data_pool.size()));
+    assert(registered_states.size() ==
+           static_cast<int_hash_set::IndexType>(state_data_pool.size()));
     return StateID(result.first);
 }
 
+StateID StateRegistry::insert_delta_encoded_state(
+    const GlobalState *parent, DecodedState state) {
+    /*
+      The hash set accesses the data of the new state through
+      get_state_data, so we make it available as the pending state while
+      inserting it.
+    */
+    pending_state_id = registered_states.size();
+    pending_state = state;
+    pair<int_hash_set::KeyType, bool> result = registered_states.insert(pending_state_id);
+    pending_state_id = -1;
+    pending_state = nullptr;
+    StateID id(result.first);
+    if (!result.second) {
+        return id;
+    }
+
+    int bins_per_state = get_bins_per_state();
+    DeltaRecord record;
+    record.parent = -1;
+    record.begin = 0;
+    record.size = 0;
+    record.distance_to_snapshot = 0;
+    if (parent) {
+        const DeltaRecord &parent_record = delta_records[parent->get_id().value];
+        const PackedStateBin *parent_data = parent->get_packed_buffer();
+        int num_changed_bins = 0;
+        for (int bin = 0; bin < bins_per_state; ++bin) {
+            num_changed_bins += (state[bin] != parent_data[bin]);
+        }
+        /*
+          Store a snapshot if the path to the closest snapshot gets too long
+          or if the delta would not need less memory than a full copy.
+        */
+        if (parent_record.distance_to_snapshot + 1 < delta_encoding_interval &&
+            num_changed_bins * sizeof(BinDelta) < bins_per_state * sizeof(PackedStateBin) &&
+            num_changed_bins <= numeric_limits<uint16_t>::max()) {
+            record.parent = parent->get_id().value;
+            record.begin = delta_entries.size();
+            record.size = num_changed_bins;
+            record.distance_to_snapshot = parent_record.distance_to_snapshot + 1;
+            for (int bin = 0; bin < bins_per_state; ++bin) {
+                if (state[bin] != parent_data[bin]) {
+                    delta_entries.push_back(BinDelta {bin, state[bin]});
+                }
+            }
+        }
+    }
+    if (record.parent == -1) {
+        record.begin = state_data_pool.size();
+        state_data_pool.push_back(state.get());
+    }
+    assert(static_cast<int_hash_set::IndexType>(delta_records.size()) == id.value);
+    delta_records.push_back(record);
+    cache_decoded_state(id.value, state);
+    return id;
+}
+
 GlobalState StateRegistry::lookup_state(StateID id) const {
+    if (uses_delta_encoding()) {
+        return GlobalState(decode_state(id.value), *this, id);
+    }
     return GlobalState(state_data_pool[id.value], *this, id);
 }
 
@@ -56,33 +219,90 @@ const GlobalState &StateRegistry::get_initial_state() {
         for (size_t i = 0; i < initial_state.size(); ++i) {
             state_packer.set(buffer, i, initial_state[i].get_value());
         }
-        state_data_pool.push_back(buffer);
-        // buffer is copied by push_back
-        delete[] buffer;
-        StateID id = insert_id_or_pop_state();
+        StateID id = StateID::no_state;
+        if (uses_delta_encoding()) {
+            // The decoded state takes ownership of buffer.
+            id = insert_delta_encoded_state(nullptr, DecodedState(buffer));
+        } else {
+            state_data_pool.push_back(buffer);
+            // buffer is copied by push_back
+            delete[] buffer;
+            id = insert_id_or_pop_state();
+        }
         cached_initial_state = new GlobalState(lookup_state(id));
     }
     return *cached_initial_state;
 }
 
+void StateRegistry::apply_effects(
+    const GlobalState &predecessor, const OperatorProxy &op,
+    PackedStateBin *buffer) {
+#ifndef NDEBUG
+    // Cross-check the packed effects with the effects of the operator.
+    vector<PackedStateBin> expected(buffer, buffer + get_bins_per_state());
+    for (EffectProxy effect : op.get_effects()) {
+        if (does_fire(effect, predecessor)) {
+            FactPair effect_pair = effect.get_fact().get_pair();
+            state_packer.set(expected.data(), effect_pair.var, effect_pair.value);
+        }
+    }
+#endif
+    packed_effects.apply(op.get_id(), predecessor.get_packed_buffer(), buffer);
+    assert(equal(expected.begin(), expected.end(), buffer));
+    if (task_has_axioms)
+        axiom_evaluator.evaluate(buffer, state_packer);
+}
+
 //TODO it would be nice to move the actual state creation (and operator application)
 //     out of the StateRegistry. This could for example be done by global functions
 //     operating on state buffers (PackedStateBin *).
 GlobalState StateRegistry::get_successor_state(const GlobalState &predecessor, const OperatorProxy &op) {
     assert(!op.is_axiom());
+    if (uses_delta_encoding()) {
+        int bins_per_state = get_bins_per_state();
+        DecodedState buffer(new PackedStateBin[bins_per_state]);
+        const PackedStateBin *predecessor_data = predecessor.get_packed_buffer();
+        copy(predecessor_data, predecessor_data + bins_per_state, buffer.get());
+        apply_effects(predecessor, op, buffer.get());
+        StateID id = insert_delta_encoded_state(&predecessor, buffer);
+        // For duplicates, buffer holds the same data as the registered state.
+        return GlobalState(buffer, *this, id);
+    }
     state_data_pool.push_back(predecessor.get_packed_buffer());
     PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
-    for (EffectProxy effect : op.get_effects()) {
-        if (does_fire(effect, predecessor)) {
-            FactPair effect_pair = effect.get_fact().get_pair();
-            state_packer.set(buffer, effect_pair.var, effect_pair.value);
-        }
+    apply_effects(predecessor, op, buffer);
+    StateID id = insert_id_or_pop_state();
+    return lookup_state(id);
+}
+
+void StateRegistry::compute_successor_data(
+    const GlobalState &predecessor, const OperatorProxy &op,
+    PackedStateBin *buffer) {
+    assert(!op.is_axiom());
+    const PackedStateBin *predecessor_data = predecessor.get_packed_buffer();
+    copy(predecessor_data, predecessor_data + get_bins_per_state(), buffer);
+    apply_effects(predecessor, op, buffer);
+}
+
+GlobalState StateRegistry::register_state(
+    const PackedStateBin *data, const GlobalState *predecessor) {
+    if (uses_delta_encoding()) {
+        int bins_per_state = get_bins_per_state();
+        DecodedState buffer(new PackedStateBin[bins_per_state]);
+        copy(data, data + bins_per_state, buffer.get());
+        StateID id = insert_delta_encoded_state(predecessor, buffer);
+        return GlobalState(buffer, *this, id);
     }
-    axiom_evaluator.evaluate(buffer, state_packer);
+    state_data_pool.push_back(data);
     StateID id = insert_id_or_pop_state();
     return lookup_state(id);
 }
 
+void StateRegistry::create_per_state_records() const {
+    per_state_records = utils::make_unique_ptr<PerStateRecords>(
+        per_state_record_layout, get_per_state_allocator<char>("per-state records"));
+}
+
 int StateRegistry::get_bins_per_state() const {
     return state_packer.get_num_bins();
 }
@@ -94,4 +314,36 @@ int StateRegistry::get_state_size_in_bytes() const {
 void StateRegistry::print_statistics() const {
     utils::g_log << "Number of registered states: " << size() << endl;
     registered_states.print_statistics();
+    if (uses_delta_encoding()) {
+        utils::g_log << "Delta-encoded state snapshots: " << state_data_pool.size()
+                     << endl;
+        utils::g_log << "Delta-encoded state bins: " << delta_entries.size() << endl;
+        utils::g_log << "Delta encoding data: "
+                     << delta_records.size() * sizeof(DeltaRecord) +
+            delta_entries.size() * sizeof(BinDelta) << " bytes" << endl;
+        utils::g_log << "Decoded state cache hits: "
+                     << num_decoded_state_cache_hits << endl;
+        utils::g_log << "Decoded state cache misses: "
+                     << num_decoded_state_cache_misses << endl;
+    }
+    if (state_data_arena) {
+        utils::g_log << "State data allocated: "
+                     << state_data_arena->get_allocated_bytes() << " bytes" << endl;
+        utils::g_log << "State data mapped: "
+                     << state_data_arena->get_mapped_bytes() << " bytes" << endl;
+        utils::g_log << "State data resident: "
+                     << state_data_arena->get_resident_bytes() << " bytes" << endl;
+    } else {
+        size_t allocated_bytes = state_data_pool.get_allocated_bytes();
+        utils::g_log << "State data allocated: " << allocated_bytes << " bytes" << endl;
+        utils::g_log << "State data mapped: 0 bytes" << endl;
+        utils::g_log << "State data resident: " << allocated_bytes << " bytes" << endl;
+    }
+    if (per_state_records) {
+        utils::g_log << "Per-state record size: "
+                     << per_state_records->get_record_size() << " bytes" << endl;
+    }
+    if (per_state_arena) {
+        per_state_arena->print_statistics();
+    }
 }
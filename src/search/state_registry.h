@@ -4,15 +4,23 @@
 #include "abstract_task.h"
 #include "axioms.h"
 #include "global_state.h"
+#include "per_state_record.h"
 #include "state_id.h"
 
 #include "algorithms/int_hash_set.h"
 #include "algorithms/int_packer.h"
+#include "algorithms/mapped_file_arena.h"
+#include "algorithms/segment_arena.h"
 #include "algorithms/segmented_vector.h"
 #include "algorithms/subscriber.h"
 #include "utils/hash.h"
 
+#include <cstdint>
+#include <list>
+#include <memory>
 #include <set>
+#include <string>
+#include <unordered_map>
 
 /*
   Overview of classes relevant to storing and working with registered states.
@@ -24,8 +32,10 @@
     State first.
     A GlobalState is always registered in a StateRegistry and has a valid ID.
     It can (only) be constructed from a StateRegistry by factory methods for
-    the initial state and successor states. It never owns the actual state data
-    which is borrowed from the StateRegistry that created it.
+    the initial state and successor states. It does not own the actual state
+    data which is borrowed from the StateRegistry that created it (except for
+    delta-encoded registries, see below, where it shares ownership of a
+    decoded copy).
 
   State
     This class is used for fast access to state data. It contains and owns all
@@ -40,7 +50,7 @@
     is why IDs are intended for long term storage (e.g. in open lists).
     Internally, a StateID is just an integer, so it is cheap to store and copy.
 
-  PackedStateBin (currently the same as unsigned int)
+  PackedStateBin (unsigned int, or a 64-bit integer with USE_64BIT_STATE_BINS)
     The actual state data is internally represented as a PackedStateBin array.
     Each PackedStateBin can contain the values of multiple variables.
     To minimize allocation overhead, the implementation stores the data of many
@@ -61,6 +71,18 @@
     while avoiding dynamically allocating each state individually.
     The index within this vector corresponds to the ID of the state.
 
+    Optionally (delta_encoding_interval > 0), the registry stores most states
+    only as the bins that differ from their parent state. Every state whose
+    parent chain reaches delta_encoding_interval states without a full copy
+    (a "snapshot") is stored in full in the SegmentedArrayVector, so decoding
+    a state applies at most that many deltas. Recently decoded states are kept
+    in an LRU cache. Hashing and comparing states always uses the full decoded
+    state data, so duplicate detection is exact. Since every lookup updates
+    the cache, a delta-encoded registry must only be used by a single thread,
+    even if all threads only read (in contrast to the concurrent reads of
+    SegmentedArrayVector). Therefore, the multi-threaded search engines do
+    not support delta encoding.
+
   PerStateInformation<T>
     Associates a value of type T with every state in a given StateRegistry.
     Can be thought of as a very compactly implemented map from GlobalState to T.
@@ -108,40 +130,69 @@
     state and each landmark whether it was reached in this state.
 */
 
+namespace packed_effects {
+class PackedEffects;
+}
+
+/*
+  Where the packed state data is stored: MEMORY uses the heap, MAPPED_FILE
+  uses a memory-mapped temporary file (see algorithms/mapped_file_arena.h).
+*/
+enum class StateStorage {
+    MEMORY,
+    MAPPED_FILE
+};
+
+/*
+  Where the segments of PerStateInformation and PerStateArray objects for
+  the states of a registry are allocated: MEMORY uses the heap, HUGE_PAGES
+  and RESERVED_RANGE use a segment arena with the respective backing (see
+  algorithms/segment_arena.h).
+*/
+enum class PerStateStorage {
+    MEMORY,
+    HUGE_PAGES,
+    RESERVED_RANGE
+};
+
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
+    using StateDataPool = segmented_vector::SegmentedArrayVector<
+        PackedStateBin, mapped_file_arena::MappedFileAllocator<PackedStateBin>>;
+
+    /*
+      Packed data of a decoded (delta-encoded) state. Shared with the
+      GlobalStates referring to it, so evicting it from the cache is safe.
+    */
+    using DecodedState = std::shared_ptr<PackedStateBin[]>;
+
     struct StateIDSemanticHash {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        const StateRegistry &registry;
         int state_size;
-        StateIDSemanticHash(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
-            int state_size)
-            : state_data_pool(state_data_pool),
+        StateIDSemanticHash(const StateRegistry &registry, int state_size)
+            : registry(registry),
               state_size(state_size) {
         }
 
-        int_hash_set::HashType operator()(int id) const {
-            const PackedStateBin *data = state_data_pool[id];
-            utils::HashState hash_state;
-            for (int i = 0; i < state_size; ++i) {
-                hash_state.feed(data[i]);
-            }
-            return hash_state.get_hash32();
+        int_hash_set::HashType operator()(int_hash_set::KeyType id) const {
+            DecodedState decoded;
+            const PackedStateBin *data = registry.get_state_data(id, decoded);
+            return int_hash_set::get_hash(utils::get_array_hash64(data, state_size));
         }
     };
 
     struct StateIDSemanticEqual {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        const StateRegistry &registry;
         int state_size;
-        StateIDSemanticEqual(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
-            int state_size)
-            : state_data_pool(state_data_pool),
+        StateIDSemanticEqual(const StateRegistry &registry, int state_size)
+            : registry(registry),
               state_size(state_size) {
         }
 
-        bool operator()(int lhs, int rhs) const {
-            const PackedStateBin *lhs_data = state_data_pool[lhs];
-            const PackedStateBin *rhs_data = state_data_pool[rhs];
+        bool operator()(int_hash_set::KeyType lhs, int_hash_set::KeyType rhs) const {
+            DecodedState lhs_decoded;
+            DecodedState rhs_decoded;
+            const PackedStateBin *lhs_data = registry.get_state_data(lhs, lhs_decoded);
+            const PackedStateBin *rhs_data = registry.get_state_data(rhs, rhs_decoded);
             return std::equal(lhs_data, lhs_data + state_size, rhs_data);
         }
     };
@@ -155,20 +206,104 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
 
     TaskProxy task_proxy;
     const int_packer::IntPacker &state_packer;
+    const packed_effects::PackedEffects &packed_effects;
     AxiomEvaluator &axiom_evaluator;
+    const bool task_has_axioms;
     const int num_variables;
 
-    segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+    // Arena for the state data if it is stored in a mapped file, else null.
+    std::shared_ptr<mapped_file_arena::MappedFileArena> state_data_arena;
+    StateDataPool state_data_pool;
     StateIDSet registered_states;
 
+    // Arena for per-state information unless it is stored on the heap, else null.
+    std::shared_ptr<segment_arena::SegmentArena> per_state_arena;
+
+    // Per-state records (see per_state_record.h), laid out on first access.
+    const std::shared_ptr<PerStateRecordLayout> per_state_record_layout;
+    mutable std::unique_ptr<PerStateRecords> per_state_records;
+
     GlobalState *cached_initial_state;
 
+    /*
+      Delta encoding (only used if delta_encoding_interval > 0). A state is
+      either a snapshot (parent == -1, its data is state_data_pool[begin]) or
+      consists of the bins delta_entries[begin, begin + size) that differ
+      from its parent.
+    */
+    struct DeltaRecord {
+        std::size_t begin;
+        StateID::Value parent;
+        std::uint16_t size;
+        // Number of deltas to apply to the closest snapshot to decode the state.
+        std::uint16_t distance_to_snapshot;
+    };
+
+    struct BinDelta {
+        int bin;
+        PackedStateBin value;
+    };
+
+    template<typename T>
+    using DeltaVector = segmented_vector::SegmentedVector<
+        T, mapped_file_arena::MappedFileAllocator<T>>;
+
+    const int delta_encoding_interval;
+    const int decoded_state_cache_size;
+    DeltaVector<DeltaRecord> delta_records;
+    DeltaVector<BinDelta> delta_entries;
+
+    // The successor state that is currently inserted into registered_states.
+    StateID::Value pending_state_id;
+    DecodedState pending_state;
+
+    // LRU cache of decoded states, the most recently used state comes first.
+    using DecodedStateCache = std::list<std::pair<StateID::Value, DecodedState>>;
+    mutable DecodedStateCache decoded_states;
+    mutable std::unordered_map<StateID::Value, DecodedStateCache::iterator> decoded_state_positions;
+    mutable int num_decoded_state_cache_hits;
+    mutable int num_decoded_state_cache_misses;
+
+    /*
+      Return the packed data of the state with the given ID. For delta-encoded
+      states, decoded is set to the decoded copy that the result points to.
+    */
+    const PackedStateBin *get_state_data(StateID::Value id, DecodedState &decoded) const;
+    DecodedState decode_state(StateID::Value id) const;
+    void cache_decoded_state(StateID::Value id, const DecodedState &decoded) const;
+
+    void apply_effects(
+        const GlobalState &predecessor, const OperatorProxy &op,
+        PackedStateBin *buffer);
     StateID insert_id_or_pop_state();
-    int get_bins_per_state() const;
+    StateID insert_delta_encoded_state(const GlobalState *parent, DecodedState state);
+    void create_per_state_records() const;
 public:
-    explicit StateRegistry(const TaskProxy &task_proxy);
+    /*
+      If delta_encoding_interval is positive, states are delta-encoded with
+      a snapshot at least every delta_encoding_interval states along each
+      path, and the decoded_state_cache_size most recently used states are
+      cached in decoded form. per_state_reserved_bytes is the size of the
+      address range reserved for per-state information with RESERVED_RANGE.
+      If use_per_state_records is true, per-state information that is
+      declared as part of the per-state records is stored in one record per
+      state.
+    */
+    explicit StateRegistry(
+        const TaskProxy &task_proxy,
+        StateStorage state_storage = StateStorage::MEMORY,
+        int delta_encoding_interval = 0,
+        int decoded_state_cache_size = 0,
+        PerStateStorage per_state_storage = PerStateStorage::MEMORY,
+        std::size_t per_state_reserved_bytes = 0,
+        bool use_per_state_records = true);
     ~StateRegistry();
 
+    // If true, lookups are not thread-safe (see above).
+    bool uses_delta_encoding() const {
+        return delta_encoding_interval > 0;
+    }
+
     const TaskProxy &get_task_proxy() const {
         return task_proxy;
     }
@@ -200,6 +335,41 @@ public:
     */
     GlobalState get_successor_state(const GlobalState &predecessor, const OperatorProxy &op);
 
+    /*
+      Writes the packed data of the state that results from applying op to
+      predecessor to buffer (get_bins_per_state() bins) without registering
+      it. Together with register_state, this allows to decide where a
+      successor is registered after computing it, e.g. in a registry of
+      another thread.
+    */
+    void compute_successor_data(
+        const GlobalState &predecessor, const OperatorProxy &op,
+        PackedStateBin *buffer);
+
+    /*
+      Returns the state with the given packed data and registers it if this
+      was not done before. With delta encoding, the state is stored relative
+      to predecessor if it is given, which must be registered in this
+      registry, and as a snapshot otherwise.
+    */
+    GlobalState register_state(
+        const PackedStateBin *data, const GlobalState *predecessor = nullptr);
+
+    /*
+      Returns the hash of the given packed state data, which only depends on
+      the data (in contrast to the hashes used inside the registry, it is the
+      same in every registry of the task).
+    */
+    std::uint64_t get_state_hash(const PackedStateBin *data) const {
+        return utils::get_array_hash64(data, get_bins_per_state());
+    }
+
+    std::uint64_t get_state_hash(const GlobalState &state) const {
+        return get_state_hash(state.get_packed_buffer());
+    }
+
+    int get_bins_per_state() const;
+
     /*
       Returns the number of states registered so far.
     */
@@ -209,6 +379,30 @@ public:
 
     int get_state_size_in_bytes() const;
 
+    /*
+      Returns the allocator for the segments of per-state information about
+      the states of this registry. Allocations are accounted to the given
+      consumer name in the statistics.
+    */
+    template<typename T>
+    segment_arena::SegmentArenaAllocator<T> get_per_state_allocator(
+        const std::string &consumer) const {
+        if (!per_state_arena)
+            return segment_arena::SegmentArenaAllocator<T>();
+        return segment_arena::SegmentArenaAllocator<T>(
+            per_state_arena, per_state_arena->register_consumer(consumer));
+    }
+
+    /*
+      Returns the per-state records of this registry, or nullptr if it does
+      not use them. The records are laid out on the first call.
+    */
+    PerStateRecords *get_per_state_records() const {
+        if (!per_state_records && per_state_record_layout)
+            create_per_state_records();
+        return per_state_records.get();
+    }
+
     void print_statistics() const;
 
     class const_iterator : public std::iterator<
@@ -1,16 +1,25 @@
 #include "eager_suboptimal_search.h"
 
+#include <algorithm>
 #include <cassert>
+#include <iostream>
 #include <memory>
+#include <set>
+#include <thread>
 
 #include "../algorithms/ordered_set.h"
 #include "../evaluation_context.h"
+#include "../evaluator.h"
 #include "../floating_point_evaluator/floating_point_evaluator.h"
+#include "../heuristic.h"
 #include "../heuristic_error/heuristic_error.h"
+#include "../heuristic_error/one_step_error.h"
 #include "../option_parser.h"
 #include "../pruning_method.h"
 #include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
+#include "../utils/system.h"
 
 using namespace floating_point_evaluator;
 
@@ -32,7 +41,33 @@ EagerSuboptimalSearch<N>::EagerSuboptimalSearch(const Options &opts)
 	  preferred_operator_evaluators(opts.get_list<std::shared_ptr<Evaluator>>("preferred")),
 	  pruning_method(opts.get<std::shared_ptr<PruningMethod>>("pruning")),
 	  max_g_value(0),
+	  num_opened_nodes(0),
+	  max_cached_preferred_operators(opts.get<int>("max_cached_preferred_operators")),
+	  preferred_operators_cache(PreferredOperatorsRecord(), "preferred operators cache", cache_preferred_operators()),
+	  num_preferred_operator_cache_hits(0),
+	  batch_evaluators(opts.get_list<std::shared_ptr<Evaluator>>("batch")),
+	  evaluation_threads(opts.get<int>("evaluation_threads")),
+	  exchange(nullptr),
+	  shard(-1),
+	  idle(false),
+	  goal_state_id(StateID::no_state),
+	  num_sent_states(0),
+	  num_received_states(0),
 	  heuristic_error(opts.get_list<std::shared_ptr<heuristic_error::HeuristicError>>("error")) {
+	if (!batch_evaluators.empty() && !preferred_operator_evaluators.empty()) {
+		// the batches do not compute preferred operators, and the FF heuristic may break ties differently in batches than for the expanded state
+		std::cerr << "Batch evaluation currently does not support preferred operators, exiting." << std::endl;
+		utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+	}
+	if (evaluation_threads > 1 && !batch_evaluators.empty()) {
+		std::cerr << "Parallel evaluation cannot be combined with batch evaluation, exiting." << std::endl;
+		utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+	}
+	if (evaluation_threads > 1 && uses_delta_encoding()) {
+		// the evaluation threads read the data of the states from the registry
+		std::cerr << "Parallel evaluation does not support delta-encoded state registries, exiting." << std::endl;
+		utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+	}
 	for (const auto &h_error : heuristic_error)
 		h_error->initialize(state_registry);
 }
@@ -59,18 +94,24 @@ void EagerSuboptimalSearch<N>::initialize() {
 	initialize_extra(eval_context);
 	const auto initial_values = compute_results(eval_context);
 	statistics.inc_evaluated_states();
+	if (evaluation_threads > 1)
+		start_parallel_evaluation(eval_context);
+	// in a hash-distributed search, every shard initializes its evaluators and heuristic error models with the initial state, but only its owner opens it
+	const auto owns_initial_state = !exchange || exchange->get_owner(state_registry.get_state_hash(initial_state)) == shard;
 	if (is_dead_end(initial_values)) {
 		utils::g_log << "Initial state is a dead end." << std::endl;
-	} else {
+	} else if (owns_initial_state) {
 		if (check_progress(eval_context.get_g_value()))
 			statistics.print_checkpoint_line(0);
 		auto node = search_space.get_node(initial_state);
 		node.open_initial();
+		++num_opened_nodes;
 
 		insert(eval_context, initial_values, initial_state.get_id(), eval_context.is_preferred());
 	}
 
-	print_initial_evaluator_values(eval_context);
+	if (owns_initial_state)
+		print_initial_evaluator_values(eval_context);
 
 	pruning_method->initialize(task);
 }
@@ -80,20 +121,48 @@ void EagerSuboptimalSearch<N>::print_statistics() const {
 	statistics.print_detailed_statistics();
 	search_space.print_statistics();
 	pruning_method->print_statistics();
+	if (cache_preferred_operators())
+		utils::g_log << "Reused preferred operators: " << num_preferred_operator_cache_hits << " state(s), " << preferred_operators_pool.size()
+					 << " cached operator(s)." << std::endl;
+	if (exchange)
+		utils::g_log << "Sent " << num_sent_states << " state(s) to other shards, received " << num_received_states << " state(s)." << std::endl;
 }
 
 template <std::size_t N>
-auto EagerSuboptimalSearch<N>::step() -> SearchStatus {
-	auto node = fetch_next_node();
-	if (!node) {
-		utils::g_log << "Completely explored state space -- no solution!" << std::endl;
-		return FAILED;
-	}
+auto EagerSuboptimalSearch<N>::cache_preferred_operators() const -> bool {
+	return max_cached_preferred_operators > 0 && !preferred_operator_evaluators.empty();
+}
 
-	auto s = node->get_state();
-	if (check_goal_and_set_plan(s))
-		return SOLVED;
+template <std::size_t N>
+auto EagerSuboptimalSearch<N>::create_successor_eval_context(const GlobalState &state, int g, bool is_preferred) -> EvaluationContext {
+	// compute the preferred operators along with the evaluator values if they can still be cached
+	const auto calculate_preferred = cache_preferred_operators() && static_cast<int>(preferred_operators_pool.size()) < max_cached_preferred_operators;
+	return EvaluationContext(state, g, is_preferred, &statistics, calculate_preferred);
+}
 
+template <std::size_t N>
+void EagerSuboptimalSearch<N>::store_preferred_operators(EvaluationContext &eval_context) {
+	if (!eval_context.get_calculate_preferred())
+		return;
+	auto record = PreferredOperatorsRecord();
+	record.begin = static_cast<int>(preferred_operators_pool.size());
+	for (const auto &preferred_operator_evaluator : preferred_operator_evaluators) {
+		if (eval_context.is_evaluator_value_infinite(preferred_operator_evaluator.get()))
+			continue;
+		for (const auto &op_id : eval_context.get_preferred_operators(preferred_operator_evaluator.get())) {
+			// skip duplicates within this record (the records are small, so a linear search is fine)
+			if (std::find(std::begin(preferred_operators_pool) + record.begin, std::end(preferred_operators_pool), op_id) == std::end(preferred_operators_pool))
+				preferred_operators_pool.push_back(op_id);
+		}
+	}
+	record.size = static_cast<int>(preferred_operators_pool.size()) - record.begin;
+	preferred_operators_cache[eval_context.get_state()] = record;
+}
+
+template <std::size_t N>
+auto EagerSuboptimalSearch<N>::get_successor_operators(const SearchNode &node, ordered_set::OrderedSet<OperatorID> &preferred_operators)
+		-> std::vector<OperatorID> {
+	const auto s = node.get_state();
 	auto applicable_ops = std::vector<OperatorID>();
 	successor_generator.generate_applicable_ops(s, applicable_ops);
 
@@ -103,111 +172,421 @@ auto EagerSuboptimalSearch<N>::step() -> SearchStatus {
 	*/
 	pruning_method->prune_operators(s, applicable_ops);
 
-	// This evaluates the expanded state (again) to get preferred ops
-	auto eval_context = EvaluationContext(s, node->get_g(), false, &statistics, true);
+	const auto cached_preferred_operators = cache_preferred_operators() ? preferred_operators_cache[s] : PreferredOperatorsRecord();
+	if (cached_preferred_operators.begin != -1) {
+		// reuse the preferred operators computed when the state was inserted into the open list
+		const auto cached_begin = std::begin(preferred_operators_pool) + cached_preferred_operators.begin;
+		for (auto it = cached_begin; it != cached_begin + cached_preferred_operators.size; ++it)
+			preferred_operators.insert(*it);
+		++num_preferred_operator_cache_hits;
+	} else if (!preferred_operator_evaluators.empty()) {
+		// This evaluates the expanded state (again) to get preferred ops
+		auto eval_context = EvaluationContext(s, node.get_g(), false, &statistics, true);
+		for (const auto &preferred_operator_evaluator : preferred_operator_evaluators)
+			if (!eval_context.is_evaluator_value_infinite(preferred_operator_evaluator.get()))
+				for (const auto &op_id : eval_context.get_preferred_operators(preferred_operator_evaluator.get()))
+					preferred_operators.insert(op_id);
+	}
+
+	// We need to use > instead of >= here!
+	applicable_ops.erase(std::remove_if(std::begin(applicable_ops), std::end(applicable_ops),
+	                                    [this, &node](const auto op_id) { return node.get_real_g() + task_proxy.get_operators()[op_id].get_cost() > bound; }),
+	                     std::end(applicable_ops));
+	return applicable_ops;
+}
+
+template <std::size_t N>
+void EagerSuboptimalSearch<N>::start_parallel_evaluation(const EvaluationContext &initial_eval_context) {
+	// the heuristics used by the evaluators are the ones evaluated for the initial state, except for path-dependent heuristics (their estimates depend on the search)
+	auto heuristics = std::vector<Heuristic *>();
+	initial_eval_context.get_cache().for_each_evaluator_result([&heuristics](const Evaluator *evaluator, const EvaluationResult &) {
+		auto heuristic = dynamic_cast<Heuristic *>(const_cast<Evaluator *>(evaluator));
+		if (!heuristic)
+			return;
+		auto path_dependent_evaluators = std::set<Evaluator *>();
+		heuristic->get_path_dependent_evaluators(path_dependent_evaluators);
+		if (path_dependent_evaluators.empty())
+			heuristics.push_back(heuristic);
+	});
+	// sort them to log them in a deterministic order
+	std::sort(std::begin(heuristics), std::end(heuristics),
+	          [](const auto lhs, const auto rhs) { return lhs->get_description() < rhs->get_description(); });
+	parallel_evaluation = std::make_unique<ParallelEvaluation>(task_proxy, heuristics, evaluation_threads);
+	utils::g_log << "Evaluating " << parallel_evaluation->get_num_heuristics() << " heuristic(s) in " << evaluation_threads << " threads." << std::endl;
+}
+
+template <std::size_t N>
+void EagerSuboptimalSearch<N>::compute_batch(const std::vector<GlobalState> &succ_states) {
+	auto new_succ_states = std::vector<GlobalState>();
+	for (const auto &succ_state : succ_states) {
+		const auto is_new_succ_state = [&succ_state](const auto &other) { return other.get_id() == succ_state.get_id(); };
+		if (search_space.get_node(succ_state).is_new() && std::none_of(std::begin(new_succ_states), std::end(new_succ_states), is_new_succ_state))
+			new_succ_states.push_back(succ_state);
+	}
+	if (new_succ_states.empty())
+		return;
+	for (const auto &batch_evaluator : batch_evaluators)
+		batch_evaluator->compute_batch(new_succ_states);
+	if (parallel_evaluation)
+		parallel_evaluation->evaluate(new_succ_states);
+}
+
+template <std::size_t N>
+auto EagerSuboptimalSearch<N>::process_successor(StateID parent_id, int parent_shard, int parent_g, int parent_real_g, const GlobalState &succ_state,
+                                                 const OperatorProxy &op, bool is_preferred) -> std::optional<SearchNode> {
+	auto succ_node = search_space.get_node(succ_state);
+
+	// Previously encountered dead end. Don't re-evaluate.
+	if (succ_node.is_dead_end())
+		return std::nullopt;
+
+	if (succ_node.is_new()) {
+		// We have not seen this state before.
+		// Evaluate and create a new node.
+
+		// Careful: succ_node.get_g() is not available here yet,
+		// hence the stupid computation of succ_g.
+		// TODO: Make this less fragile.
+		const auto succ_g = parent_g + get_adjusted_cost(op);
+
+		auto succ_eval_context = create_successor_eval_context(succ_state, succ_g, is_preferred);
+		const auto evaluator_values = compute_results(succ_eval_context);
+		statistics.inc_evaluated_states();
+
+		if (is_dead_end(evaluator_values)) {
+			succ_node.mark_as_dead_end();
+			statistics.inc_dead_ends();
+			return std::nullopt;
+		}
+		succ_node.open(parent_id, parent_g, parent_real_g, op, get_adjusted_cost(op));
+		if (parent_shards)
+			(*parent_shards)[succ_state] = parent_shard;
+		++num_opened_nodes;
+
+		// NOTE: we put nodes into the open list even if their main evaluator evaluates to infinity because we can't rule our rounding errors
+		insert(succ_eval_context, evaluator_values, succ_state.get_id(), is_preferred);
+		store_preferred_operators(succ_eval_context);
+		if (check_progress(parent_g)) {
+			statistics.print_checkpoint_line(succ_node.get_g());
+			reward_progress();
+		}
+	} else if (succ_node.get_g() > parent_g + get_adjusted_cost(op)) {
+		// We found a new cheapest path to an open or closed state.
+		if (parent_shards)
+			(*parent_shards)[succ_state] = parent_shard;
+		if (reopen_closed_nodes) {
+			if (succ_node.is_closed()) {
+				/*
+				  TODO: It would be nice if we had a way to test
+				  that reopening is expected behaviour, i.e., exit
+				  with an error when this is something where
+				  reopening should not occur (e.g. A* with a
+				  consistent heuristic).
+				*/
+				statistics.inc_reopened();
+				++num_opened_nodes;
+			}
+			succ_node.reopen(parent_id, parent_g, parent_real_g, op, get_adjusted_cost(op));
+
+			auto succ_eval_context = create_successor_eval_context(succ_state, succ_node.get_g(), is_preferred);
+			const auto evaluator_values = compute_results(succ_eval_context);
+
+			/*
+			  Note: our old code used to retrieve the h value from
+			  the search node here. Our new code recomputes it as
+			  necessary, thus avoiding the incredible ugliness of
+			  the old "set_evaluator_value" approach, which also
+			  did not generalize properly to settings with more
+			  than one evaluator.
+
+			  Reopening should not happen all that frequently, so
+			  the performance impact of this is hopefully not that
+			  large. In the medium term, we want the evaluators to
+			  remember evaluator values for states themselves if
+			  desired by the user, so that such recomputations
+			  will just involve a look-up by the Evaluator object
+			  rather than a recomputation of the evaluator value
+			  from scratch.
+			*/
+			insert(succ_eval_context, evaluator_values, succ_state.get_id(), is_preferred);
+			store_preferred_operators(succ_eval_context);
+		} else {
+			// If we do not reopen closed nodes, we just update the parent pointers.
+			// Note that this could cause an incompatibility between
+			// the g-value and the actual path that is traced back.
+			succ_node.update_parent(parent_id, parent_g, parent_real_g, op, get_adjusted_cost(op));
+		}
+	}
+	return succ_node;
+}
+
+template <std::size_t N>
+auto EagerSuboptimalSearch<N>::step() -> SearchStatus {
+	if (exchange)
+		return distributed_step();
+
+	auto node = fetch_next_node();
+	if (!node) {
+		utils::g_log << "Completely explored state space -- no solution!" << std::endl;
+		return FAILED;
+	}
+
+	auto s = node->get_state();
+	if (check_goal_and_set_plan(s))
+		return SOLVED;
+
 	auto preferred_operators = ordered_set::OrderedSet<OperatorID>();
-	for (const auto &preferred_operator_evaluator : preferred_operator_evaluators)
-		if (!eval_context.is_evaluator_value_infinite(preferred_operator_evaluator.get()))
-			for (const auto &op_id : eval_context.get_preferred_operators(preferred_operator_evaluator.get()))
-				preferred_operators.insert(op_id);
+	const auto applicable_ops = get_successor_operators(*node, preferred_operators);
 	for (const auto &h_error : heuristic_error)
 		h_error->set_expanding_state(s);
 
-	for (const auto op_id : applicable_ops) {
+	auto succ_states = std::vector<GlobalState>();
+	succ_states.reserve(applicable_ops.size());
+	for (const auto op_id : applicable_ops)
+		succ_states.push_back(state_registry.get_successor_state(s, task_proxy.get_operators()[op_id]));
+
+	if (!batch_evaluators.empty() || parallel_evaluation)
+		compute_batch(succ_states);
+
+	for (std::size_t i = 0; i < applicable_ops.size(); ++i) {
+		const auto op_id = applicable_ops[i];
 		const auto op = task_proxy.get_operators()[op_id];
-		// We need to use > instead of >= here!
-		if ((node->get_real_g() + op.get_cost()) > bound)
+		statistics.inc_generated();
+		const auto succ_node = process_successor(node->get_state_id(), shard, node->get_g(), node->get_real_g(), succ_states[i], op,
+		                                         preferred_operators.contains(op_id));
+		if (!succ_node)
 			continue;
+		for (const auto &h_error : heuristic_error)
+			h_error->add_successor(*succ_node, get_adjusted_cost(op));
+	}
 
-		const auto succ_state = state_registry.get_successor_state(s, op);
-		statistics.inc_generated();
-		const auto is_preferred = preferred_operators.contains(op_id);
+	for (const auto &h_error : heuristic_error)
+		h_error->update_error();
+	return IN_PROGRESS;
+}
 
-		auto succ_node = search_space.get_node(succ_state);
+template <std::size_t N>
+void EagerSuboptimalSearch<N>::connect(StateExchange &exchange, int shard) {
+	assert(supports_distribution());
+	this->exchange = &exchange;
+	this->shard = shard;
+	parent_shards = std::make_unique<PerStateInformation<int>>(-1, "parent shards", true);
+	outboxes.resize(exchange.get_num_shards());
+	successor_data.resize(state_registry.get_bins_per_state());
+	for (std::size_t i = 0; i < heuristic_error.size(); ++i) {
+		auto one_step_error = dynamic_cast<heuristic_error::OneStepError *>(heuristic_error[i].get());
+		if (!one_step_error) {
+			std::cerr << "Hash-distributed search only supports one-step heuristic error models, exiting." << std::endl;
+			utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+		}
+		one_step_error->share_statistics(exchange.get_error_statistics(i), shard);
+		one_step_error->set_snapshot_interval(exchange.get_error_snapshot_interval());
+		distributed_heuristic_error.push_back(one_step_error);
+	}
+}
 
-		// Previously encountered dead end. Don't re-evaluate.
-		if (succ_node.is_dead_end())
-			continue;
+template <std::size_t N>
+void EagerSuboptimalSearch<N>::trace_step(StateID state_id, OperatorID &creating_operator, int &parent_shard, StateID &parent_id) {
+	assert(exchange);
+	const auto state = state_registry.lookup_state(state_id);
+	const auto node = search_space.get_node(state);
+	creating_operator = node.get_creating_operator();
+	parent_shard = (*parent_shards)[state];
+	parent_id = node.get_parent_state_id();
+}
 
-		if (succ_node.is_new()) {
-			// We have not seen this state before.
-			// Evaluate and create a new node.
+static void update_best_successor_key(int &best_successor_key, int key) {
+	if (key != heuristic_error::OneStepError::NO_VALUE && (best_successor_key == heuristic_error::OneStepError::NO_VALUE || key < best_successor_key))
+		best_successor_key = key;
+}
 
-			// Careful: succ_node.get_g() is not available here yet,
-			// hence the stupid computation of succ_g.
-			// TODO: Make this less fragile.
-			const auto succ_g = node->get_g() + get_adjusted_cost(op);
+template <std::size_t N>
+auto EagerSuboptimalSearch<N>::distributed_step() -> SearchStatus {
+	receive_batches();
 
-			auto succ_eval_context = EvaluationContext(succ_state, succ_g, is_preferred, &statistics);
-			const auto evaluator_values = compute_results(succ_eval_context);
-			statistics.inc_evaluated_states();
+	auto node = fetch_next_node();
+	if (!node) {
+		send_batches(true);
+		if (!idle) {
+			idle = true;
+			exchange->notify_idle();
+		}
+		if (exchange->is_finished()) {
+			utils::g_log << "Completely explored state space -- no solution!" << std::endl;
+			return FAILED;
+		}
+		std::this_thread::yield();
+		return IN_PROGRESS;
+	}
 
-			if (is_dead_end(evaluator_values)) {
-				succ_node.mark_as_dead_end();
-				statistics.inc_dead_ends();
-				continue;
-			}
-			succ_node.open(*node, op, get_adjusted_cost(op));
+	auto s = node->get_state();
+	if (task_properties::is_goal_state(task_proxy, s)) {
+		// the plan is traced through the search spaces of all shards by the caller
+		utils::g_log << "Solution found!" << std::endl;
+		goal_state_id = s.get_id();
+		return SOLVED;
+	}
 
-			// NOTE: we put nodes into the open list even if their main evaluator evaluates to infinity because we can't rule our rounding errors
-			insert(succ_eval_context, evaluator_values, succ_state.get_id(), is_preferred);
-			if (check_progress(eval_context.get_g_value())) {
-				statistics.print_checkpoint_line(succ_node.get_g());
-				reward_progress();
-			}
-		} else if (succ_node.get_g() > node->get_g() + get_adjusted_cost(op)) {
-			// We found a new cheapest path to an open or closed state.
-			if (reopen_closed_nodes) {
-				if (succ_node.is_closed()) {
-					/*
-					  TODO: It would be nice if we had a way to test
-					  that reopening is expected behaviour, i.e., exit
-					  with an error when this is something where
-					  reopening should not occur (e.g. A* with a
-					  consistent heuristic).
-					*/
-					statistics.inc_reopened();
-				}
-				succ_node.reopen(*node, op, get_adjusted_cost(op));
-
-				auto succ_eval_context = EvaluationContext(succ_state, succ_node.get_g(), is_preferred, &statistics);
-				const auto evaluator_values = compute_results(succ_eval_context);
+	auto preferred_operators = ordered_set::OrderedSet<OperatorID>();
+	const auto applicable_ops = get_successor_operators(*node, preferred_operators);
 
-				/*
-				  Note: our old code used to retrieve the h value from
-				  the search node here. Our new code recomputes it as
-				  necessary, thus avoiding the incredible ugliness of
-				  the old "set_evaluator_value" approach, which also
-				  did not generalize properly to settings with more
-				  than one evaluator.
-
-				  Reopening should not happen all that frequently, so
-				  the performance impact of this is hopefully not that
-				  large. In the medium term, we want the evaluators to
-				  remember evaluator values for states themselves if
-				  desired by the user, so that such recomputations
-				  will just involve a look-up by the Evaluator object
-				  rather than a recomputation of the evaluator value
-				  from scratch.
-				*/
-				insert(succ_eval_context, evaluator_values, succ_state.get_id(), is_preferred);
-			} else {
-				// If we do not reopen closed nodes, we just update the parent pointers.
-				// Note that this could cause an incompatibility between
-				// the g-value and the actual path that is traced back.
-				succ_node.update_parent(*node, op, get_adjusted_cost(op));
-			}
+	auto local_ops = std::vector<OperatorID>();
+	auto local_succ_states = std::vector<GlobalState>();
+	auto num_transferred_states = 0;
+	for (const auto op_id : applicable_ops) {
+		const auto op = task_proxy.get_operators()[op_id];
+		statistics.inc_generated();
+		state_registry.compute_successor_data(s, op, successor_data.data());
+		const auto owner = exchange->get_owner(state_registry.get_state_hash(successor_data.data()));
+		if (owner == shard) {
+			local_ops.push_back(op_id);
+			local_succ_states.push_back(state_registry.register_state(successor_data.data(), &s));
+			continue;
 		}
+		auto &outbox = outboxes[owner];
+		outbox.states.push_back({s.get_id(), shard, node->get_g(), node->get_real_g(), op_id, preferred_operators.contains(op_id)});
+		outbox.state_data.insert(std::end(outbox.state_data), std::begin(successor_data), std::end(successor_data));
+		++num_transferred_states;
+	}
 
-		for (const auto &h_error : heuristic_error)
-			h_error->add_successor(succ_node, get_adjusted_cost(op));
+	if (!batch_evaluators.empty())
+		compute_batch(local_succ_states);
+
+	const auto num_errors = distributed_heuristic_error.size();
+	auto best_successor_keys = std::vector<int>(num_errors, heuristic_error::OneStepError::NO_VALUE);
+	for (std::size_t i = 0; i < local_ops.size(); ++i) {
+		const auto op = task_proxy.get_operators()[local_ops[i]];
+		const auto succ_node = process_successor(node->get_state_id(), shard, node->get_g(), node->get_real_g(), local_succ_states[i], op,
+		                                         preferred_operators.contains(local_ops[i]));
+		if (!succ_node)
+			continue;
+		for (std::size_t j = 0; j < num_errors; ++j) {
+			const auto value = distributed_heuristic_error[j]->get_value(*succ_node);
+			if (value == heuristic_error::OneStepError::NO_VALUE)
+				continue;
+			update_best_successor_key(best_successor_keys[j], distributed_heuristic_error[j]->get_successor_key(get_adjusted_cost(op), value));
+		}
 	}
 
-	for (const auto &h_error : heuristic_error)
-		h_error->update_error();
+	if (num_errors != 0) {
+		auto values = std::vector<int>(num_errors);
+		for (std::size_t j = 0; j < num_errors; ++j)
+			values[j] = distributed_heuristic_error[j]->get_value(*node);
+		auto it = pending_expansions.find(s.get_id());
+		if (it != std::end(pending_expansions)) {
+			// the state was reopened and expanded again before all successors of its last expansion were reported: combine both expansions
+			auto &pending_expansion = it->second;
+			pending_expansion.num_missing_reports += num_transferred_states;
+			for (std::size_t j = 0; j < num_errors; ++j)
+				update_best_successor_key(pending_expansion.best_successor_keys[j], best_successor_keys[j]);
+		} else if (num_transferred_states == 0) {
+			add_samples(values, best_successor_keys);
+		} else {
+			pending_expansions.emplace(s.get_id(), PendingExpansion{num_transferred_states, std::move(values), std::move(best_successor_keys)});
+		}
+		if (statistics.get_expanded() % exchange->get_error_synchronization_interval() == 0)
+			for (auto h_error : distributed_heuristic_error)
+				h_error->synchronize_statistics();
+	}
+
+	// send full batches immediately and all others regularly, so that idle shards do not have to wait for too long
+	send_batches(statistics.get_expanded() % exchange->get_batch_size() == 0);
 	return IN_PROGRESS;
 }
 
+template <std::size_t N>
+void EagerSuboptimalSearch<N>::receive_batches() {
+	exchange->receive(shard, received_batches);
+	if (received_batches.empty())
+		return;
+	if (idle) {
+		idle = false;
+		exchange->notify_busy();
+	}
+	auto num_messages = 0;
+	for (const auto &batch : received_batches) {
+		receive_reports(batch);
+		receive_states(batch);
+		num_messages += batch.size();
+	}
+	received_batches.clear();
+	exchange->notify_processed(num_messages);
+}
+
+template <std::size_t N>
+void EagerSuboptimalSearch<N>::receive_states(const StateBatch &batch) {
+	if (batch.states.empty())
+		return;
+	const auto bins_per_state = state_registry.get_bins_per_state();
+	auto succ_states = std::vector<GlobalState>();
+	succ_states.reserve(batch.states.size());
+	for (std::size_t i = 0; i < batch.states.size(); ++i)
+		succ_states.push_back(state_registry.register_state(batch.state_data.data() + i * bins_per_state));
+	num_received_states += batch.states.size();
+
+	if (!batch_evaluators.empty() || parallel_evaluation)
+		compute_batch(succ_states);
+
+	for (std::size_t i = 0; i < batch.states.size(); ++i) {
+		const auto &transferred_state = batch.states[i];
+		const auto op = task_proxy.get_operators()[transferred_state.op_id];
+		const auto succ_node = process_successor(transferred_state.parent_id, transferred_state.parent_shard, transferred_state.parent_g,
+		                                         transferred_state.parent_real_g, succ_states[i], op, transferred_state.preferred);
+		if (distributed_heuristic_error.empty())
+			continue;
+		// report the values of the state to the error models of the parent's shard
+		auto &reports = outboxes[transferred_state.parent_shard];
+		reports.reports.push_back({transferred_state.parent_id, get_adjusted_cost(op)});
+		for (auto h_error : distributed_heuristic_error)
+			reports.report_values.push_back(succ_node ? h_error->get_value(*succ_node) : heuristic_error::OneStepError::NO_VALUE);
+	}
+}
+
+template <std::size_t N>
+void EagerSuboptimalSearch<N>::receive_reports(const StateBatch &batch) {
+	const auto num_errors = distributed_heuristic_error.size();
+	for (std::size_t i = 0; i < batch.reports.size(); ++i) {
+		const auto &report = batch.reports[i];
+		auto it = pending_expansions.find(report.parent_id);
+		assert(it != std::end(pending_expansions));
+		auto &pending_expansion = it->second;
+		for (std::size_t j = 0; j < num_errors; ++j) {
+			const auto value = batch.report_values[i * num_errors + j];
+			if (value == heuristic_error::OneStepError::NO_VALUE)
+				continue;
+			update_best_successor_key(pending_expansion.best_successor_keys[j], distributed_heuristic_error[j]->get_successor_key(report.op_cost, value));
+		}
+		if (--pending_expansion.num_missing_reports == 0) {
+			add_samples(pending_expansion.values, pending_expansion.best_successor_keys);
+			pending_expansions.erase(it);
+		}
+	}
+}
+
+template <std::size_t N>
+void EagerSuboptimalSearch<N>::add_samples(const std::vector<int> &values, const std::vector<int> &best_successor_keys) {
+	for (std::size_t j = 0; j < distributed_heuristic_error.size(); ++j)
+		if (values[j] != heuristic_error::OneStepError::NO_VALUE && best_successor_keys[j] != heuristic_error::OneStepError::NO_VALUE)
+			distributed_heuristic_error[j]->add_sample(values[j], best_successor_keys[j]);
+}
+
+template <std::size_t N>
+void EagerSuboptimalSearch<N>::send_batch(int owner) {
+	auto &outbox = outboxes[owner];
+	if (outbox.empty())
+		return;
+	num_sent_states += outbox.states.size();
+	exchange->send(owner, std::move(outbox));
+	outbox = StateBatch();
+}
+
+template <std::size_t N>
+void EagerSuboptimalSearch<N>::send_batches(bool all) {
+	for (auto owner = 0; owner < exchange->get_num_shards(); ++owner)
+		if (all || outboxes[owner].size() >= exchange->get_batch_size())
+			send_batch(owner);
+}
+
 template <std::size_t N>
 auto EagerSuboptimalSearch<N>::compute_results(EvaluationContext &eval_context) -> EvaluatorValues {
 	auto values = EvaluatorValues();
@@ -240,6 +619,21 @@ void add_options_to_parser(OptionParser &parser) {
 	parser.add_list_option<std::shared_ptr<heuristic_error::HeuristicError>>("error", "Heuristic error observers", "[]");
 	parser.add_option<bool>("reopen_closed", "reopen closed nodes", "true");
 	parser.add_option<int>("boost", "boost value for preferred operator open lists", "0");
+	parser.add_option<int>("max_cached_preferred_operators",
+	                       "compute the preferred operators of a state when it is inserted into the open list and store them for its expansion "
+	                       "(instead of evaluating the state again when it is expanded) until this many operators are stored (0 disables the cache)",
+	                       "0", Bounds("0", "infinity"));
+	parser.add_list_option<std::shared_ptr<Evaluator>>("batch",
+	                                                   "evaluate all new successors of an expanded state at once with these evaluators before they are "
+	                                                   "inserted into the open list (only add() and ff() share work between the states of a batch, "
+	                                                   "ff_distance() is covered by batching the underlying ff()); cannot be combined with preferred operators",
+	                                                   "[]");
+	parser.add_option<int>("evaluation_threads",
+	                       "compute the heuristic estimates of all new successors of an expanded state with this many threads before they are inserted "
+	                       "into the open list. Each thread parses the heuristics again from their descriptions; path-dependent heuristics and heuristics "
+	                       "that use predefinitions are still evaluated by the search. The search finds the same plan with the same statistics "
+	                       "as with one thread if the heuristics are deterministic; cannot be combined with batch evaluation or delta encoding",
+	                       "1", Bounds("1", "infinity"));
 	SearchEngine::add_pruning_option(parser);
 	SearchEngine::add_options_to_parser(parser);
 }
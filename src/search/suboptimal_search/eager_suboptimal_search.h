@@ -5,9 +5,13 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
+#include "../per_state_information.h"
 #include "../search_engine.h"
+#include "parallel_evaluation.h"
+#include "state_exchange.h"
 
 class PruningMethod;
 
@@ -22,12 +26,18 @@ class FloatingPointEvaluator;
 
 namespace heuristic_error {
 class HeuristicError;
+class OneStepError;
+} // namespace heuristic_error
+
+namespace ordered_set {
+template <typename T>
+class OrderedSet;
 }
 
 namespace suboptimal_search {
 // N is the number of evaluators
 template <std::size_t N>
-class EagerSuboptimalSearch : public SearchEngine {
+class EagerSuboptimalSearch : public SearchEngine, public DistributableSearch {
 	static_assert(N > 0, "There must be at least one evaluator.");
 
 	const bool reopen_closed_nodes;
@@ -39,6 +49,92 @@ class EagerSuboptimalSearch : public SearchEngine {
 	int max_g_value;
 	auto check_progress(int g_value) -> bool;
 
+	// number of times a node was opened (including reopenings of closed nodes)
+	int num_opened_nodes;
+
+	/*
+	  Preferred operators of a state, computed together with the evaluator
+	  values when the state is inserted into the open list and reused when it
+	  is expanded (instead of evaluating the state again). The operators of
+	  all states are stored consecutively in one pool, the record of a state
+	  refers to a range of this pool. Once the pool contains
+	  max_cached_preferred_operators operators, no further states are cached.
+	*/
+	struct PreferredOperatorsRecord {
+		int begin = -1;
+		int size = 0;
+	};
+	const int max_cached_preferred_operators;
+	PerStateInformation<PreferredOperatorsRecord> preferred_operators_cache;
+	std::vector<OperatorID> preferred_operators_pool;
+	int num_preferred_operator_cache_hits;
+
+	/*
+	  Evaluators that compute the estimates of all new successors of an
+	  expanded state in one batch before they are evaluated one by one
+	  (see Evaluator::compute_batch).
+	*/
+	std::vector<std::shared_ptr<Evaluator>> batch_evaluators;
+
+	/*
+	  Computes the estimates of the heuristics for all new successors of an
+	  expanded state in several threads before they are evaluated one by one
+	  (see parallel_evaluation.h). Only used with more than one evaluation
+	  thread, started once the initial state is evaluated.
+	*/
+	const int evaluation_threads;
+	std::unique_ptr<ParallelEvaluation> parallel_evaluation;
+
+	/*
+	  Hash-distributed search (see state_exchange.h), only used if this
+	  search is connected to an exchange. The parent of a state can be owned
+	  by another shard, so the shard of the parent is stored for each state.
+	*/
+	StateExchange *exchange;
+	int shard;
+	bool idle;
+	std::unique_ptr<PerStateInformation<int>> parent_shards;
+	std::vector<StateBatch> outboxes;
+	std::vector<StateBatch> received_batches;
+	std::vector<PackedStateBin> successor_data;
+	StateID goal_state_id;
+	int num_sent_states;
+	int num_received_states;
+
+	/*
+	  The one-step errors of expanded states whose successors are evaluated
+	  by other shards can only be computed when all of them are reported
+	  back. Until then, the values of the state and the best keys of its
+	  successors reported so far are stored here (one per error model).
+	*/
+	struct PendingExpansion {
+		int num_missing_reports;
+		std::vector<int> values;
+		std::vector<int> best_successor_keys;
+	};
+	std::vector<heuristic_error::OneStepError *> distributed_heuristic_error;
+	std::unordered_map<StateID, PendingExpansion> pending_expansions;
+
+	auto cache_preferred_operators() const -> bool;
+	auto create_successor_eval_context(const GlobalState &state, int g, bool is_preferred) -> EvaluationContext;
+	void store_preferred_operators(EvaluationContext &eval_context);
+
+	auto get_successor_operators(const SearchNode &node, ordered_set::OrderedSet<OperatorID> &preferred_operators) -> std::vector<OperatorID>;
+	void start_parallel_evaluation(const EvaluationContext &initial_eval_context);
+	// compute the estimates of the new states among the given successors with the batch evaluators or in parallel
+	void compute_batch(const std::vector<GlobalState> &succ_states);
+	// returns the node of the successor unless it is a dead end
+	auto process_successor(StateID parent_id, int parent_shard, int parent_g, int parent_real_g, const GlobalState &succ_state, const OperatorProxy &op,
+	                       bool is_preferred) -> std::optional<SearchNode>;
+
+	auto distributed_step() -> SearchStatus;
+	void receive_batches();
+	void receive_states(const StateBatch &batch);
+	void receive_reports(const StateBatch &batch);
+	void send_batch(int owner);
+	void send_batches(bool all);
+	void add_samples(const std::vector<int> &values, const std::vector<int> &best_successor_keys);
+
 protected:
 	virtual void reward_progress() = 0;
 
@@ -52,6 +148,8 @@ protected:
 	auto compute_results(EvaluationContext &eval_context) -> EvaluatorValues;
 	auto is_dead_end(const EvaluatorValues &values) -> bool;
 
+	auto get_num_open_nodes() const -> int { return num_opened_nodes - statistics.get_expanded(); }
+
 	virtual void initialize_heuristic_error(EvaluationContext &eval_context);
 	virtual void initialize_extra(EvaluationContext &) {}
 
@@ -65,6 +163,11 @@ public:
 	void print_statistics() const override;
 
 	void dump_search_space() const;
+
+	auto supports_distribution() const -> bool override { return false; }
+	void connect(StateExchange &exchange, int shard) override;
+	auto get_goal_state_id() const -> StateID override { return goal_state_id; }
+	void trace_step(StateID state_id, OperatorID &creating_operator, int &parent_shard, StateID &parent_id) override;
 };
 
 extern void add_options_to_parser(options::OptionParser &parser);
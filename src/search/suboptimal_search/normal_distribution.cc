@@ -0,0 +1,77 @@
+#include "normal_distribution.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+#include "../utils/system.h"
+
+namespace suboptimal_search {
+namespace {
+constexpr auto table_bound = 8.;
+constexpr auto steps_per_unit = 32;
+constexpr auto table_size = static_cast<std::size_t>(2 * table_bound * steps_per_unit) + 1;
+
+// CDF and density of the standard normal distribution at -table_bound + i / steps_per_unit
+struct NormalCDFTable {
+	std::array<double, table_size> cdf;
+	std::array<double, table_size> pdf;
+
+	NormalCDFTable() {
+		const auto inv_sqrt_2pi = 1. / std::sqrt(2. * std::acos(-1.));
+		for (std::size_t i = 0; i < table_size; ++i) {
+			const auto x = -table_bound + static_cast<double>(i) / steps_per_unit;
+			cdf[i] = normal_cdf_erf(x);
+			// the interpolation is done on the unit interval, so the derivative is scaled by the step size
+			pdf[i] = inv_sqrt_2pi * std::exp(-x * x / 2) / steps_per_unit;
+		}
+	}
+};
+
+const auto table = NormalCDFTable();
+
+inline auto interpolate(double x) -> double {
+	assert(!std::isnan(x));
+	const auto u = (std::clamp(x, -table_bound, table_bound) + table_bound) * steps_per_unit;
+	const auto i = std::min(static_cast<std::size_t>(u), table_size - 2);
+	const auto t = u - static_cast<double>(i);
+	const auto t2 = t * t;
+	const auto t3 = t2 * t;
+	return (2 * t3 - 3 * t2 + 1) * table.cdf[i] + (t3 - 2 * t2 + t) * table.pdf[i] + (3 * t2 - 2 * t3) * table.cdf[i + 1] + (t3 - t2) * table.pdf[i + 1];
+}
+} // namespace
+
+auto normal_cdf_erf(double x) -> double {
+	return (1 + std::erf(x / std::sqrt(2.))) / 2.;
+}
+
+auto normal_cdf_table(double x) -> double {
+	return interpolate(x);
+}
+
+auto normal_cdf(double x, NormalCDFMethod method) -> double {
+	switch (method) {
+	case NormalCDFMethod::ERF:
+		return normal_cdf_erf(x);
+	case NormalCDFMethod::TABLE:
+		return interpolate(x);
+	}
+	utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+}
+
+void normal_cdf(const double *x, double *out, std::size_t n, NormalCDFMethod method) {
+	switch (method) {
+	case NormalCDFMethod::ERF:
+		for (std::size_t i = 0; i < n; ++i)
+			out[i] = normal_cdf_erf(x[i]);
+		return;
+	case NormalCDFMethod::TABLE:
+		// branch-free loop body so that the compiler can vectorize it where gathers are available
+		for (std::size_t i = 0; i < n; ++i)
+			out[i] = interpolate(x[i]);
+		return;
+	}
+	utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+}
+} // namespace suboptimal_search
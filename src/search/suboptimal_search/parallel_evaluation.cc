@@ -0,0 +1,133 @@
+#include "parallel_evaluation.h"
+
+#include <cassert>
+
+#include "../evaluation_context.h"
+#include "../heuristic.h"
+#include "../option_parser.h"
+#include "../state_registry.h"
+#include "../options/raw_registry.h"
+#include "../utils/logging.h"
+
+namespace suboptimal_search {
+ParallelEvaluation::ParallelEvaluation(const TaskProxy &task_proxy, const std::vector<Heuristic *> &candidate_heuristics, int num_threads)
+	: task_proxy(task_proxy),
+	  registry(*options::RawRegistry::instance()),
+	  states(nullptr),
+	  next_state(0),
+	  batch_number(0),
+	  num_busy_workers(0),
+	  stopping(false) {
+	auto configs = std::vector<std::string>();
+	for (const auto heuristic : candidate_heuristics) {
+		if (can_parse_again(*heuristic)) {
+			heuristics.push_back(heuristic);
+			configs.push_back(heuristic->get_description());
+		} else {
+			utils::g_log << "Evaluating " << heuristic->get_description() << " sequentially: it uses predefinitions." << std::endl;
+		}
+	}
+	estimates.resize(heuristics.size());
+	if (heuristics.empty())
+		return;
+	workers.reserve(num_threads);
+	num_busy_workers = num_threads;
+	for (auto i = 0; i < num_threads; ++i)
+		workers.emplace_back(&ParallelEvaluation::run_worker, this, configs);
+	// wait until all workers have parsed their heuristics (so that their output does not interleave with the search)
+	auto lock = std::unique_lock<std::mutex>(mutex);
+	work_done.wait(lock, [this]() { return num_busy_workers == 0; });
+}
+
+ParallelEvaluation::~ParallelEvaluation() {
+	{
+		auto lock = std::lock_guard<std::mutex>(mutex);
+		stopping = true;
+	}
+	work_available.notify_all();
+	for (auto &worker : workers)
+		worker.join();
+}
+
+auto ParallelEvaluation::can_parse_again(const Heuristic &heuristic) -> bool {
+	try {
+		auto parser = options::OptionParser(heuristic.get_description(), registry, no_predefinitions, true);
+		parser.start_parsing<std::shared_ptr<Evaluator>>();
+	} catch (const utils::Exception &) {
+		return false;
+	}
+	return true;
+}
+
+auto ParallelEvaluation::parse_heuristics(const std::vector<std::string> &configs) -> std::vector<std::shared_ptr<Evaluator>> {
+	// parsing is not thread-safe (it creates the task transformations and their caches), so the workers parse one after the other
+	auto lock = std::lock_guard<std::mutex>(mutex);
+	auto worker_heuristics = std::vector<std::shared_ptr<Evaluator>>();
+	for (const auto &config : configs) {
+		auto parser = options::OptionParser(config, registry, no_predefinitions, false);
+		worker_heuristics.push_back(parser.start_parsing<std::shared_ptr<Evaluator>>());
+	}
+	return worker_heuristics;
+}
+
+void ParallelEvaluation::run_worker(const std::vector<std::string> &configs) {
+	auto worker_heuristics = parse_heuristics(configs);
+	auto state_registry = std::make_unique<StateRegistry>(task_proxy);
+	{
+		auto lock = std::lock_guard<std::mutex>(mutex);
+		if (--num_busy_workers == 0)
+			work_done.notify_one();
+	}
+
+	auto last_batch_number = 0;
+	while (true) {
+		{
+			auto lock = std::unique_lock<std::mutex>(mutex);
+			work_available.wait(lock, [&]() { return stopping || batch_number != last_batch_number; });
+			if (stopping)
+				return;
+			last_batch_number = batch_number;
+		}
+
+		if (state_registry->size() >= max_registered_states) {
+			// the registry is released before the heuristics that are subscribed to it
+			state_registry.reset();
+			worker_heuristics = parse_heuristics(configs);
+			state_registry = std::make_unique<StateRegistry>(task_proxy);
+		}
+
+		const auto num_states = static_cast<int>(states->size());
+		for (auto i = next_state.fetch_add(1); i < num_states; i = next_state.fetch_add(1)) {
+			const auto state = state_registry->register_state((*states)[i].get_packed_buffer());
+			auto eval_context = EvaluationContext(state);
+			for (std::size_t j = 0; j < worker_heuristics.size(); ++j)
+				estimates[j][i] = eval_context.get_result(worker_heuristics[j].get()).get_evaluator_value();
+		}
+
+		{
+			auto lock = std::lock_guard<std::mutex>(mutex);
+			if (--num_busy_workers == 0)
+				work_done.notify_one();
+		}
+	}
+}
+
+void ParallelEvaluation::evaluate(const std::vector<GlobalState> &states) {
+	if (states.empty() || heuristics.empty())
+		return;
+	{
+		auto lock = std::unique_lock<std::mutex>(mutex);
+		this->states = &states;
+		for (auto &heuristic_estimates : estimates)
+			heuristic_estimates.resize(states.size());
+		next_state = 0;
+		num_busy_workers = static_cast<int>(workers.size());
+		++batch_number;
+		work_available.notify_all();
+		work_done.wait(lock, [this]() { return num_busy_workers == 0; });
+		this->states = nullptr;
+	}
+	for (std::size_t j = 0; j < heuristics.size(); ++j)
+		heuristics[j]->set_batch_estimates(states, estimates[j]);
+}
+} // namespace suboptimal_search
@@ -0,0 +1,92 @@
+#ifndef SUBOPTIMAL_SEARCH_PARALLEL_EVALUATION_H
+#define SUBOPTIMAL_SEARCH_PARALLEL_EVALUATION_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../global_state.h"
+#include "../options/predefinitions.h"
+#include "../options/registries.h"
+#include "../task_proxy.h"
+
+class Evaluator;
+class Heuristic;
+
+namespace suboptimal_search {
+/*
+  Computes the estimates of heuristics for all new successors of an expanded
+  state in several threads, so that the search itself can stay sequential.
+
+  Heuristics are not thread-safe, so every worker thread parses the
+  configurations of the heuristics (their descriptions) again without
+  predefinitions and evaluates the states with its own heuristics. It
+  registers the states in its own state registry, each state with its own
+  evaluation context, so the workers share nothing but the packed data of
+  the states, which the search does not change while they run. The
+  estimates are then handed to the heuristics of the search (see
+  Heuristic::set_batch_estimates), which use them instead of computing them
+  when the search evaluates the states one by one. Thus the search inserts
+  the states into its registry, search space, open list and heuristic error
+  models in the same order as without threads, and the plan and statistics
+  are the same as long as the heuristics are deterministic.
+
+  The registry of a worker stores every state it evaluated, and its
+  heuristics cache their estimates. Heuristics may identify states by their
+  IDs (e.g. ff() remembers the last evaluated state), so the registry cannot
+  simply be replaced while the heuristics live on. Instead, once the
+  registry holds max_registered_states states, the worker parses its
+  heuristics again and starts over with a new registry, which bounds the
+  memory of a worker.
+*/
+class ParallelEvaluation {
+	// number of states after which a worker replaces its registry and heuristics
+	static constexpr std::size_t max_registered_states = 1 << 16;
+
+	const TaskProxy task_proxy;
+	// only used to parse the heuristics, one worker after the other
+	options::Registry registry;
+	std::vector<Heuristic *> heuristics;
+	const options::Predefinitions no_predefinitions;
+
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable work_available;
+	std::condition_variable work_done;
+	// the states of the current batch and their estimates, one vector per heuristic
+	const std::vector<GlobalState> *states;
+	std::vector<std::vector<int>> estimates;
+	std::atomic<int> next_state;
+	int batch_number;
+	int num_busy_workers;
+	bool stopping;
+
+	/*
+	  Whether the configuration of the heuristic can be parsed again without
+	  predefinitions (which would share the predefined objects with the
+	  search).
+	*/
+	auto can_parse_again(const Heuristic &heuristic) -> bool;
+	auto parse_heuristics(const std::vector<std::string> &configs) -> std::vector<std::shared_ptr<Evaluator>>;
+	void run_worker(const std::vector<std::string> &configs);
+
+public:
+	// heuristics whose configuration cannot be parsed again are not evaluated in parallel
+	ParallelEvaluation(const TaskProxy &task_proxy, const std::vector<Heuristic *> &candidate_heuristics, int num_threads);
+	~ParallelEvaluation();
+
+	ParallelEvaluation(const ParallelEvaluation &other) = delete;
+	auto operator=(const ParallelEvaluation &other) -> ParallelEvaluation & = delete;
+
+	auto get_num_heuristics() const -> int { return static_cast<int>(heuristics.size()); }
+
+	// compute the estimates of the given states and pass them to the heuristics (the states must not be evaluated yet)
+	void evaluate(const std::vector<GlobalState> &states);
+};
+} // namespace suboptimal_search
+
+#endif
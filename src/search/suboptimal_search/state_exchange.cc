@@ -0,0 +1,28 @@
+#include "state_exchange.h"
+
+#include "../heuristic_error/error_statistics.h"
+
+namespace suboptimal_search {
+StateExchange::StateExchange(int num_shards, int batch_size, int error_synchronization_interval, int error_snapshot_interval)
+	: num_shards(num_shards),
+	  batch_size(batch_size),
+	  error_synchronization_interval(error_synchronization_interval),
+	  error_snapshot_interval(error_snapshot_interval),
+	  pending_work(num_shards) {
+	inboxes.reserve(num_shards);
+	for (auto i = 0; i < num_shards; ++i)
+		inboxes.push_back(std::make_unique<mpsc_queue::MPSCQueue<StateBatch>>());
+}
+
+void StateExchange::send(int shard, StateBatch &&batch) {
+	// count the messages before they can be received
+	pending_work.fetch_add(batch.size(), std::memory_order_acq_rel);
+	inboxes[shard]->push(std::move(batch));
+}
+
+auto StateExchange::get_error_statistics(std::size_t index) -> std::shared_ptr<heuristic_error::SharedErrorStatistics> {
+	while (error_statistics.size() <= index)
+		error_statistics.push_back(std::make_shared<heuristic_error::SharedErrorStatistics>(num_shards));
+	return error_statistics[index];
+}
+} // namespace suboptimal_search
@@ -0,0 +1,125 @@
+#ifndef SUBOPTIMAL_SEARCH_STATE_EXCHANGE_H
+#define SUBOPTIMAL_SEARCH_STATE_EXCHANGE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../algorithms/mpsc_queue.h"
+#include "../global_state.h"
+#include "../operator_id.h"
+#include "../state_id.h"
+
+namespace heuristic_error {
+class SharedErrorStatistics;
+}
+
+namespace suboptimal_search {
+/*
+  A state generated by the search of one thread (the parent's shard) that is
+  owned by the search of another thread. The parent's ID refers to the state
+  registry of its shard.
+*/
+struct TransferredState {
+	StateID parent_id;
+	int parent_shard;
+	int parent_g;
+	int parent_real_g;
+	OperatorID op_id;
+	bool preferred;
+};
+
+/*
+  Sent back to the shard of the parent of a transferred state: the values of
+  the state for the heuristic error models, so that the parent's shard can
+  compute the one-step error of the parent once it knows all successors.
+*/
+struct SuccessorReport {
+	StateID parent_id;
+	int op_cost;
+};
+
+// Messages from one shard to another, sent together to amortize the synchronization.
+struct StateBatch {
+	std::vector<TransferredState> states;
+	// the packed data of the transferred states, one after the other
+	std::vector<PackedStateBin> state_data;
+	std::vector<SuccessorReport> reports;
+	// the values of the reported states, one per heuristic error model and report
+	std::vector<int> report_values;
+
+	auto size() const -> int { return static_cast<int>(states.size() + reports.size()); }
+	auto empty() const -> bool { return states.empty() && reports.empty(); }
+};
+
+/*
+  Connects the searches of a hash-distributed search, in which each thread
+  (shard) runs its own search with its own state registry, search space and
+  open list. Each state is owned by the shard determined by its hash, and
+  all successors are sent to the search of their owner, which detects
+  duplicates and evaluates, opens and expands them (Kishimoto, Fukunaga, and
+  Botea, 2009). Every shard has a lock-free inbox to which all other shards
+  send their batches.
+
+  The search has terminated without a solution when all shards are idle and
+  no messages are in flight. To detect this, the exchange counts the busy
+  shards plus the messages that were sent but not yet processed. A shard
+  only becomes busy again by receiving a message, so the count cannot drop
+  to zero while there is work left.
+*/
+class StateExchange {
+	const int num_shards;
+	const int batch_size;
+	const int error_synchronization_interval;
+	const int error_snapshot_interval;
+	std::vector<std::unique_ptr<mpsc_queue::MPSCQueue<StateBatch>>> inboxes;
+	std::atomic<std::int64_t> pending_work;
+	std::vector<std::shared_ptr<heuristic_error::SharedErrorStatistics>> error_statistics;
+
+public:
+	StateExchange(int num_shards, int batch_size, int error_synchronization_interval, int error_snapshot_interval);
+
+	auto get_num_shards() const -> int { return num_shards; }
+	auto get_batch_size() const -> int { return batch_size; }
+	auto get_error_synchronization_interval() const -> int { return error_synchronization_interval; }
+	auto get_error_snapshot_interval() const -> int { return error_snapshot_interval; }
+
+	auto get_owner(std::uint64_t state_hash) const -> int {
+		// use the high bits: the registries of the shards use the low bits for their hash tables
+		return static_cast<int>(((state_hash >> 32) * static_cast<std::uint64_t>(num_shards)) >> 32);
+	}
+
+	void send(int shard, StateBatch &&batch);
+	void receive(int shard, std::vector<StateBatch> &batches) { inboxes[shard]->pop_all(batches); }
+
+	void notify_busy() { pending_work.fetch_add(1, std::memory_order_acq_rel); }
+	void notify_idle() { pending_work.fetch_sub(1, std::memory_order_acq_rel); }
+	// must be called after the received messages are processed (and their results sent)
+	void notify_processed(int num_messages) { pending_work.fetch_sub(num_messages, std::memory_order_acq_rel); }
+	auto is_finished() const -> bool { return pending_work.load(std::memory_order_acquire) == 0; }
+
+	/*
+	  Statistics shared by the index-th heuristic error model of all shards.
+	  Not thread-safe, so the shards must be connected one after the other.
+	*/
+	auto get_error_statistics(std::size_t index) -> std::shared_ptr<heuristic_error::SharedErrorStatistics>;
+};
+
+// Interface of searches that can be run as a shard of a hash-distributed search.
+class DistributableSearch {
+public:
+	virtual ~DistributableSearch() = default;
+
+	virtual auto supports_distribution() const -> bool = 0;
+	// must be called before the search is started
+	virtual void connect(StateExchange &exchange, int shard) = 0;
+
+	// the goal state expanded by this shard or StateID::no_state
+	virtual auto get_goal_state_id() const -> StateID = 0;
+	// the creating operator and the parent (shard and ID) of a state of this shard, the parent ID is StateID::no_state for the initial state
+	virtual void trace_step(StateID state_id, OperatorID &creating_operator, int &parent_shard, StateID &parent_id) = 0;
+};
+} // namespace suboptimal_search
+
+#endif
@@ -1,11 +1,13 @@
 #include "util.h"
 
 #include "../evaluator.h"
+#include "../floating_point_open_list/heap_type.h"
 #include "../heuristic_error/debiased_heuristic.h"
 #include "../heuristic_error/one_step_heuristic_error.h"
 #include "../heuristic_error/percentage_based_debiased_heuristic.h"
 #include "../heuristic_error/percentage_based_heuristic_error.h"
 #include "../option_parser.h"
+#include "normal_distribution.h"
 
 using namespace floating_point_evaluator;
 using namespace heuristic_error;
@@ -33,6 +35,11 @@ void add_online_variance_option(options::OptionParser &parser) {
 	parser.add_option<bool>("use_online_variance", "use variance measured online for the probability distributions", "false");
 }
 
+void add_normal_cdf_option(options::OptionParser &parser) {
+	parser.add_enum_option<NormalCDFMethod>("normal_cdf", {"ERF", "TABLE"},
+	                                        "how to evaluate the normal CDF for the probability distributions (TABLE interpolates a precomputed table)", "ERF");
+}
+
 void add_d_tie_breaking_option(options::OptionParser &parser) {
 	parser.add_option<bool>("enable_tie_breaking", "break ties by estimated goal distance", "true");
 }
@@ -45,6 +52,13 @@ void add_f_hat_then_d_tie_breaking_option(options::OptionParser &parser) {
 	parser.add_option<bool>("enable_tie_breaking", "break ties by f-hat and then estimated goal distance", "true");
 }
 
+void add_open_list_heap_options(options::OptionParser &parser) {
+	parser.add_enum_option<floating_point_open_list::HeapType>("heap", {"BINARY", "D_ARY_4", "D_ARY_8"},
+	                                                           "heap implementation of the main open list (the d-ary heaps store keys and values in separate arrays)",
+	                                                           "BINARY");
+	parser.add_option<bool>("compress_primary_key", "store the primary open list key in single precision (only supported by the d-ary heaps)", "false");
+}
+
 auto get_heuristic_error(bool percentage_based_error, const std::shared_ptr<Evaluator> &heuristic, int warm_start_samples, double warm_start_value)
 		-> std::shared_ptr<HeuristicError> {
 	auto heuristic_error_opts = Options();
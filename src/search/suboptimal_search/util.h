@@ -22,11 +22,14 @@ void add_warm_start_options(options::OptionParser &parser);
 void add_bounded_cost_warm_start_options(options::OptionParser &parser);
 void add_percentage_based_error_option(options::OptionParser &parser);
 void add_online_variance_option(options::OptionParser &parser);
+void add_normal_cdf_option(options::OptionParser &parser);
 
 void add_d_tie_breaking_option(options::OptionParser &parser);
 void add_f_then_h_tie_breaking_option(options::OptionParser &parser);
 void add_f_hat_then_d_tie_breaking_option(options::OptionParser &parser);
 
+void add_open_list_heap_options(options::OptionParser &parser);
+
 auto get_heuristic_error(bool percentage_based_error, const std::shared_ptr<Evaluator> &heuristic, int warm_start_samples, double warm_start_value)
 		-> std::shared_ptr<heuristic_error::HeuristicError>;
 auto get_debiased_heuristic(bool percentage_based_error, const std::shared_ptr<Evaluator> &heuristic,
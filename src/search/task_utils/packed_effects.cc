@@ -0,0 +1,90 @@
+#include "packed_effects.h"
+
+#include "task_properties.h"
+
+#include "../task_proxy.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace std;
+
+namespace packed_effects {
+PackedEffects::PackedEffects(
+    const TaskProxy &task_proxy, const int_packer::IntPacker &state_packer) {
+    OperatorsProxy operators = task_proxy.get_operators();
+    operator_effects.reserve(operators.size());
+    for (OperatorProxy op : operators) {
+        OperatorEffects op_effects;
+        op_effects.effects_begin = effects.size();
+        op_effects.conditional_effects_begin = conditional_effects.size();
+        unordered_set<int> conditionally_affected_vars;
+        for (EffectProxy effect : op.get_effects()) {
+            FactPair fact = effect.get_fact().get_pair();
+            BinEffect bin_effect;
+            bin_effect.bin = state_packer.get_bin_index(fact.var);
+            bin_effect.clear_mask = ~state_packer.get_read_mask(fact.var);
+            bin_effect.set_bits = Bin(fact.value) << state_packer.get_shift(fact.var);
+            EffectConditionsProxy effect_conditions = effect.get_conditions();
+            if (effect_conditions.empty() &&
+                !conditionally_affected_vars.count(fact.var)) {
+                auto it = find_if(
+                    effects.begin() + op_effects.effects_begin, effects.end(),
+                    [&bin_effect](const BinEffect &other) {
+                        return other.bin == bin_effect.bin;
+                    });
+                if (it == effects.end()) {
+                    effects.push_back(bin_effect);
+                } else {
+                    it->clear_mask &= bin_effect.clear_mask;
+                    it->set_bits = (it->set_bits & bin_effect.clear_mask) | bin_effect.set_bits;
+                }
+            } else {
+                conditionally_affected_vars.insert(fact.var);
+                ConditionalEffect conditional_effect;
+                conditional_effect.effect = bin_effect;
+                conditional_effect.conditions_begin = conditions.size();
+                bool contradicting_conditions = false;
+                for (FactProxy condition : effect_conditions) {
+                    FactPair condition_fact = condition.get_pair();
+                    int bin = state_packer.get_bin_index(condition_fact.var);
+                    Bin mask = state_packer.get_read_mask(condition_fact.var);
+                    Bin value = Bin(condition_fact.value) << state_packer.get_shift(condition_fact.var);
+                    auto it = find_if(
+                        conditions.begin() + conditional_effect.conditions_begin,
+                        conditions.end(),
+                        [bin](const BinCondition &other) {return other.bin == bin;});
+                    if (it == conditions.end()) {
+                        conditions.push_back({bin, mask, value});
+                    } else if ((it->mask & mask) && (it->value & mask) != value) {
+                        contradicting_conditions = true;
+                    } else {
+                        it->mask |= mask;
+                        it->value |= value;
+                    }
+                }
+                conditional_effect.conditions_end = conditions.size();
+                if (contradicting_conditions) {
+                    // The effect never fires.
+                    conditions.resize(conditional_effect.conditions_begin);
+                } else {
+                    conditional_effects.push_back(conditional_effect);
+                }
+            }
+        }
+        op_effects.effects_end = effects.size();
+        op_effects.conditional_effects_end = conditional_effects.size();
+        operator_effects.push_back(op_effects);
+    }
+    effects.shrink_to_fit();
+    conditional_effects.shrink_to_fit();
+    conditions.shrink_to_fit();
+}
+
+PerTaskInformation<PackedEffects> g_packed_effects(
+    [](const TaskProxy &task_proxy) {
+        return utils::make_unique_ptr<PackedEffects>(
+            task_proxy, task_properties::g_state_packers[task_proxy]);
+    }
+    );
+}
@@ -0,0 +1,98 @@
+#ifndef TASK_UTILS_PACKED_EFFECTS_H
+#define TASK_UTILS_PACKED_EFFECTS_H
+
+#include "../per_task_information.h"
+
+#include "../algorithms/int_packer.h"
+
+#include <vector>
+
+class TaskProxy;
+
+namespace packed_effects {
+/*
+  The effects of all operators of a task, compiled to operations on packed
+  states (see IntPacker). Applying an operator then only changes the affected
+  bins of the state instead of setting one variable at a time through the
+  task interface.
+
+  The unconditional effects of an operator are merged into one entry per
+  affected bin: buffer[bin] = (buffer[bin] & clear_mask) | set_bits.
+  Conditional effects are kept in a separate list in their original order,
+  each with its conditions as (bin, mask, value) tests on the packed
+  predecessor state. They are applied after the unconditional effects,
+  which is equivalent to applying the effects in their original order
+  unless an unconditional effect follows a conditional effect on the same
+  variable. Such unconditional effects are treated as conditional effects
+  without conditions to preserve the order.
+*/
+class PackedEffects {
+    using Bin = int_packer::IntPacker::Bin;
+
+    struct BinEffect {
+        int bin;
+        Bin clear_mask;
+        Bin set_bits;
+    };
+
+    struct BinCondition {
+        int bin;
+        Bin mask;
+        Bin value;
+    };
+
+    struct ConditionalEffect {
+        BinEffect effect;
+        int conditions_begin;
+        int conditions_end;
+    };
+
+    struct OperatorEffects {
+        int effects_begin;
+        int effects_end;
+        int conditional_effects_begin;
+        int conditional_effects_end;
+    };
+
+    std::vector<OperatorEffects> operator_effects;
+    std::vector<BinEffect> effects;
+    std::vector<ConditionalEffect> conditional_effects;
+    std::vector<BinCondition> conditions;
+public:
+    PackedEffects(
+        const TaskProxy &task_proxy, const int_packer::IntPacker &state_packer);
+
+    /*
+      Apply the effects of the operator with the given ID to buffer, which
+      initially holds a copy of predecessor. Conditions of conditional
+      effects are evaluated on predecessor.
+    */
+    void apply(int op_id, const Bin *predecessor, Bin *buffer) const {
+        const OperatorEffects &op = operator_effects[op_id];
+        for (int i = op.effects_begin; i < op.effects_end; ++i) {
+            const BinEffect &effect = effects[i];
+            buffer[effect.bin] = (buffer[effect.bin] & effect.clear_mask) | effect.set_bits;
+        }
+        for (int i = op.conditional_effects_begin; i < op.conditional_effects_end; ++i) {
+            const ConditionalEffect &conditional_effect = conditional_effects[i];
+            bool fires = true;
+            for (int j = conditional_effect.conditions_begin;
+                 j < conditional_effect.conditions_end; ++j) {
+                const BinCondition &condition = conditions[j];
+                if ((predecessor[condition.bin] & condition.mask) != condition.value) {
+                    fires = false;
+                    break;
+                }
+            }
+            if (fires) {
+                const BinEffect &effect = conditional_effect.effect;
+                buffer[effect.bin] = (buffer[effect.bin] & effect.clear_mask) | effect.set_bits;
+            }
+        }
+    }
+};
+
+extern PerTaskInformation<PackedEffects> g_packed_effects;
+}
+
+#endif
@@ -2,6 +2,7 @@
 
 #include "successor_generator_factory.h"
 #include "successor_generator_internals.h"
+#include "task_properties.h"
 
 #include "../abstract_task.h"
 #include "../global_state.h"
@@ -9,21 +10,65 @@
 using namespace std;
 
 namespace successor_generator {
-SuccessorGenerator::SuccessorGenerator(const TaskProxy &task_proxy)
+SuccessorGenerator::SuccessorGenerator(const TaskProxy &task_proxy, Backend backend)
     : root(SuccessorGeneratorFactory(task_proxy).create()) {
+    if (backend != Backend::TREE) {
+        const int_packer::IntPacker &state_packer =
+            task_properties::g_state_packers[task_proxy];
+        flat = utils::make_unique_ptr<GeneratorFlat>(
+            *root, state_packer, task_proxy.get_variables().size());
+        if (backend == Backend::PRECONDITION_MASKS) {
+            precondition_masks = utils::make_unique_ptr<GeneratorPreconditionMasks>(
+                task_proxy, state_packer, flat->get_operator_order());
+            flat = nullptr;
+        }
+        root = nullptr;
+    }
 }
 
 SuccessorGenerator::~SuccessorGenerator() = default;
 
 void SuccessorGenerator::generate_applicable_ops(
     const State &state, vector<OperatorID> &applicable_ops) const {
-    root->generate_applicable_ops(state, applicable_ops);
+    if (root)
+        root->generate_applicable_ops(state, applicable_ops);
+    else if (flat)
+        flat->generate_applicable_ops(state, applicable_ops);
+    else
+        precondition_masks->generate_applicable_ops(state, applicable_ops);
 }
 
 void SuccessorGenerator::generate_applicable_ops(
     const GlobalState &state, vector<OperatorID> &applicable_ops) const {
-    root->generate_applicable_ops(state, applicable_ops);
+    if (root)
+        root->generate_applicable_ops(state, applicable_ops);
+    else if (flat)
+        flat->generate_applicable_ops(state, applicable_ops);
+    else
+        precondition_masks->generate_applicable_ops(state, applicable_ops);
 }
 
 PerTaskInformation<SuccessorGenerator> g_successor_generators;
+
+static PerTaskInformation<SuccessorGenerator> g_flat_successor_generators(
+    [](const TaskProxy &task_proxy) {
+        return utils::make_unique_ptr<SuccessorGenerator>(task_proxy, Backend::FLAT);
+    });
+
+static PerTaskInformation<SuccessorGenerator> g_precondition_mask_successor_generators(
+    [](const TaskProxy &task_proxy) {
+        return utils::make_unique_ptr<SuccessorGenerator>(
+            task_proxy, Backend::PRECONDITION_MASKS);
+    });
+
+PerTaskInformation<SuccessorGenerator> &get_successor_generators(Backend backend) {
+    switch (backend) {
+    case Backend::FLAT:
+        return g_flat_successor_generators;
+    case Backend::PRECONDITION_MASKS:
+        return g_precondition_mask_successor_generators;
+    default:
+        return g_successor_generators;
+    }
+}
 }
@@ -13,12 +13,35 @@ class TaskProxy;
 
 namespace successor_generator {
 class GeneratorBase;
+class GeneratorFlat;
+class GeneratorPreconditionMasks;
+
+/*
+  How the applicable operators are computed:
+  - TREE: walk the decision tree built by SuccessorGeneratorFactory.
+  - FLAT: walk the same tree compiled into a flat byte code without virtual
+    calls or recursion, reading variable values directly from the packed
+    state (see GeneratorFlat).
+  - PRECONDITION_MASKS: test the preconditions of all operators with masks
+    on the packed state (see GeneratorPreconditionMasks). Only efficient
+    for tasks whose states are packed into few bins.
+  All backends generate the same operators in the same order.
+*/
+enum class Backend {
+    TREE,
+    FLAT,
+    PRECONDITION_MASKS
+};
 
 class SuccessorGenerator {
     std::unique_ptr<GeneratorBase> root;
+    // At most one of these is set, depending on the backend.
+    std::unique_ptr<GeneratorFlat> flat;
+    std::unique_ptr<GeneratorPreconditionMasks> precondition_masks;
 
 public:
-    explicit SuccessorGenerator(const TaskProxy &task_proxy);
+    explicit SuccessorGenerator(
+        const TaskProxy &task_proxy, Backend backend = Backend::TREE);
     /*
       We cannot use the default destructor (implicitly or explicitly)
       here because GeneratorBase is a forward declaration and the
@@ -34,6 +57,9 @@ public:
 };
 
 extern PerTaskInformation<SuccessorGenerator> g_successor_generators;
+
+// Successor generators of the given backend, shared by all users of a task.
+extern PerTaskInformation<SuccessorGenerator> &get_successor_generators(Backend backend);
 }
 
 #endif
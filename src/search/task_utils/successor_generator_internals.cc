@@ -3,6 +3,9 @@
 #include "../global_state.h"
 #include "../task_proxy.h"
 
+#include "../algorithms/int_packer.h"
+
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -22,7 +25,8 @@ using namespace std;
   - Going further down this route, on the more extreme end of the
     spectrum, we could use a "byte-code" style representation, where
     the successor generator is just a long vector of ints combining
-    information about node type with node payload.
+    information about node type with node payload. (GeneratorFlat
+    implements a variant of this, compiled from the tree.)
 
     For example, we could represent different node types as follows,
     where BINARY_FORK etc. are symbolic constants for tagging node
@@ -93,6 +97,16 @@ void GeneratorForkBinary::generate_applicable_ops(
     generator2->generate_applicable_ops(state, applicable_ops);
 }
 
+int GeneratorForkBinary::compile(vector<int> &code) const {
+    int pos = code.size();
+    code.insert(code.end(), {GeneratorFlat::FORK, 2, -1, -1});
+    int child1 = generator1->compile(code);
+    int child2 = generator2->compile(code);
+    code[pos + 2] = child1;
+    code[pos + 3] = child2;
+    return pos;
+}
+
 GeneratorForkMulti::GeneratorForkMulti(vector<unique_ptr<GeneratorBase>> children)
     : children(move(children)) {
     /* Note that we permit 0-ary forks as a way to define empty
@@ -114,6 +128,18 @@ void GeneratorForkMulti::generate_applicable_ops(
         generator->generate_applicable_ops(state, applicable_ops);
 }
 
+int GeneratorForkMulti::compile(vector<int> &code) const {
+    int pos = code.size();
+    code.push_back(GeneratorFlat::FORK);
+    code.push_back(children.size());
+    code.resize(code.size() + children.size(), -1);
+    for (size_t i = 0; i < children.size(); ++i) {
+        int child = children[i]->compile(code);
+        code[pos + 2 + i] = child;
+    }
+    return pos;
+}
+
 GeneratorSwitchVector::GeneratorSwitchVector(
     int switch_var_id, vector<unique_ptr<GeneratorBase>> &&generator_for_value)
     : switch_var_id(switch_var_id),
@@ -138,6 +164,21 @@ void GeneratorSwitchVector::generate_applicable_ops(
     }
 }
 
+int GeneratorSwitchVector::compile(vector<int> &code) const {
+    int pos = code.size();
+    code.push_back(GeneratorFlat::VECTOR_SWITCH);
+    code.push_back(switch_var_id);
+    code.push_back(generator_for_value.size());
+    code.resize(code.size() + generator_for_value.size(), -1);
+    for (size_t value = 0; value < generator_for_value.size(); ++value) {
+        if (generator_for_value[value]) {
+            int child = generator_for_value[value]->compile(code);
+            code[pos + 3 + value] = child;
+        }
+    }
+    return pos;
+}
+
 GeneratorSwitchHash::GeneratorSwitchHash(
     int switch_var_id,
     unordered_map<int, unique_ptr<GeneratorBase>> &&generator_for_value)
@@ -165,6 +206,25 @@ void GeneratorSwitchHash::generate_applicable_ops(
     }
 }
 
+int GeneratorSwitchHash::compile(vector<int> &code) const {
+    vector<int> values;
+    values.reserve(generator_for_value.size());
+    for (const auto &entry : generator_for_value)
+        values.push_back(entry.first);
+    sort(values.begin(), values.end());
+
+    int pos = code.size();
+    code.insert(code.end(), {GeneratorFlat::SORTED_SWITCH, switch_var_id,
+                             static_cast<int>(values.size())});
+    for (int value : values)
+        code.insert(code.end(), {value, -1});
+    for (size_t i = 0; i < values.size(); ++i) {
+        int child = generator_for_value.at(values[i])->compile(code);
+        code[pos + 4 + 2 * i] = child;
+    }
+    return pos;
+}
+
 GeneratorSwitchSingle::GeneratorSwitchSingle(
     int switch_var_id, int value, unique_ptr<GeneratorBase> generator_for_value)
     : switch_var_id(switch_var_id),
@@ -186,6 +246,14 @@ void GeneratorSwitchSingle::generate_applicable_ops(
     }
 }
 
+int GeneratorSwitchSingle::compile(vector<int> &code) const {
+    int pos = code.size();
+    code.insert(code.end(), {GeneratorFlat::SINGLE_SWITCH, switch_var_id, value, -1});
+    int child = generator_for_value->compile(code);
+    code[pos + 3] = child;
+    return pos;
+}
+
 GeneratorLeafVector::GeneratorLeafVector(vector<OperatorID> &&applicable_operators)
     : applicable_operators(move(applicable_operators)) {
 }
@@ -212,6 +280,15 @@ void GeneratorLeafVector::generate_applicable_ops(
     }
 }
 
+int GeneratorLeafVector::compile(vector<int> &code) const {
+    int pos = code.size();
+    code.push_back(GeneratorFlat::LEAF);
+    code.push_back(applicable_operators.size());
+    for (OperatorID id : applicable_operators)
+        code.push_back(id.get_index());
+    return pos;
+}
+
 GeneratorLeafSingle::GeneratorLeafSingle(OperatorID applicable_operator)
     : applicable_operator(applicable_operator) {
 }
@@ -225,4 +302,265 @@ void GeneratorLeafSingle::generate_applicable_ops(
     const GlobalState &, vector<OperatorID> &applicable_ops) const {
     applicable_ops.push_back(applicable_operator);
 }
+
+int GeneratorLeafSingle::compile(vector<int> &code) const {
+    int pos = code.size();
+    code.insert(code.end(), {GeneratorFlat::LEAF, 1, applicable_operator.get_index()});
+    return pos;
+}
+
+GeneratorFlat::GeneratorFlat(
+    const GeneratorBase &tree, const int_packer::IntPacker &state_packer,
+    int num_variables) {
+    root = tree.compile(code);
+    code.shrink_to_fit();
+    max_stack_size = compute_max_stack_size(root);
+    packed_variables.reserve(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        packed_variables.push_back(
+            {state_packer.get_bin_index(var), state_packer.get_shift(var),
+             state_packer.get_read_mask(var)});
+    }
+}
+
+int GeneratorFlat::compute_max_stack_size(int node) const {
+    int max_size = 0;
+    switch (code[node]) {
+    case FORK: {
+        // While child i is processed, children i + 1, ..., n - 1 are on the stack.
+        int num_children = code[node + 1];
+        for (int i = 0; i < num_children; ++i) {
+            max_size = max(max_size, num_children - 1 - i +
+                           compute_max_stack_size(code[node + 2 + i]));
+        }
+        break;
+    }
+    case VECTOR_SWITCH: {
+        int num_values = code[node + 2];
+        for (int value = 0; value < num_values; ++value) {
+            int child = code[node + 3 + value];
+            if (child != -1)
+                max_size = max(max_size, compute_max_stack_size(child));
+        }
+        break;
+    }
+    case SORTED_SWITCH: {
+        int num_values = code[node + 2];
+        for (int i = 0; i < num_values; ++i) {
+            max_size = max(max_size, compute_max_stack_size(code[node + 4 + 2 * i]));
+        }
+        break;
+    }
+    case SINGLE_SWITCH:
+        max_size = compute_max_stack_size(code[node + 3]);
+        break;
+    default:
+        break;
+    }
+    return max_size;
+}
+
+template<typename ValueGetter>
+void GeneratorFlat::generate(
+    const ValueGetter &get_value, vector<OperatorID> &applicable_ops) const {
+    const int MAX_LOCAL_STACK_SIZE = 256;
+    int local_stack[MAX_LOCAL_STACK_SIZE];
+    vector<int> heap_stack;
+    int *stack = local_stack;
+    if (max_stack_size > MAX_LOCAL_STACK_SIZE) {
+        heap_stack.resize(max_stack_size);
+        stack = heap_stack.data();
+    }
+    int stack_size = 0;
+
+    const int *nodes = code.data();
+    auto add_operators = [nodes, &applicable_ops](int leaf) {
+            const int *payload = nodes + leaf + 1;
+            int num_operators = payload[0];
+            for (int i = 0; i < num_operators; ++i)
+                applicable_ops.emplace_back(payload[1 + i]);
+        };
+    int node = root;
+    while (true) {
+        const int *payload = nodes + node + 1;
+        int child = -1;
+        switch (nodes[node]) {
+        case FORK: {
+            int num_children = payload[0];
+            if (num_children > 0) {
+                // Push the children in reverse order to process them in order.
+                for (int i = num_children - 1; i > 0; --i)
+                    stack[stack_size++] = payload[1 + i];
+                child = payload[1];
+            }
+            break;
+        }
+        case VECTOR_SWITCH:
+            child = payload[2 + get_value(payload[0])];
+            break;
+        case SORTED_SWITCH: {
+            int value = get_value(payload[0]);
+            const int *entries = payload + 2;
+            int low = 0;
+            int high = payload[1];
+            while (low < high) {
+                int mid = (low + high) / 2;
+                if (entries[2 * mid] < value)
+                    low = mid + 1;
+                else
+                    high = mid;
+            }
+            if (low < payload[1] && entries[2 * low] == value)
+                child = entries[2 * low + 1];
+            break;
+        }
+        case SINGLE_SWITCH:
+            if (get_value(payload[0]) == payload[1])
+                child = payload[2];
+            break;
+        case LEAF:
+            add_operators(node);
+            break;
+        default:
+            assert(false);
+        }
+        /*
+          Most children are leaves, so we handle them right away instead of
+          going through the dispatch above.
+        */
+        if (child != -1) {
+            if (nodes[child] != LEAF) {
+                node = child;
+                continue;
+            }
+            add_operators(child);
+        }
+        if (stack_size == 0)
+            return;
+        node = stack[--stack_size];
+    }
+}
+
+void GeneratorFlat::generate_applicable_ops(
+    const State &state, vector<OperatorID> &applicable_ops) const {
+    const vector<int> &values = state.get_values();
+    generate([&values](int var) {return values[var];}, applicable_ops);
+}
+
+void GeneratorFlat::generate_applicable_ops(
+    const GlobalState &state, vector<OperatorID> &applicable_ops) const {
+    const PackedStateBin *buffer = state.get_packed_buffer();
+    const PackedVariable *variables = packed_variables.data();
+    generate([buffer, variables](int var) {
+                 const PackedVariable &variable = variables[var];
+                 return static_cast<int>(
+                     (buffer[variable.bin_index] & variable.read_mask) >> variable.shift);
+             }, applicable_ops);
+}
+
+vector<OperatorID> GeneratorFlat::get_operator_order() const {
+    // Depth-first traversal of all branches in the order of generate.
+    vector<OperatorID> operators;
+    vector<int> stack = {root};
+    while (!stack.empty()) {
+        int node = stack.back();
+        stack.pop_back();
+        const int *payload = code.data() + node + 1;
+        vector<int> children;
+        switch (code[node]) {
+        case FORK:
+            children.assign(payload + 1, payload + 1 + payload[0]);
+            break;
+        case VECTOR_SWITCH:
+            for (int i = 0; i < payload[1]; ++i) {
+                if (payload[2 + i] != -1)
+                    children.push_back(payload[2 + i]);
+            }
+            break;
+        case SORTED_SWITCH:
+            for (int i = 0; i < payload[1]; ++i)
+                children.push_back(payload[3 + 2 * i]);
+            break;
+        case SINGLE_SWITCH:
+            children.push_back(payload[2]);
+            break;
+        case LEAF:
+            for (int i = 0; i < payload[0]; ++i)
+                operators.emplace_back(payload[1 + i]);
+            break;
+        default:
+            assert(false);
+        }
+        stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
+    return operators;
+}
+
+GeneratorPreconditionMasks::GeneratorPreconditionMasks(
+    const TaskProxy &task_proxy, const int_packer::IntPacker &state_packer,
+    vector<OperatorID> &&operators_)
+    : state_packer(state_packer),
+      operators(move(operators_)) {
+    int num_operators = operators.size();
+    int num_bins = state_packer.get_num_bins();
+    vector<PackedStateBin> all_masks(num_bins * num_operators, 0);
+    vector<PackedStateBin> all_values(num_bins * num_operators, 0);
+    vector<bool> is_relevant_bin(num_bins, false);
+    OperatorsProxy ops = task_proxy.get_operators();
+    for (int i = 0; i < num_operators; ++i) {
+        for (FactProxy pre : ops[operators[i]].get_preconditions()) {
+            int var = pre.get_variable().get_id();
+            int bin = state_packer.get_bin_index(var);
+            is_relevant_bin[bin] = true;
+            all_masks[bin * num_operators + i] |= state_packer.get_read_mask(var);
+            all_values[bin * num_operators + i] |=
+                PackedStateBin(pre.get_value()) << state_packer.get_shift(var);
+        }
+    }
+    for (int bin = 0; bin < num_bins; ++bin) {
+        if (is_relevant_bin[bin]) {
+            relevant_bins.push_back(bin);
+            int begin = bin * num_operators;
+            masks.insert(masks.end(), all_masks.begin() + begin,
+                         all_masks.begin() + begin + num_operators);
+            values.insert(values.end(), all_values.begin() + begin,
+                          all_values.begin() + begin + num_operators);
+        }
+    }
+}
+
+void GeneratorPreconditionMasks::generate(
+    const PackedStateBin *buffer, vector<OperatorID> &applicable_ops) const {
+    size_t num_operators = operators.size();
+    // Reused between calls to avoid allocating it for every state.
+    static thread_local vector<unsigned char> is_applicable;
+    is_applicable.assign(num_operators, 1);
+    unsigned char *applicable = is_applicable.data();
+    for (size_t i = 0; i < relevant_bins.size(); ++i) {
+        const PackedStateBin bin = buffer[relevant_bins[i]];
+        const PackedStateBin *bin_masks = masks.data() + i * num_operators;
+        const PackedStateBin *bin_values = values.data() + i * num_operators;
+        // Branch-free so that the compiler can vectorize the loop.
+        for (size_t op = 0; op < num_operators; ++op)
+            applicable[op] &= (bin & bin_masks[op]) == bin_values[op];
+    }
+    for (size_t op = 0; op < num_operators; ++op) {
+        if (applicable[op])
+            applicable_ops.push_back(operators[op]);
+    }
+}
+
+void GeneratorPreconditionMasks::generate_applicable_ops(
+    const State &state, vector<OperatorID> &applicable_ops) const {
+    const vector<int> &values = state.get_values();
+    vector<PackedStateBin> buffer(state_packer.get_num_bins(), 0);
+    for (size_t var = 0; var < values.size(); ++var)
+        state_packer.set(buffer.data(), var, values[var]);
+    generate(buffer.data(), applicable_ops);
+}
+
+void GeneratorPreconditionMasks::generate_applicable_ops(
+    const GlobalState &state, vector<OperatorID> &applicable_ops) const {
+    generate(state.get_packed_buffer(), applicable_ops);
+}
 }
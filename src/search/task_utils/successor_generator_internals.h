@@ -1,14 +1,19 @@
 #ifndef TASK_UTILS_SUCCESSOR_GENERATOR_INTERNALS_H
 #define TASK_UTILS_SUCCESSOR_GENERATOR_INTERNALS_H
 
+#include "../global_state.h"
 #include "../operator_id.h"
 
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
-class GlobalState;
 class State;
+class TaskProxy;
+
+namespace int_packer {
+class IntPacker;
+}
 
 namespace successor_generator {
 class GeneratorBase {
@@ -20,6 +25,12 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const = 0;
+
+    /*
+      Append the byte code of this generator (see GeneratorFlat) to code and
+      return its position.
+    */
+    virtual int compile(std::vector<int> &code) const = 0;
 };
 
 class GeneratorForkBinary : public GeneratorBase {
@@ -34,6 +45,7 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
 };
 
 class GeneratorForkMulti : public GeneratorBase {
@@ -45,6 +57,7 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
 };
 
 class GeneratorSwitchVector : public GeneratorBase {
@@ -59,6 +72,7 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
 };
 
 class GeneratorSwitchHash : public GeneratorBase {
@@ -73,6 +87,7 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
 };
 
 class GeneratorSwitchSingle : public GeneratorBase {
@@ -88,6 +103,7 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
 };
 
 class GeneratorLeafVector : public GeneratorBase {
@@ -99,6 +115,7 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
 };
 
 class GeneratorLeafSingle : public GeneratorBase {
@@ -110,6 +127,95 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
+};
+
+/*
+  Successor generator that executes the byte code of a compiled generator
+  tree with a loop instead of virtual calls. The code is a vector of ints
+  where each node starts with its type, followed by its payload:
+
+  - fork: [FORK, n, child_1, ..., child_n]
+  - vector switch: [VECTOR_SWITCH, var, k, child_0, ..., child_k-1]
+    (k is the domain size of var, missing children are -1)
+  - sorted switch: [SORTED_SWITCH, var, n, value_1, child_1, ..., value_n, child_n]
+    (values are sorted, replaces hash switches)
+  - single switch: [SINGLE_SWITCH, var, value, child]
+  - leaf: [LEAF, n, op_id_1, ..., op_id_n]
+
+  Children are positions in the code. The generator produces the same
+  operators in the same order as the tree it was compiled from. For packed
+  states, the values of the switch variables are read directly from the
+  packed bins.
+*/
+class GeneratorFlat {
+    std::vector<int> code;
+    int root;
+    int max_stack_size;
+    struct PackedVariable {
+        int bin_index;
+        int shift;
+        PackedStateBin read_mask;
+    };
+    std::vector<PackedVariable> packed_variables;
+
+    int compute_max_stack_size(int node) const;
+    template<typename ValueGetter>
+    void generate(const ValueGetter &get_value, std::vector<OperatorID> &applicable_ops) const;
+public:
+    enum NodeType {
+        FORK,
+        VECTOR_SWITCH,
+        SORTED_SWITCH,
+        SINGLE_SWITCH,
+        LEAF
+    };
+
+    GeneratorFlat(
+        const GeneratorBase &tree, const int_packer::IntPacker &state_packer,
+        int num_variables);
+
+    void generate_applicable_ops(
+        const State &state, std::vector<OperatorID> &applicable_ops) const;
+    void generate_applicable_ops(
+        const GlobalState &state, std::vector<OperatorID> &applicable_ops) const;
+
+    // Return all operators in the order in which they would be generated.
+    std::vector<OperatorID> get_operator_order() const;
+};
+
+/*
+  Successor generator that tests the preconditions of all operators on the
+  packed state data. The preconditions of an operator are represented as a
+  mask and a value for each bin (covering all precondition variables packed
+  into this bin), and the operator is applicable iff (bin & mask) == value
+  for all bins. These tests are laid out so that the compiler can vectorize
+  them over all operators. This is only efficient for tasks with few bins
+  per state (e.g., tasks with mostly binary variables) and operators with
+  few preconditions that the decision tree cannot split well.
+
+  The operators are generated in the given order (usually that of the
+  decision tree, see GeneratorFlat::get_operator_order).
+*/
+class GeneratorPreconditionMasks {
+    const int_packer::IntPacker &state_packer;
+    std::vector<OperatorID> operators;
+    // Bins that occur in the precondition of at least one operator.
+    std::vector<int> relevant_bins;
+    // Mask and value of the i-th relevant bin for the j-th operator are at i * operators.size() + j.
+    std::vector<PackedStateBin> masks;
+    std::vector<PackedStateBin> values;
+
+    void generate(const PackedStateBin *buffer, std::vector<OperatorID> &applicable_ops) const;
+public:
+    GeneratorPreconditionMasks(
+        const TaskProxy &task_proxy, const int_packer::IntPacker &state_packer,
+        std::vector<OperatorID> &&operators);
+
+    void generate_applicable_ops(
+        const State &state, std::vector<OperatorID> &applicable_ops) const;
+    void generate_applicable_ops(
+        const GlobalState &state, std::vector<OperatorID> &applicable_ops) const;
 };
 }
 
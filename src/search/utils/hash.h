@@ -4,6 +4,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -286,6 +287,80 @@ std::size_t get_hash(const T &value) {
 }
 
 
+/*
+  Hash an array of 32-bit or 64-bit words, such as the data of a packed
+  state, in a single pass.
+
+  Instead of feeding the words to a HashState one by one, the data is
+  consumed in 64-bit pieces by four independent accumulators, which allows
+  the compiler to interleave (or vectorize) the multiplications. In
+  benchmarks/state_hash_benchmark, this makes state registration 0-5% faster
+  for up to 16 bins per state and about 30% faster for 64 bins.
+  The function follows the structure of XXH64 by Yann Collet (BSD license) and
+  its result is fully avalanched, so all bits (in particular the low bits used
+  for bucket indices) can be used. It does not use HashState and hence does
+  not produce the same values as get_hash64 for the same words.
+*/
+inline std::uint64_t rotate64(std::uint64_t value, int offset) {
+    return (value << offset) | (value >> (64 - offset));
+}
+
+template<typename Word>
+std::uint64_t get_array_hash64(const Word *words, std::size_t num_words) {
+    static_assert(sizeof(Word) == 4 || sizeof(Word) == 8,
+                  "get_array_hash64 only supports 32-bit and 64-bit words");
+    const std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+    const std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+    const std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+    const std::uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+    const std::uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+    auto round = [&](std::uint64_t acc, std::uint64_t input) {
+            return rotate64(acc + input * prime2, 31) * prime1;
+        };
+    auto read64 = [](const unsigned char *p) {
+            std::uint64_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        };
+
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(words);
+    const std::size_t num_bytes = num_words * sizeof(Word);
+    const unsigned char *end = data + num_bytes;
+    std::uint64_t hash;
+    if (num_bytes >= 32) {
+        std::uint64_t acc[4] = {prime1 + prime2, prime2, 0, 0 - prime1};
+        do {
+            for (int i = 0; i < 4; ++i) {
+                acc[i] = round(acc[i], read64(data + 8 * i));
+            }
+            data += 32;
+        } while (end - data >= 32);
+        hash = rotate64(acc[0], 1) + rotate64(acc[1], 7) +
+            rotate64(acc[2], 12) + rotate64(acc[3], 18);
+        for (int i = 0; i < 4; ++i) {
+            hash = (hash ^ round(0, acc[i])) * prime1 + prime4;
+        }
+    } else {
+        hash = prime5;
+    }
+    hash += num_bytes;
+    for (; end - data >= 8; data += 8) {
+        hash = rotate64(hash ^ round(0, read64(data)), 27) * prime1 + prime4;
+    }
+    if (data != end) {
+        // Remaining 32-bit word.
+        std::uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        hash = rotate64(hash ^ (value * prime1), 23) * prime2 + prime3;
+    }
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
 // This struct should only be used by HashMap and HashSet below.
 template<typename T>
 struct Hash {
@@ -104,5 +104,7 @@ void trace(const string &msg) {
     _tracer.print_trace_message(msg);
 }
 
+thread_local bool Log::line_has_started = false;
+
 Log g_log;
 }
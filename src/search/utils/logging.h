@@ -22,7 +22,8 @@ namespace utils {
 */
 class Log {
 private:
-    bool line_has_started = false;
+    // Thread-local, so that searches running in parallel can log concurrently.
+    static thread_local bool line_has_started;
 
 public:
     template<typename T>
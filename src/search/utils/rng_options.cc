@@ -21,8 +21,12 @@ shared_ptr<RandomNumberGenerator> parse_rng_from_options(
     const options::Options &options) {
     int seed = options.get<int>("random_seed");
     if (seed == -1) {
-        // Use an arbitrary default seed.
-        static shared_ptr<utils::RandomNumberGenerator> rng =
+        /*
+          Use an arbitrary default seed. Components constructed in the same
+          thread share the generator; components of searches constructed in
+          other threads (see parallel_portfolio) use their own.
+        */
+        static thread_local shared_ptr<utils::RandomNumberGenerator> rng =
             make_shared<utils::RandomNumberGenerator>(2011);
         return rng;
     } else {